@@ -54,6 +54,7 @@
 #include "icns.h"
 #include "menu.h"
 #include "config.h"
+#include "config_tokens.h"
 #include "screenmgt.h"
 #include "apple.h"
 #include "mystrings.h"
@@ -66,10 +67,6 @@
 #define LINUX_OPTIONS_FILENAMES  L"refindplus_linux.conf,refindplus-linux.conf,refind_linux.conf,refind-linux.conf"
 #define MAXCONFIGFILESIZE        (128*1024)
 
-#define ENCODING_ISO8859_1  (0)
-#define ENCODING_UTF8       (1)
-#define ENCODING_UTF16_LE   (2)
-
 #define LAST_MINUTE         (1439) /* Last minute of a day */
 
 UINTN   ReadLoops       = 0;
@@ -91,6 +88,20 @@ BOOLEAN FoundFontImage =  TRUE;
 
 extern BOOLEAN         ForceTextOnly;
 
+// Parsed copy of a config file, reused while its size and time stamp hold
+typedef struct _config_snapshot {
+    CHAR16                   *FileName;
+    UINT64                    FileSize;
+    EFI_TIME                  ModificationTime;
+    CHAR16                   *Text;         // File text already split into tokens
+    UINTN                     TextSize;
+    CHAR16                  **Tokens;       // Tokens in Text, each line closed by NULL
+    UINTN                     TokenCount;
+    struct _config_snapshot  *Next;
+} CONFIG_SNAPSHOT;
+
+static CONFIG_SNAPSHOT *ConfigSnapshots = NULL;
+
 //
 // Read a file into a buffer
 //
@@ -106,9 +117,12 @@ EFI_STATUS RefitReadFile (
     EFI_FILE_INFO   *FileInfo;
     CHAR16          *Message;
     UINT64           ReadSize;
+    UINTN            i;
 
-    File->Buffer     = NULL;
-    File->BufferSize = 0;
+    File->Buffer        = NULL;
+    File->BufferSize    = 0;
+    File->Snapshot      = NULL;
+    File->SnapshotIndex = 0;
 
     // read the file, allocating a buffer on the way
     Status = REFIT_CALL_5_WRAPPER(
@@ -136,8 +150,9 @@ EFI_STATUS RefitReadFile (
     ReadSize = FileInfo->FileSize;
     MY_FREE_POOL(FileInfo);
 
+    // One spare CHAR16 terminates a last line with no line break in place
     File->BufferSize = (UINTN) ReadSize;
-    File->Buffer = AllocatePool (File->BufferSize);
+    File->Buffer = AllocatePool (File->BufferSize + sizeof (CHAR16));
     if (File->Buffer == NULL) {
        size = 0;
 
@@ -164,6 +179,9 @@ EFI_STATUS RefitReadFile (
 
     REFIT_CALL_1_WRAPPER(FileHandle->Close, FileHandle);
 
+    File->Buffer[File->BufferSize]     = 0;
+    File->Buffer[File->BufferSize + 1] = 0;
+
     // Setup for reading
     File->Current8Ptr  = (CHAR8 *)File->Buffer;
     File->End8Ptr      = File->Current8Ptr + File->BufferSize;
@@ -192,237 +210,128 @@ EFI_STATUS RefitReadFile (
         }
     }
 
-    return EFI_SUCCESS;
-}
-
-//
-// Get a single line of text from a file
-//
-
-static
-CHAR16 * ReadLine (
-    REFIT_FILE *File
-) {
-    CHAR16  *Line = NULL;
-    CHAR16  *q    = NULL;
-    UINTN    LineLength;
-
-    if (File->Buffer == NULL) {
-        // Early Return
-        return NULL;
-    }
-
-    if (File->Encoding != ENCODING_UTF8      &&
-        File->Encoding != ENCODING_UTF16_LE  &&
-        File->Encoding != ENCODING_ISO8859_1
-    ) {
-        // Early Return ... Unsupported encoding
-        return NULL;
-    }
-
-    if (File->Encoding == ENCODING_UTF8 ||
-        File->Encoding == ENCODING_ISO8859_1
-    ) {
-        CHAR8 *p, *LineStart, *LineEnd;
-
-        p = File->Current8Ptr;
-        if (p >= File->End8Ptr) {
-            // Early Return
-            return NULL;
-        }
-
-        LineStart = p;
-        for (; p < File->End8Ptr; p++) {
-            if (*p == 13 || *p == 10) {
-                break;
-            }
-        }
-        LineEnd = p;
-        for (; p < File->End8Ptr; p++) {
-            if (*p != 13 && *p != 10) {
-                break;
-            }
-        }
-        File->Current8Ptr = p;
+    if (File->Encoding != ENCODING_UTF16_LE) {
+        // Widen 8-bit text to CHAR16 once, so ReadLine() and ReadTokenLine()
+        // can split lines and tokens in place instead of copying each one.
+        // DA-TAG: Investigate This
+        //         Actually handle UTF-8
+        //         Currently a 1:1 translation as for ISO-8859-1
+        UINTN   Count = (UINTN) (File->End8Ptr - File->Current8Ptr);
+        CHAR16 *Text  = AllocatePool ((Count + 1) * sizeof (CHAR16));
+        if (Text == NULL) {
+            MY_FREE_POOL(File->Buffer);
+            File->BufferSize = 0;
 
-        LineLength = (UINTN) (LineEnd - LineStart) + 1;
-        Line = AllocatePool (sizeof (CHAR16) * LineLength);
-        if (Line == NULL) {
             // Early Return
-            return NULL;
-        }
-
-        q = Line;
-        if (File->Encoding == ENCODING_ISO8859_1) {
-            for (p = LineStart; p < LineEnd; ) {
-                *q++ = *p++;
-            }
-        }
-        else if (File->Encoding == ENCODING_UTF8) {
-            // DA-TAG: Investigate This
-            //         Actually handle UTF-8
-            //         Currently just duplicates previous block
-            for (p = LineStart; p < LineEnd; ) {
-                *q++ = *p++;
-            }
+            return EFI_OUT_OF_RESOURCES;
         }
-        *q = 0;
-
-        return Line;
-    }
-
-    // Encoding is ENCODING_UTF16_LE
-    CHAR16 *p, *LineStart, *LineEnd;
-    p = File->Current16Ptr;
-    if (p >= File->End16Ptr) {
-        // Early Return
-        return NULL;
-    }
 
-    LineStart = p;
-    for (; p < File->End16Ptr; p++) {
-        if (*p == 13 || *p == 10) {
-            break;
-        }
-    }
-    LineEnd = p;
-    for (; p < File->End16Ptr; p++) {
-        if (*p != 13 && *p != 10) {
-            break;
+        for (i = 0; i < Count; i++) {
+            Text[i] = (UINT8) File->Current8Ptr[i];
         }
-    }
-    File->Current16Ptr = p;
-
-    LineLength = (UINTN) (LineEnd - LineStart) + 1;
-    Line = AllocatePool (sizeof (CHAR16) * LineLength);
-    if (Line == NULL) {
-        // Early Return
-        return NULL;
-    }
+        Text[Count] = 0;
 
-    for (p = LineStart, q = Line; p < LineEnd; ) {
-        *q++ = *p++;
+        MY_FREE_POOL(File->Buffer);
+        File->Buffer       = (UINT8 *) Text;
+        File->BufferSize   = Count * sizeof (CHAR16);
+        File->Encoding     = ENCODING_UTF16_LE;
+        File->Current8Ptr  = (CHAR8 *) File->Buffer;
+        File->End8Ptr      = File->Current8Ptr + File->BufferSize;
+        File->Current16Ptr = Text;
+        File->End16Ptr     = Text + Count;
     }
-    *q = 0;
 
-    return Line;
+    return EFI_SUCCESS;
 }
 
-// Returns FALSE if *p points to the end of a token, TRUE otherwise.
-// Also modifies *p **IF** the first and second characters are both
-// quotes ('"'); it deletes one of them.
+// Get the next line of tokens from a file read back from the config cache.
+// The tokens point into File->Buffer, a private copy of the cached text, so
+// callers may alter them as they would on a freshly read file.
 static
-BOOLEAN KeepReading (
-    IN OUT CHAR16  *p,
-    IN OUT BOOLEAN *IsQuoted
+UINTN ReadSnapshotTokenLine (
+    IN  REFIT_FILE   *File,
+    OUT CHAR16     ***TokenList
 ) {
-    BOOLEAN  MoreToRead = FALSE;
-    CHAR16  *Temp       = NULL;
+    CONFIG_SNAPSHOT  *Snapshot = File->Snapshot;
+    CHAR16           *Text     = (CHAR16 *) File->Buffer;
+    UINTN             Start, End, i;
 
-    if ((p == NULL) || (IsQuoted == NULL)) {
-        return FALSE;
+    Start = File->SnapshotIndex;
+    if (Start >= Snapshot->TokenCount) {
+        // Early Return
+        return 0;
     }
 
-    if (*p == L'\0') {
-        return FALSE;
-    }
+    for (End = Start; Snapshot->Tokens[End] != NULL; End++);
 
-    if ((
-        *p != ' '  &&
-        *p != '\t' &&
-        *p != '='  &&
-        *p != '#'  &&
-        *p != ','
-    ) || *IsQuoted) {
-        MoreToRead = TRUE;
+    *TokenList = AllocatePool ((End - Start) * sizeof (CHAR16 *));
+    if (*TokenList == NULL) {
+        // Early Return
+        return 0;
     }
 
-    if (*p == L'"') {
-        if (p[1] != L'"') {
-            *IsQuoted  = !(*IsQuoted);
-            MoreToRead = FALSE;
-        }
-        else {
-            Temp = StrDuplicate (&p[1]);
-            if (Temp != NULL) {
-                StrCpy (p, Temp);
-                MY_FREE_POOL(Temp);
-            }
-            MoreToRead = TRUE;
-        }
-    } // if first character is a quote
+    for (i = Start; i < End; i++) {
+        (*TokenList)[i - Start] = Text + (Snapshot->Tokens[i] - Snapshot->Text);
+    }
+    File->SnapshotIndex = End + 1;
 
-    return MoreToRead;
-} // BOOLEAN KeepReading()
+    return (End - Start);
+} // static UINTN ReadSnapshotTokenLine()
 
-//
-// Get a line of tokens from a file
-//
-UINTN ReadTokenLine (
+// Get a line of tokens from a file, skipping empty and comment lines.
+// The tokens point into the file buffer and stay valid while it does.
+// Release the list with FreeTokenLineInPlace(), which leaves the tokens.
+static
+UINTN ReadTokenLineInPlace (
     IN  REFIT_FILE   *File,
     OUT CHAR16     ***TokenList
 ) {
-    BOOLEAN  LineFinished, IsQuoted = FALSE;
-    CHAR16  *Line, *Token, *p;
+    BOOLEAN  IsQuoted   = FALSE;
+    CHAR16  *Line;
     UINTN    TokenCount = 0;
 
     *TokenList = NULL;
 
+    if (File->Snapshot != NULL) {
+        return ReadSnapshotTokenLine (File, TokenList);
+    }
+
     while (TokenCount == 0) {
         Line = ReadLine (File);
         if (Line == NULL) {
             return 0;
         }
 
-        p = Line;
-        LineFinished = FALSE;
-        while (!LineFinished) {
-            // Skip whitespace and find start of token
-            while (!IsQuoted &&
-                (
-                    *p == ' '  ||
-                    *p == '\t' ||
-                    *p == '='  ||
-                    *p == ','
-                )
-            ) {
-                p++;
-            } // while
-
-            if (*p == 0 || *p == '#') {
-                break;
-            }
-
-            if (*p == '"') {
-               IsQuoted = !IsQuoted;
-               p++;
-            }
-
-            Token = p;
+        SplitTokenLine (Line, &IsQuoted, TokenList, &TokenCount);
+    } // while TokenCount == 0
 
-            // Find end of token
-            while (KeepReading (p, &IsQuoted)) {
-               if ((*p == L'/') && !IsQuoted) {
-                   // Switch Unix style to DOS style directory separators
-                   *p = L'\\';
-               }
-               p++;
-            } // while
+    return TokenCount;
+} // static UINTN ReadTokenLineInPlace()
 
-            if (*p == L'\0' || *p == L'#') {
-                LineFinished = TRUE;
-            }
-            *p++ = 0;
+static
+VOID FreeTokenLineInPlace (
+    IN OUT CHAR16 ***TokenList,
+    IN OUT UINTN    *TokenCount
+) {
+    MY_FREE_POOL(*TokenList);
+    *TokenCount = 0;
+} // static VOID FreeTokenLineInPlace()
 
-            AddListElement (
-                (VOID ***) TokenList,
-                &TokenCount,
-                (VOID *) StrDuplicate (Token)
-            );
-        } // while !LineFinished
+//
+// Get a line of tokens from a file
+//
+// As ReadTokenLineInPlace(), but each token is a pool copy the caller may
+// free or replace. Release the list with FreeTokenLine().
+UINTN ReadTokenLine (
+    IN  REFIT_FILE   *File,
+    OUT CHAR16     ***TokenList
+) {
+    UINTN    TokenCount, i;
 
-        MY_FREE_POOL(Line);
-    } // while TokenCount == 0
+    TokenCount = ReadTokenLineInPlace (File, TokenList);
+    for (i = 0; i < TokenCount; i++) {
+        (*TokenList)[i] = StrDuplicate ((*TokenList)[i]);
+    }
 
     return TokenCount;
 } // UINTN ReadTokenLine()
@@ -436,6 +345,143 @@ VOID FreeTokenLine (
     FreeList ((VOID ***) TokenList, TokenCount);
 } // VOID FreeTokenLine()
 
+// Returns the size and time stamp of a file in SelfDir, or NULL.
+static
+EFI_FILE_INFO * GetConfigFileInfo (
+    IN CHAR16 *FileName
+) {
+    EFI_STATUS       Status;
+    EFI_FILE_HANDLE  FileHandle;
+    EFI_FILE_INFO   *FileInfo;
+
+    Status = REFIT_CALL_5_WRAPPER(
+        SelfDir->Open, SelfDir,
+        &FileHandle, FileName,
+        EFI_FILE_MODE_READ, 0
+    );
+    if (EFI_ERROR(Status)) {
+        // Early Return
+        return NULL;
+    }
+
+    FileInfo = LibFileInfo (FileHandle);
+    REFIT_CALL_1_WRAPPER(FileHandle->Close, FileHandle);
+
+    return FileInfo;
+} // static EFI_FILE_INFO * GetConfigFileInfo()
+
+// Read a config file from SelfDir through the parsed config cache.
+// While the file's size and modification time match the cached copy, the
+// file is neither read nor tokenised again; File gets a private copy of the
+// cached text and hands out the cached token lines. Otherwise the file is
+// read and split in full once and the cache entry is replaced.
+// Release File->Buffer as for RefitReadFile().
+static
+EFI_STATUS ReadConfigFile (
+    IN  CHAR16     *FileName,
+    OUT REFIT_FILE *File
+) {
+    EFI_STATUS         Status;
+    EFI_FILE_INFO     *FileInfo;
+    CONFIG_SNAPSHOT   *Snapshot;
+    CHAR16           **TokenList;
+    CHAR16           **Tokens     = NULL;
+    UINTN              TokenCount = 0;
+    UINTN              LineCount, i, size;
+
+    FileInfo = GetConfigFileInfo (FileName);
+    if (FileInfo == NULL) {
+        // Early Return ... Read uncached
+        return RefitReadFile (SelfDir, FileName, File, &size);
+    }
+
+    for (Snapshot = ConfigSnapshots; Snapshot != NULL; Snapshot = Snapshot->Next) {
+        if (MyStriCmp (Snapshot->FileName, FileName)) {
+            break;
+        }
+    }
+
+    if (Snapshot != NULL &&
+        Snapshot->FileSize == FileInfo->FileSize &&
+        CompareMem (
+            &Snapshot->ModificationTime,
+            &FileInfo->ModificationTime,
+            sizeof (EFI_TIME)
+        ) == 0
+    ) {
+        MY_FREE_POOL(FileInfo);
+
+        ZeroMem (File, sizeof (REFIT_FILE));
+        File->Buffer = AllocateCopyPool (Snapshot->TextSize, Snapshot->Text);
+        if (File->Buffer == NULL) {
+            // Early Return
+            return EFI_OUT_OF_RESOURCES;
+        }
+        File->BufferSize   = Snapshot->TextSize - sizeof (CHAR16);
+        File->Encoding     = ENCODING_UTF16_LE;
+        File->Current16Ptr = File->End16Ptr = (CHAR16 *) File->Buffer;
+        File->Snapshot     = Snapshot;
+
+        // Early Return ... Cache hit
+        return EFI_SUCCESS;
+    }
+
+    Status = RefitReadFile (SelfDir, FileName, File, &size);
+    if (EFI_ERROR(Status)) {
+        MY_FREE_POOL(FileInfo);
+
+        // Early Return
+        return Status;
+    }
+
+    // Split the whole file now and keep the split text as the cached copy
+    while ((LineCount = ReadTokenLineInPlace (File, &TokenList)) > 0) {
+        for (i = 0; i < LineCount; i++) {
+            AddListElement ((VOID ***) &Tokens, &TokenCount, TokenList[i]);
+        }
+        AddListElement ((VOID ***) &Tokens, &TokenCount, NULL);
+
+        FreeTokenLineInPlace (&TokenList, &LineCount);
+    } // while
+    FreeTokenLineInPlace (&TokenList, &LineCount);
+
+    if (Snapshot == NULL) {
+        Snapshot = AllocateZeroPool (sizeof (CONFIG_SNAPSHOT));
+        if (Snapshot == NULL) {
+            MY_FREE_POOL(Tokens);
+            MY_FREE_POOL(FileInfo);
+            MY_FREE_POOL(File->Buffer);
+
+            // Early Return
+            return EFI_OUT_OF_RESOURCES;
+        }
+        Snapshot->FileName = StrDuplicate (FileName);
+        Snapshot->Next     = ConfigSnapshots;
+        ConfigSnapshots    = Snapshot;
+    }
+    MY_FREE_POOL(Snapshot->Text);
+    MY_FREE_POOL(Snapshot->Tokens);
+
+    Snapshot->FileSize         = FileInfo->FileSize;
+    Snapshot->ModificationTime = FileInfo->ModificationTime;
+    Snapshot->Text             = (CHAR16 *) File->Buffer;
+    Snapshot->TextSize         = File->BufferSize + sizeof (CHAR16);
+    Snapshot->Tokens           = Tokens;
+    Snapshot->TokenCount       = TokenCount;
+    MY_FREE_POOL(FileInfo);
+
+    File->Buffer = AllocateCopyPool (Snapshot->TextSize, Snapshot->Text);
+    if (File->Buffer == NULL) {
+        // Early Return
+        return EFI_OUT_OF_RESOURCES;
+    }
+    File->Current16Ptr  = File->End16Ptr = (CHAR16 *) File->Buffer;
+    File->Snapshot      = Snapshot;
+    File->SnapshotIndex = 0;
+
+    return EFI_SUCCESS;
+} // static EFI_STATUS ReadConfigFile()
+
 // Handle a parameter with a single integer argument (signed)
 static
 VOID HandleSignedInt (
@@ -787,7 +833,7 @@ VOID ReadConfig (
         return;
     }
 
-    Status = RefitReadFile (SelfDir, FileName, &File, &i);
+    Status = ReadConfigFile (FileName, &File);
     if (EFI_ERROR(Status)) {
         #if REFIT_DEBUG > 0
         MuteLogger = FALSE;
@@ -802,1287 +848,1285 @@ VOID ReadConfig (
     BOOLEAN DeclineSetting;
 
     for (;;) {
-        TokenCount = ReadTokenLine (&File, &TokenList);
+        TokenCount = ReadTokenLineInPlace (&File, &TokenList);
         if (TokenCount == 0) {
             break;
         }
 
-        if (MyStriCmp (TokenList[0], L"timeout")) {
-            // DA-TAG: Signed integer as can have negative value
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.Timeout));
-            GlobalConfig.DirectBoot = (GlobalConfig.Timeout < 0) ? TRUE : FALSE;
+        switch (FindConfigKey (TokenList[0])) {
+            case CONFIG_KEY_TIMEOUT:
+                // DA-TAG: Signed integer as can have negative value
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.Timeout));
+                GlobalConfig.DirectBoot = (GlobalConfig.Timeout < 0) ? TRUE : FALSE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'timeout'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"shutdown_after_timeout")) {
-            GlobalConfig.ShutdownAfterTimeout = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'timeout'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SHUTDOWN_AFTER_TIMEOUT:
+                GlobalConfig.ShutdownAfterTimeout = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'shutdown_after_timeout'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"hideui")) {
-            for (i = 1; i < TokenCount; i++) {
-                Flag = TokenList[i];
-                if (0);
-                else if (MyStriCmp (Flag, L"all")       ) GlobalConfig.HideUIFlags  = HIDEUI_FLAG_ALL;
-                else if (MyStriCmp (Flag, L"label")     ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_LABEL;
-                else if (MyStriCmp (Flag, L"hints")     ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_HINTS;
-                else if (MyStriCmp (Flag, L"banner")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_BANNER;
-                else if (MyStriCmp (Flag, L"hwtest")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_HWTEST;
-                else if (MyStriCmp (Flag, L"arrows")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_ARROWS;
-                else if (MyStriCmp (Flag, L"editor")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_EDITOR;
-                else if (MyStriCmp (Flag, L"badges")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_BADGES;
-                else if (MyStriCmp (Flag, L"safemode")  ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_SAFEMODE;
-                else if (MyStriCmp (Flag, L"singleuser")) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_SINGLEUSER;
-                else {
-                    SwitchToText (FALSE);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'shutdown_after_timeout'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_HIDEUI:
+                for (i = 1; i < TokenCount; i++) {
+                    Flag = TokenList[i];
+                    if (0);
+                    else if (MyStriCmp (Flag, L"all")       ) GlobalConfig.HideUIFlags  = HIDEUI_FLAG_ALL;
+                    else if (MyStriCmp (Flag, L"label")     ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_LABEL;
+                    else if (MyStriCmp (Flag, L"hints")     ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_HINTS;
+                    else if (MyStriCmp (Flag, L"banner")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_BANNER;
+                    else if (MyStriCmp (Flag, L"hwtest")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_HWTEST;
+                    else if (MyStriCmp (Flag, L"arrows")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_ARROWS;
+                    else if (MyStriCmp (Flag, L"editor")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_EDITOR;
+                    else if (MyStriCmp (Flag, L"badges")    ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_BADGES;
+                    else if (MyStriCmp (Flag, L"safemode")  ) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_SAFEMODE;
+                    else if (MyStriCmp (Flag, L"singleuser")) GlobalConfig.HideUIFlags |= HIDEUI_FLAG_SINGLEUSER;
+                    else {
+                        SwitchToText (FALSE);
+
+                        MsgStr = PoolPrint (
+                            L"  - WARN: Invalid 'hideui' Flag:- '%s'",
+                            Flag
+                        );
+                        PrintUglyText (MsgStr, NEXTLINE);
 
-                    MsgStr = PoolPrint (
-                        L"  - WARN: Invalid 'hideui' Flag:- '%s'",
-                        Flag
-                    );
-                    PrintUglyText (MsgStr, NEXTLINE);
+                        #if REFIT_DEBUG > 0
+                        MuteLogger = FALSE;
+                        LOG_MSG("%s%s", OffsetNext, MsgStr);
+                        MuteLogger = TRUE;
+                        #endif
 
-                    #if REFIT_DEBUG > 0
+                        PauseForKey();
+                        MY_FREE_POOL(MsgStr);
+                    }
+                } // for
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
                     MuteLogger = FALSE;
-                    LOG_MSG("%s%s", OffsetNext, MsgStr);
+                    LOG_MSG("%s  - Updated:- 'hideui'", OffsetNext);
                     MuteLogger = TRUE;
-                    #endif
-
-                    PauseForKey();
-                    MY_FREE_POOL(MsgStr);
                 }
-            } // for
+                #endif
+            break;
+            case CONFIG_KEY_ICONS_DIR:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.IconsDir));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'hideui'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"icons_dir")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.IconsDir));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'icons_dir'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SET_BOOT_ARGS:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.SetBootArgs));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'icons_dir'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"set_boot_args")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.SetBootArgs));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'set_boot_args'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCANFOR:
+                for (i = 0; i < NUM_SCAN_OPTIONS; i++) {
+                    GlobalConfig.ScanFor[i] = (i < TokenCount) ? TokenList[i][0] : ' ';
+                } // for
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'set_boot_args'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"scanfor")) {
-            for (i = 0; i < NUM_SCAN_OPTIONS; i++) {
-                GlobalConfig.ScanFor[i] = (i < TokenCount) ? TokenList[i][0] : ' ';
-            } // for
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'scanfor'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_USE_NVRAM:
+                GlobalConfig.UseNvram = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'scanfor'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"use_nvram")) {
-            GlobalConfig.UseNvram = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'use_nvram'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_UEFI_DEEP_LEGACY_SCAN:
+                GlobalConfig.DeepLegacyScan = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'use_nvram'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"uefi_deep_legacy_scan")) {
-            GlobalConfig.DeepLegacyScan = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'uefi_deep_legacy_scan'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DISABLE_RESCAN_DXE:
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.RescanDXE = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'uefi_deep_legacy_scan'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"disable_rescan_dxe")) {
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.RescanDXE = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'disable_rescan_dxe'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_RANSOM_DRIVES:
+                GlobalConfig.RansomDrives = (AppleFirmware) ? FALSE : HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'disable_rescan_dxe'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"ransom_drives")) {
-            GlobalConfig.RansomDrives = (AppleFirmware) ? FALSE : HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'ransom_drives'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCAN_DELAY:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'ransom_drives'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"scan_delay") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.ScanDelay));
+                HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.ScanDelay));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'scan_delay'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"log_level") && (TokenCount == 2)) {
-            // DA-TAG: Signed integer as *MAY* have negative value input
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.LogLevel));
-            // Sanitise levels
-            if (0);
-            else if (GlobalConfig.LogLevel < LOGLEVELOFF) GlobalConfig.LogLevel = LOGLEVELOFF;
-            else if (GlobalConfig.LogLevel > MaxLogLevel) GlobalConfig.LogLevel = MaxLogLevel;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'scan_delay'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_LOG_LEVEL:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'log_level'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"icon_row_move") && (TokenCount == 2)) {
-            // DA-TAG: Signed integer as *MAY* have negative value input
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.IconRowMove));
+                // DA-TAG: Signed integer as *MAY* have negative value input
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.LogLevel));
+                // Sanitise levels
+                if (0);
+                else if (GlobalConfig.LogLevel < LOGLEVELOFF) GlobalConfig.LogLevel = LOGLEVELOFF;
+                else if (GlobalConfig.LogLevel > MaxLogLevel) GlobalConfig.LogLevel = MaxLogLevel;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'icon_row_move'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"icon_row_tune") && (TokenCount == 2)) {
-            // DA-TAG: Signed integer as *MAY* have negative value input
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.IconRowTune));
-            // Store as opposite number
-            GlobalConfig.IconRowTune *= -1;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'log_level'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_ICON_ROW_MOVE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'icon_row_tune'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"also_scan_dirs")) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.AlsoScan));
+                // DA-TAG: Signed integer as *MAY* have negative value input
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.IconRowMove));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'also_scan_dirs'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"dont_scan_dirs") ||
-            MyStriCmp (TokenList[0], L"don't_scan_dirs")
-        ) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanDirs));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'icon_row_move'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_ICON_ROW_TUNE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'dont_scan_dirs'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"dont_scan_files") ||
-            MyStriCmp (TokenList[0], L"don't_scan_files")
-        ) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanFiles));
+                // DA-TAG: Signed integer as *MAY* have negative value input
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.IconRowTune));
+                // Store as opposite number
+                GlobalConfig.IconRowTune *= -1;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'dont_scan_files'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"dont_scan_tools") ||
-            MyStriCmp (TokenList[0], L"don't_scan_tools")
-        ) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanTools));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'icon_row_tune'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_ALSO_SCAN_DIRS:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.AlsoScan));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'dont_scan_tools'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"dont_scan_firmware") ||
-            MyStriCmp (TokenList[0], L"don't_scan_firmware")
-        ) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanFirmware));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'also_scan_dirs'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DONT_SCAN_DIRS:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanDirs));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'dont_scan_firmware'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"dont_scan_volumes") ||
-            MyStriCmp (TokenList[0], L"don't_scan_volumes")
-        ) {
-            // Note: Do not use HandleStrings() because it modifies slashes.
-            //       However, This might be present in the volume name.
-            MY_FREE_POOL(GlobalConfig.DontScanVolumes);
-            for (i = 1; i < TokenCount; i++) {
-                MergeStrings (&GlobalConfig.DontScanVolumes, TokenList[i], L',');
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'dont_scan_dirs'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DONT_SCAN_FILES:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanFiles));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'dont_scan_volumes'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"windows_recovery_files")) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.WindowsRecoveryFiles));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'dont_scan_files'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DONT_SCAN_TOOLS:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanTools));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'windows_recovery_files'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"scan_driver_dirs")) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.DriverDirs));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'dont_scan_tools'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DONT_SCAN_FIRMWARE:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.DontScanFirmware));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'scan_driver_dirs'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"showtools")) {
-            // DA-TAG: HiddenTags reset looks strange but is actually valid
-            //         Artificial default of 'TRUE' needed as misconfig exit option
-            //         This sets real default of 'FALSE' when 'showtools' is present
-            GlobalConfig.HiddenTags = FALSE;
-
-            SetMem (GlobalConfig.ShowTools, NUM_TOOLS * sizeof (UINTN), 0);
-
-            BOOLEAN DoneTool = FALSE;
-            UINTN InvalidEntries = 0;
-            i = 0;
-            for (;;) {
-                // DA-TAG: Start Index is 1 Here ('i' for NUM_TOOLS/TokenList)
-                i = i + 1;
-                if (i >= TokenCount ||
-                    i >= (NUM_TOOLS + InvalidEntries)
-                ) {
-                    // Break Loop
-                    break;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'dont_scan_firmware'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DONT_SCAN_VOLUMES:
+                // Note: Do not use HandleStrings() because it modifies slashes.
+                //       However, This might be present in the volume name.
+                MY_FREE_POOL(GlobalConfig.DontScanVolumes);
+                for (i = 1; i < TokenCount; i++) {
+                    MergeStrings (&GlobalConfig.DontScanVolumes, TokenList[i], L',');
                 }
 
-                // Set Showtools Index
-                j = (DoneTool) ? j + 1 : 0;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'dont_scan_volumes'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_WINDOWS_RECOVERY_FILES:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.WindowsRecoveryFiles));
 
-                Flag = TokenList[i];
-                if (0);
-                else if (MyStriCmp (Flag, L"exit")            ) GlobalConfig.ShowTools[j] = TAG_EXIT;
-                else if (MyStriCmp (Flag, L"shell")           ) GlobalConfig.ShowTools[j] = TAG_SHELL;
-                else if (MyStriCmp (Flag, L"gdisk")           ) GlobalConfig.ShowTools[j] = TAG_GDISK;
-                else if (MyStriCmp (Flag, L"about")           ) GlobalConfig.ShowTools[j] = TAG_ABOUT;
-                else if (MyStriCmp (Flag, L"reboot")          ) GlobalConfig.ShowTools[j] = TAG_REBOOT;
-                else if (MyStriCmp (Flag, L"gptsync")         ) GlobalConfig.ShowTools[j] = TAG_GPTSYNC;
-                else if (MyStriCmp (Flag, L"install")         ) GlobalConfig.ShowTools[j] = TAG_INSTALL;
-                else if (MyStriCmp (Flag, L"netboot")         ) GlobalConfig.ShowTools[j] = TAG_NETBOOT;
-                else if (MyStriCmp (Flag, L"memtest")         ) GlobalConfig.ShowTools[j] = TAG_MEMTEST;
-                else if (MyStriCmp (Flag, L"memtest86")       ) GlobalConfig.ShowTools[j] = TAG_MEMTEST;
-                else if (MyStriCmp (Flag, L"shutdown")        ) GlobalConfig.ShowTools[j] = TAG_SHUTDOWN;
-                else if (MyStriCmp (Flag, L"mok_tool")        ) GlobalConfig.ShowTools[j] = TAG_MOK_TOOL;
-                else if (MyStriCmp (Flag, L"firmware")        ) GlobalConfig.ShowTools[j] = TAG_FIRMWARE;
-                else if (MyStriCmp (Flag, L"bootorder")       ) GlobalConfig.ShowTools[j] = TAG_BOOTORDER;
-                else if (MyStriCmp (Flag, L"csr_rotate")      ) GlobalConfig.ShowTools[j] = TAG_CSR_ROTATE;
-                else if (MyStriCmp (Flag, L"fwupdate")        ) GlobalConfig.ShowTools[j] = TAG_FWUPDATE_TOOL;
-                else if (MyStriCmp (Flag, L"clean_nvram")     ) GlobalConfig.ShowTools[j] = TAG_INFO_NVRAMCLEAN;
-                else if (MyStriCmp (Flag, L"windows_recovery")) GlobalConfig.ShowTools[j] = TAG_RECOVERY_WINDOWS;
-                else if (MyStriCmp (Flag, L"apple_recovery")  ) GlobalConfig.ShowTools[j] = TAG_RECOVERY_APPLE;
-                else if (MyStriCmp (Flag, L"hidden_tags")) {
-                    GlobalConfig.ShowTools[j] = TAG_HIDDEN;
-                    GlobalConfig.HiddenTags = TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'windows_recovery_files'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCAN_DRIVER_DIRS:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.DriverDirs));
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'scan_driver_dirs'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SHOWTOOLS:
+                // DA-TAG: HiddenTags reset looks strange but is actually valid
+                //         Artificial default of 'TRUE' needed as misconfig exit option
+                //         This sets real default of 'FALSE' when 'showtools' is present
+                GlobalConfig.HiddenTags = FALSE;
+
+                SetMem (GlobalConfig.ShowTools, NUM_TOOLS * sizeof (UINTN), 0);
+
+                BOOLEAN DoneTool = FALSE;
+                UINTN InvalidEntries = 0;
+                i = 0;
+                for (;;) {
+                    // DA-TAG: Start Index is 1 Here ('i' for NUM_TOOLS/TokenList)
+                    i = i + 1;
+                    if (i >= TokenCount ||
+                        i >= (NUM_TOOLS + InvalidEntries)
+                    ) {
+                        // Break Loop
+                        break;
+                    }
+
+                    // Set Showtools Index
+                    j = (DoneTool) ? j + 1 : 0;
+
+                    Flag = TokenList[i];
+                    if (0);
+                    else if (MyStriCmp (Flag, L"exit")            ) GlobalConfig.ShowTools[j] = TAG_EXIT;
+                    else if (MyStriCmp (Flag, L"shell")           ) GlobalConfig.ShowTools[j] = TAG_SHELL;
+                    else if (MyStriCmp (Flag, L"gdisk")           ) GlobalConfig.ShowTools[j] = TAG_GDISK;
+                    else if (MyStriCmp (Flag, L"about")           ) GlobalConfig.ShowTools[j] = TAG_ABOUT;
+                    else if (MyStriCmp (Flag, L"reboot")          ) GlobalConfig.ShowTools[j] = TAG_REBOOT;
+                    else if (MyStriCmp (Flag, L"gptsync")         ) GlobalConfig.ShowTools[j] = TAG_GPTSYNC;
+                    else if (MyStriCmp (Flag, L"install")         ) GlobalConfig.ShowTools[j] = TAG_INSTALL;
+                    else if (MyStriCmp (Flag, L"netboot")         ) GlobalConfig.ShowTools[j] = TAG_NETBOOT;
+                    else if (MyStriCmp (Flag, L"memtest")         ) GlobalConfig.ShowTools[j] = TAG_MEMTEST;
+                    else if (MyStriCmp (Flag, L"memtest86")       ) GlobalConfig.ShowTools[j] = TAG_MEMTEST;
+                    else if (MyStriCmp (Flag, L"shutdown")        ) GlobalConfig.ShowTools[j] = TAG_SHUTDOWN;
+                    else if (MyStriCmp (Flag, L"mok_tool")        ) GlobalConfig.ShowTools[j] = TAG_MOK_TOOL;
+                    else if (MyStriCmp (Flag, L"firmware")        ) GlobalConfig.ShowTools[j] = TAG_FIRMWARE;
+                    else if (MyStriCmp (Flag, L"bootorder")       ) GlobalConfig.ShowTools[j] = TAG_BOOTORDER;
+                    else if (MyStriCmp (Flag, L"csr_rotate")      ) GlobalConfig.ShowTools[j] = TAG_CSR_ROTATE;
+                    else if (MyStriCmp (Flag, L"fwupdate")        ) GlobalConfig.ShowTools[j] = TAG_FWUPDATE_TOOL;
+                    else if (MyStriCmp (Flag, L"clean_nvram")     ) GlobalConfig.ShowTools[j] = TAG_INFO_NVRAMCLEAN;
+                    else if (MyStriCmp (Flag, L"windows_recovery")) GlobalConfig.ShowTools[j] = TAG_RECOVERY_WINDOWS;
+                    else if (MyStriCmp (Flag, L"apple_recovery")  ) GlobalConfig.ShowTools[j] = TAG_RECOVERY_APPLE;
+                    else if (MyStriCmp (Flag, L"hidden_tags")) {
+                        GlobalConfig.ShowTools[j] = TAG_HIDDEN;
+                        GlobalConfig.HiddenTags = TRUE;
+                    }
+                    else {
+                        #if REFIT_DEBUG > 0
+                        MuteLogger = FALSE;
+                        ALT_LOG(1, LOG_THREE_STAR_MID, L"Invalid Config Entry in 'showtools' List:- '%s'!!", Flag);
+                        MuteLogger = TRUE;
+                        #endif
+
+                        // Handle Showtools Index
+                        j = (DoneTool) ? j - 1 : 0;
+
+                        // Increment Invalid Entry Count
+                        InvalidEntries = InvalidEntries + 1;
+
+                        // Skip 'DoneTool' Reset
+                        continue;
+                    }
+                    DoneTool = TRUE;
+                } // for ;;
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'showtools'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_BANNER:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.BannerFileName));
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'banner'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_BANNER_SCALE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
+
+                if (MyStriCmp (TokenList[1], L"noscale")) {
+                    GlobalConfig.BannerScale = BANNER_NOSCALE;
+                }
+                else if (
+                    MyStriCmp (TokenList[1], L"fillscreen") ||
+                    MyStriCmp (TokenList[1], L"fullscreen")
+                ) {
+                    GlobalConfig.BannerScale = BANNER_FILLSCREEN;
                 }
                 else {
+                    MsgStr = PoolPrint (
+                        L"  - WARN: Invalid 'banner_type' Flag:- '%s'",
+                        TokenList[1]
+                    );
+                    PrintUglyText (MsgStr, NEXTLINE);
+
                     #if REFIT_DEBUG > 0
                     MuteLogger = FALSE;
-                    ALT_LOG(1, LOG_THREE_STAR_MID, L"Invalid Config Entry in 'showtools' List:- '%s'!!", Flag);
+                    LOG_MSG("%s%s", OffsetNext, MsgStr);
                     MuteLogger = TRUE;
                     #endif
 
-                    // Handle Showtools Index
-                    j = (DoneTool) ? j - 1 : 0;
+                    PauseForKey();
+                    MY_FREE_POOL(MsgStr);
+                } // if/else MyStriCmp TokenList[0]
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'banner_scale'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_NVRAM_VARIABLE_LIMIT:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-                    // Increment Invalid Entry Count
-                    InvalidEntries = InvalidEntries + 1;
+                HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.NvramVariableLimit));
 
-                    // Skip 'DoneTool' Reset
-                    continue;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'nvram_variable_limit'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SMALL_ICON_SIZE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
                 }
-                DoneTool = TRUE;
-            } // for ;;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'showtools'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"banner")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.BannerFileName));
+                HandleUnsignedInt (TokenList, TokenCount, &i);
+                if (i >= 32) {
+                    GlobalConfig.IconSizes[ICON_SIZE_SMALL] = i;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'banner'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"banner_scale") && (TokenCount == 2)) {
-            if (MyStriCmp (TokenList[1], L"noscale")) {
-                GlobalConfig.BannerScale = BANNER_NOSCALE;
-            }
-            else if (
-                MyStriCmp (TokenList[1], L"fillscreen") ||
-                MyStriCmp (TokenList[1], L"fullscreen")
-            ) {
-                GlobalConfig.BannerScale = BANNER_FILLSCREEN;
-            }
-            else {
-                MsgStr = PoolPrint (
-                    L"  - WARN: Invalid 'banner_type' Flag:- '%s'",
-                    TokenList[1]
-                );
-                PrintUglyText (MsgStr, NEXTLINE);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'small_icon_size'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_BIG_ICON_SIZE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
+
+                HandleUnsignedInt (TokenList, TokenCount, &i);
+                if (i >= 32) {
+                    GlobalConfig.IconSizes[ICON_SIZE_BIG] = i;
+                    GlobalConfig.IconSizes[ICON_SIZE_BADGE] = i / 4;
+                }
 
                 #if REFIT_DEBUG > 0
-                MuteLogger = FALSE;
-                LOG_MSG("%s%s", OffsetNext, MsgStr);
-                MuteLogger = TRUE;
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'big_icon_size'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
                 #endif
+            break;
+            case CONFIG_KEY_MOUSE_SIZE:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-                PauseForKey();
-                MY_FREE_POOL(MsgStr);
-            } // if/else MyStriCmp TokenList[0]
+                HandleUnsignedInt (TokenList, TokenCount, &i);
+                if (i >= DEFAULT_MOUSE_SIZE) {
+                    GlobalConfig.IconSizes[ICON_SIZE_MOUSE] = i;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'banner_scale'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"nvram_variable_limit") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.NvramVariableLimit));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'mouse_size'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SELECTION_SMALL:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.SelectionSmallFileName));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'nvram_variable_limit'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"small_icon_size") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &i);
-            if (i >= 32) {
-                GlobalConfig.IconSizes[ICON_SIZE_SMALL] = i;
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'selection_small'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SELECTION_BIG:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.SelectionBigFileName));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'small_icon_size'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"big_icon_size") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &i);
-            if (i >= 32) {
-                GlobalConfig.IconSizes[ICON_SIZE_BIG] = i;
-                GlobalConfig.IconSizes[ICON_SIZE_BADGE] = i / 4;
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'selection_big'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DEFAULT_SELECTION:
+                if (TokenCount == 4) {
+                    SetDefaultByTime (TokenList, &(GlobalConfig.DefaultSelection));
+                }
+                else {
+                    HandleString (TokenList, TokenCount, &(GlobalConfig.DefaultSelection));
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'big_icon_size'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"mouse_size") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &i);
-            if (i >= DEFAULT_MOUSE_SIZE) {
-                GlobalConfig.IconSizes[ICON_SIZE_MOUSE] = i;
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'default_selection'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_TEXTONLY:
+                GlobalConfig.TextOnly = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'mouse_size'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"selection_small")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.SelectionSmallFileName));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'textonly'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_TEXTMODE:
+                HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.RequestedTextMode));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'selection_small'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"selection_big")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.SelectionBigFileName));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'textmode'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_RESOLUTION:
+                if ((TokenCount != 2) && (TokenCount != 3)) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'selection_big'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"default_selection")) {
-            if (TokenCount == 4) {
-                SetDefaultByTime (TokenList, &(GlobalConfig.DefaultSelection));
-            }
-            else {
-                HandleString (TokenList, TokenCount, &(GlobalConfig.DefaultSelection));
-            }
+                if (MyStriCmp(TokenList[1], L"max")) {
+                    // DA-TAG: Has been set to 0 so as to ignore the 'max' setting
+                    //GlobalConfig.RequestedScreenWidth  = MAX_RES_CODE;
+                    //GlobalConfig.RequestedScreenHeight = MAX_RES_CODE;
+                    GlobalConfig.RequestedScreenWidth  = 0;
+                    GlobalConfig.RequestedScreenHeight = 0;
+                }
+                else {
+                    GlobalConfig.RequestedScreenWidth = Atoi(TokenList[1]);
+                    if (TokenCount == 3) {
+                        GlobalConfig.RequestedScreenHeight = Atoi(TokenList[2]);
+                    }
+                    else {
+                        GlobalConfig.RequestedScreenHeight = 0;
+                    }
+                }
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'resolution'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCREENSAVER:
+                // DA-TAG: Signed integer as can have negative value
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.ScreensaverTime));
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'screensaver'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_USE_GRAPHICS_FOR:
+                if ((TokenCount == 2) || ((TokenCount > 2) && (!MyStriCmp (TokenList[1], L"+")))) {
+                    GlobalConfig.GraphicsFor = 0;
+                }
+
+                for (i = 1; i < TokenCount; i++) {
+                    if (0);
+                    else if (MyStriCmp (TokenList[i], L"osx")     ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_OSX;
+                    else if (MyStriCmp (TokenList[i], L"grub")    ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_GRUB;
+                    else if (MyStriCmp (TokenList[i], L"linux")   ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_LINUX;
+                    else if (MyStriCmp (TokenList[i], L"elilo")   ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_ELILO;
+                    else if (MyStriCmp (TokenList[i], L"clover")  ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_CLOVER;
+                    else if (MyStriCmp (TokenList[i], L"windows") ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_WINDOWS;
+                    else if (MyStriCmp (TokenList[i], L"opencore")) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_OPENCORE;
+                } // for
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'use_graphics_for'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_FONT:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'default_selection'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"textonly")) {
-            GlobalConfig.TextOnly = HandleBoolean (TokenList, TokenCount);
+                egLoadFont (TokenList[1]);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'textonly'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"textmode")) {
-            HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.RequestedTextMode));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'font'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCAN_ALL_LINUX_KERNELS:
+                GlobalConfig.ScanAllLinux = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'textmode'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"resolution") && ((TokenCount == 2) || (TokenCount == 3))) {
-            if (MyStriCmp(TokenList[1], L"max")) {
-                // DA-TAG: Has been set to 0 so as to ignore the 'max' setting
-                //GlobalConfig.RequestedScreenWidth  = MAX_RES_CODE;
-                //GlobalConfig.RequestedScreenHeight = MAX_RES_CODE;
-                GlobalConfig.RequestedScreenWidth  = 0;
-                GlobalConfig.RequestedScreenHeight = 0;
-            }
-            else {
-                GlobalConfig.RequestedScreenWidth = Atoi(TokenList[1]);
-                if (TokenCount == 3) {
-                    GlobalConfig.RequestedScreenHeight = Atoi(TokenList[2]);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'scan_all_linux_kernels'", OffsetNext);
+                    MuteLogger = TRUE;
                 }
-                else {
-                    GlobalConfig.RequestedScreenHeight = 0;
+                #endif
+            break;
+            case CONFIG_KEY_FOLD_LINUX_KERNELS:
+                GlobalConfig.FoldLinuxKernels = HandleBoolean (TokenList, TokenCount);
+
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'fold_linux_kernels'", OffsetNext);
+                    MuteLogger = TRUE;
                 }
-            }
+                #endif
+            break;
+            case CONFIG_KEY_EXTRA_KERNEL_VERSION_STRINGS:
+                HandleStrings (TokenList, TokenCount, &(GlobalConfig.ExtraKernelVersionStrings));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'resolution'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"screensaver")) {
-            // DA-TAG: Signed integer as can have negative value
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.ScreensaverTime));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'extra_kernel_version_strings'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_MAX_TAGS:
+                HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.MaxTags));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'screensaver'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"use_graphics_for")) {
-            if ((TokenCount == 2) || ((TokenCount > 2) && (!MyStriCmp (TokenList[1], L"+")))) {
-                GlobalConfig.GraphicsFor = 0;
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'max_tags'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_ENABLE_AND_LOCK_VMX:
+                GlobalConfig.EnableAndLockVMX = HandleBoolean (TokenList, TokenCount);
 
-            for (i = 1; i < TokenCount; i++) {
-                if (0);
-                else if (MyStriCmp (TokenList[i], L"osx")     ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_OSX;
-                else if (MyStriCmp (TokenList[i], L"grub")    ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_GRUB;
-                else if (MyStriCmp (TokenList[i], L"linux")   ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_LINUX;
-                else if (MyStriCmp (TokenList[i], L"elilo")   ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_ELILO;
-                else if (MyStriCmp (TokenList[i], L"clover")  ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_CLOVER;
-                else if (MyStriCmp (TokenList[i], L"windows") ) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_WINDOWS;
-                else if (MyStriCmp (TokenList[i], L"opencore")) GlobalConfig.GraphicsFor |= GRAPHICS_FOR_OPENCORE;
-            } // for
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'enable_and_lock_vmx'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SPOOF_OSX_VERSION:
+                HandleString (TokenList, TokenCount, &(GlobalConfig.SpoofOSXVersion));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'use_graphics_for'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"font") && (TokenCount == 2)) {
-            egLoadFont (TokenList[1]);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'spoof_osx_version'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_CSR_VALUES:
+                HandleHexes (TokenList, TokenCount, CSR_MAX_LEGAL_VALUE, &(GlobalConfig.CsrValues));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'font'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"scan_all_linux_kernels")) {
-            GlobalConfig.ScanAllLinux = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'csr_values'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCREEN_RGB:
+                if (TokenCount != 4) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'scan_all_linux_kernels'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"fold_linux_kernels")) {
-            GlobalConfig.FoldLinuxKernels = HandleBoolean (TokenList, TokenCount);
+                // DA-TAG: Consider handling hex input?
+                //         KISS ... Stick with integers
+                GlobalConfig.ScreenR = Atoi(TokenList[1]);
+                GlobalConfig.ScreenG = Atoi(TokenList[2]);
+                GlobalConfig.ScreenB = Atoi(TokenList[3]);
+
+                // Record whether a valid custom screen BG is specified
+                GlobalConfig.CustomScreenBG = (
+                    GlobalConfig.ScreenR >= 0 && GlobalConfig.ScreenR <= 255 &&
+                    GlobalConfig.ScreenG >= 0 && GlobalConfig.ScreenG <= 255 &&
+                    GlobalConfig.ScreenB >= 0 && GlobalConfig.ScreenB <= 255
+                );
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'fold_linux_kernels'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"extra_kernel_version_strings")) {
-            HandleStrings (TokenList, TokenCount, &(GlobalConfig.ExtraKernelVersionStrings));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'screen_rgb'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_INCLUDE:
+                if (!AllowIncludes || (TokenCount != 2) || !MyStriCmp (FileName, GlobalConfig.ConfigFilename)) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'extra_kernel_version_strings'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"max_tags")) {
-            HandleUnsignedInt (TokenList, TokenCount, &(GlobalConfig.MaxTags));
+                if (!MyStriCmp (TokenList[1], FileName)) {
+                    #if REFIT_DEBUG > 0
+                    // DA-TAG: Always log this in case LogLevel is overriden
+                    INTN RealLogLevel = 0;
+                    INTN HighLogLevel = MaxLogLevel * 10;
+                    if (GlobalConfig.LogLevel < MINLOGLEVEL) {
+                        RealLogLevel = GlobalConfig.LogLevel;
+                        GlobalConfig.LogLevel = HighLogLevel;
+                    }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'max_tags'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"enable_and_lock_vmx")) {
-            GlobalConfig.EnableAndLockVMX = HandleBoolean (TokenList, TokenCount);
+                    MuteLogger = FALSE;
+                    if (FirstInclude) {
+                        LOG_MSG("\n");
+                        LOG_MSG("Detected Overrides File - L O A D   S E T T I N G   O V E R R I D E S");
+                        FirstInclude = FALSE;
+                    }
+                    LOG_MSG("%s* Supplementary Configuration ... %s", OffsetNext, TokenList[1]);
+                    MuteLogger = TRUE; /* Explicit For FB Infer */
+                    #endif
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'enable_and_lock_vmx'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"spoof_osx_version")) {
-            HandleString (TokenList, TokenCount, &(GlobalConfig.SpoofOSXVersion));
+                    // Set 'AllowIncludes' to 'false' to break any 'include' chains
+                    OuterLoop = FALSE;
+                    ReadConfig (TokenList[1]);
+                    OuterLoop = TRUE;
+                    // Reset 'AllowIncludes' to accomodate multiple instances in main file
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'spoof_osx_version'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"csr_values")) {
-            HandleHexes (TokenList, TokenCount, CSR_MAX_LEGAL_VALUE, &(GlobalConfig.CsrValues));
+                    #if REFIT_DEBUG > 0
+                    // DA-TAG: Restore the RealLogLevel
+                    if (GlobalConfig.LogLevel == HighLogLevel) {
+                        GlobalConfig.LogLevel = RealLogLevel;
+                    }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'csr_values'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"screen_rgb") && TokenCount == 4) {
-            // DA-TAG: Consider handling hex input?
-            //         KISS ... Stick with integers
-            GlobalConfig.ScreenR = Atoi(TokenList[1]);
-            GlobalConfig.ScreenG = Atoi(TokenList[2]);
-            GlobalConfig.ScreenB = Atoi(TokenList[3]);
-
-            // Record whether a valid custom screen BG is specified
-            GlobalConfig.CustomScreenBG = (
-                GlobalConfig.ScreenR >= 0 && GlobalConfig.ScreenR <= 255 &&
-                GlobalConfig.ScreenG >= 0 && GlobalConfig.ScreenG <= 255 &&
-                GlobalConfig.ScreenB >= 0 && GlobalConfig.ScreenB <= 255
-            );
+                    // Failsafe
+                    MuteLogger = TRUE; /* Explicit For FB Infer */
+                    #endif
+                }
+            break;
+            case CONFIG_KEY_WRITE_SYSTEMD_VARS:
+                GlobalConfig.WriteSystemdVars = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'screen_rgb'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (AllowIncludes
-            && (TokenCount == 2)
-            && MyStriCmp (TokenList[0], L"include")
-            && MyStriCmp (FileName, GlobalConfig.ConfigFilename)
-        ) {
-            if (!MyStriCmp (TokenList[1], FileName)) {
                 #if REFIT_DEBUG > 0
-                // DA-TAG: Always log this in case LogLevel is overriden
-                INTN RealLogLevel = 0;
-                INTN HighLogLevel = MaxLogLevel * 10;
-                if (GlobalConfig.LogLevel < MINLOGLEVEL) {
-                    RealLogLevel = GlobalConfig.LogLevel;
-                    GlobalConfig.LogLevel = HighLogLevel;
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'write_systemd_vars'", OffsetNext);
+                    MuteLogger = TRUE;
                 }
+                #endif
+            break;
+            case CONFIG_KEY_UNICODE_COLLATION:
+                GlobalConfig.UnicodeCollation = HandleBoolean (TokenList, TokenCount);
 
-                MuteLogger = FALSE;
-                if (FirstInclude) {
-                    LOG_MSG("\n");
-                    LOG_MSG("Detected Overrides File - L O A D   S E T T I N G   O V E R R I D E S");
-                    FirstInclude = FALSE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'unicode_collation'", OffsetNext);
+                    MuteLogger = TRUE;
                 }
-                LOG_MSG("%s* Supplementary Configuration ... %s", OffsetNext, TokenList[1]);
-                MuteLogger = TRUE; /* Explicit For FB Infer */
                 #endif
-
-                // Set 'AllowIncludes' to 'false' to break any 'include' chains
-                OuterLoop = FALSE;
-                ReadConfig (TokenList[1]);
-                OuterLoop = TRUE;
-                // Reset 'AllowIncludes' to accomodate multiple instances in main file
+            break;
+            case CONFIG_KEY_ENABLE_MOUSE:
+                GlobalConfig.EnableMouse = HandleBoolean (TokenList, TokenCount);
 
                 #if REFIT_DEBUG > 0
-                // DA-TAG: Restore the RealLogLevel
-                if (GlobalConfig.LogLevel == HighLogLevel) {
-                    GlobalConfig.LogLevel = RealLogLevel;
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'enable_mouse'", OffsetNext);
+                    MuteLogger = TRUE;
                 }
-
-                // Failsafe
-                MuteLogger = TRUE; /* Explicit For FB Infer */
                 #endif
-            }
-        }
-        else if (MyStriCmp (TokenList[0], L"write_systemd_vars")) {
-            GlobalConfig.WriteSystemdVars = HandleBoolean (TokenList, TokenCount);
-
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'write_systemd_vars'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"unicode_collation")) {
-            GlobalConfig.UnicodeCollation = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'unicode_collation'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"enable_mouse")) {
-            GlobalConfig.EnableMouse = HandleBoolean (TokenList, TokenCount);
-
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'enable_mouse'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
+                // DA-TAG: Force 'RescanDXE'
+                //         Update other instances if changing
+                if (GlobalConfig.EnableMouse) {
+                    GlobalConfig.RescanDXE = TRUE;
+                }
+            break;
+            case CONFIG_KEY_ENABLE_TOUCH:
+                GlobalConfig.EnableTouch = HandleBoolean (TokenList, TokenCount);
 
-            // DA-TAG: Force 'RescanDXE'
-            //         Update other instances if changing
-            if (GlobalConfig.EnableMouse) {
-                GlobalConfig.RescanDXE = TRUE;
-            }
-        }
-        else if (MyStriCmp (TokenList[0], L"enable_touch")) {
-            GlobalConfig.EnableTouch = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'enable_touch'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'enable_touch'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
+                // DA-TAG: Force 'RescanDXE'
+                //         Update other instances if changing
+                if (GlobalConfig.EnableTouch) {
+                    GlobalConfig.RescanDXE = TRUE;
+                }
+            break;
+            case CONFIG_KEY_PROVIDE_CONSOLE_GOP:
+                GlobalConfig.ProvideConsoleGOP = HandleBoolean (TokenList, TokenCount);
 
-            // DA-TAG: Force 'RescanDXE'
-            //         Update other instances if changing
-            if (GlobalConfig.EnableTouch) {
-                GlobalConfig.RescanDXE = TRUE;
-            }
-        }
-        else if (MyStriCmp (TokenList[0], L"provide_console_gop")) {
-            GlobalConfig.ProvideConsoleGOP = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'provide_console_gop'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_TRANSIENT_BOOT:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.TransientBoot = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'provide_console_gop'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"transient_boot") ||
-            MyStriCmp (TokenList[0], L"ignore_previous_boot")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.TransientBoot = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'transient_boot'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_HIDDEN_ICONS_IGNORE:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.HiddenIconsIgnore = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'transient_boot'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"hidden_icons_ignore") ||
-            MyStriCmp (TokenList[0], L"ignore_hidden_icons")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.HiddenIconsIgnore = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'hidden_icons_ignore'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_HIDDEN_ICONS_EXTERNAL:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.HiddenIconsExternal = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'hidden_icons_ignore'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"hidden_icons_external") ||
-            MyStriCmp (TokenList[0], L"external_hidden_icons")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.HiddenIconsExternal = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'hidden_icons_external'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_HIDDEN_ICONS_PREFER:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.HiddenIconsPrefer = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'hidden_icons_external'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"hidden_icons_prefer") ||
-            MyStriCmp (TokenList[0], L"prefer_hidden_icons")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.HiddenIconsPrefer = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'hidden_icons_prefer'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_RENDERER_TEXT:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.UseTextRenderer = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'hidden_icons_prefer'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"renderer_text") ||
-            MyStriCmp (TokenList[0], L"text_renderer")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.UseTextRenderer = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'renderer_text'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_PASS_UGA_THROUGH:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.PassUgaThrough = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'renderer_text'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"pass_uga_through") ||
-            MyStriCmp (TokenList[0], L"uga_pass_through")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.PassUgaThrough = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'pass_uga_through'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_RENDERER_DIRECT_GOP:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.UseDirectGop = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'pass_uga_through'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"renderer_direct_gop") ||
-            MyStriCmp (TokenList[0], L"direct_gop_renderer")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.UseDirectGop = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'renderer_direct_gop'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_FORCE_TRIM:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.ForceTRIM = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'renderer_direct_gop'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"force_trim") ||
-            MyStriCmp (TokenList[0], L"trim_force")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.ForceTRIM = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'force_trim'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_RELOAD_GOP:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.ReloadGOP = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'force_trim'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_reload_gop") ||
-            MyStriCmp (TokenList[0], L"decline_reloadgop")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.ReloadGOP = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_reload_gop'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_APFS_LOAD:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.SupplyAPFS = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_reload_gop'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_apfs_load") ||
-            MyStriCmp (TokenList[0], L"decline_apfsload")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.SupplyAPFS = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_apfs_load'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_APFS_MUTE:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.SilenceAPFS = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_apfs_load'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_apfs_mute") ||
-            MyStriCmp (TokenList[0], L"decline_apfsmute")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.SilenceAPFS = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_apfs_mute'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_APFS_SYNC:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.SyncAPFS = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_apfs_mute'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_apfs_sync") ||
-            MyStriCmp (TokenList[0], L"decline_apfssync")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.SyncAPFS = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_apfs_sync'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_APPLE_FB:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.SupplyAppleFB = (!AppleFirmware)
+                    ? FALSE
+                    : (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_apfs_sync'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_apple_fb") ||
-            MyStriCmp (TokenList[0], L"decline_applefb")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.SupplyAppleFB = (!AppleFirmware)
-                ? FALSE
-                : (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_apple_fb'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_NVRAM_PROTECT:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.NvramProtect = (!AppleFirmware)
+                    ? FALSE
+                    : (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_apple_fb'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_nvram_protect") ||
-            MyStriCmp (TokenList[0], L"decline_nvramprotect")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.NvramProtect = (!AppleFirmware)
-                ? FALSE
-                : (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_nvram_protect'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_HELP_TAGS:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.HelpTags = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_nvram_protect'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_help_tags")  ||
-            MyStriCmp (TokenList[0], L"decline_tags_help") ||
-            MyStriCmp (TokenList[0], L"decline_tagshelp")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.HelpTags = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_help_tags'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECLINE_HELP_TEXT:
+                // DA_TAG: Accomodate Deprecation
+                DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                GlobalConfig.HelpText = (DeclineSetting) ? FALSE : TRUE;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_help_tags'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"decline_help_text")  ||
-            MyStriCmp (TokenList[0], L"decline_text_help") ||
-            MyStriCmp (TokenList[0], L"decline_texthelp")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            GlobalConfig.HelpText = (DeclineSetting) ? FALSE : TRUE;
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decline_help_text'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_CSR_NORMALISE:
+                // DA_TAG: Accomodate Deprecation
+                GlobalConfig.NormaliseCSR = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decline_help_text'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"csr_normalise") ||
-            MyStriCmp (TokenList[0], L"normalise_csr")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            GlobalConfig.NormaliseCSR = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'csr_normalise'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_CSR_DYNAMIC:
+                // DA_TAG: Accomodate Deprecation
+                // DA-TAG: Signed integer as can have negative value
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.DynamicCSR));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'csr_normalise'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            MyStriCmp (TokenList[0], L"csr_dynamic") ||
-            MyStriCmp (TokenList[0], L"active_csr")
-        ) {
-            // DA_TAG: Accomodate Deprecation
-            // DA-TAG: Signed integer as can have negative value
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.DynamicCSR));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'csr_dynamic'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_MOUSE_SPEED:
+                if (TokenCount != 2) {
+                    // Not a valid setting line
+                    break;
+                }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'csr_dynamic'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"mouse_speed") && (TokenCount == 2)) {
-            HandleUnsignedInt (TokenList, TokenCount, &i);
-            if (i < 1)  i = 1;
-            if (i > 32) i = 32;
-            GlobalConfig.MouseSpeed = i;
+                HandleUnsignedInt (TokenList, TokenCount, &i);
+                if (i < 1)  i = 1;
+                if (i > 32) i = 32;
+                GlobalConfig.MouseSpeed = i;
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'mouse_speed'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"continue_on_warning")) {
-            GlobalConfig.ContinueOnWarning = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'mouse_speed'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_CONTINUE_ON_WARNING:
+                GlobalConfig.ContinueOnWarning = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'continue_on_warning'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"decouple_key_f10")) {
-            GlobalConfig.DecoupleKeyF10 = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'continue_on_warning'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DECOUPLE_KEY_F10:
+                GlobalConfig.DecoupleKeyF10 = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'decouple_key_f10'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"disable_nvram_paniclog")) {
-            GlobalConfig.DisableNvramPanicLog = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'decouple_key_f10'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DISABLE_NVRAM_PANICLOG:
+                GlobalConfig.DisableNvramPanicLog = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'disable_nvram_paniclog'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"disable_compat_check")) {
-            GlobalConfig.DisableCompatCheck = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'disable_nvram_paniclog'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DISABLE_COMPAT_CHECK:
+                GlobalConfig.DisableCompatCheck = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'disable_compat_check'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"disable_amfi")) {
-            GlobalConfig.DisableAMFI = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'disable_compat_check'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_DISABLE_AMFI:
+                GlobalConfig.DisableAMFI = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'disable_amfi'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"follow_symlinks")) {
-            GlobalConfig.FollowSymlinks = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'disable_amfi'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_FOLLOW_SYMLINKS:
+                GlobalConfig.FollowSymlinks = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'follow_symlinks'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"prefer_uga")) {
-            GlobalConfig.PreferUGA = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'follow_symlinks'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_PREFER_UGA:
+                GlobalConfig.PreferUGA = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'prefer_uga'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"supply_nvme")) {
-            GlobalConfig.SupplyNVME = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'prefer_uga'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SUPPLY_NVME:
+                GlobalConfig.SupplyNVME = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'supply_nvme'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"supply_uefi")) {
-            GlobalConfig.SupplyUEFI = HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'supply_nvme'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SUPPLY_UEFI:
+                GlobalConfig.SupplyUEFI = HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'supply_uefi'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"nvram_protect_ex")) {
-            GlobalConfig.NvramProtectEx = (!AppleFirmware)
-                ? FALSE
-                : HandleBoolean (TokenList, TokenCount);
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'supply_uefi'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_NVRAM_PROTECT_EX:
+                GlobalConfig.NvramProtectEx = (!AppleFirmware)
+                    ? FALSE
+                    : HandleBoolean (TokenList, TokenCount);
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'nvram_protect_ex'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (
-            StriSubCmp (L"esp_filter", TokenList[0]) ||
-            StriSubCmp (L"espfilter", TokenList[0])
-        ) {
-            DeclineSetting = HandleBoolean (TokenList, TokenCount);
-            if (MyStriCmp (TokenList[0], L"enable_esp_filter")) {
-                GlobalConfig.ScanAllESP = (DeclineSetting) ? FALSE : TRUE;
-            }
-            else if (
-                MyStriCmp (TokenList[0], L"disable_esp_filter") ||
-                MyStriCmp (TokenList[0], L"disable_espfilter")
-            ) {
-                // DA_TAG: Duplication Purely to Accomodate Deprecation
-                //         Change top level 'substring' check when dropped
-                GlobalConfig.ScanAllESP = DeclineSetting;
-            }
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'nvram_protect_ex'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            case CONFIG_KEY_SCALE_UI:
+                // DA-TAG: Signed integer as can have negative value
+                HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.ScaleUI));
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'enable_esp_filter'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
-        else if (MyStriCmp (TokenList[0], L"scale_ui")) {
-            // DA-TAG: Signed integer as can have negative value
-            HandleSignedInt (TokenList, TokenCount, &(GlobalConfig.ScaleUI));
+                #if REFIT_DEBUG > 0
+                if (!AllowIncludes) {
+                    MuteLogger = FALSE;
+                    LOG_MSG("%s  - Updated:- 'scale_ui'", OffsetNext);
+                    MuteLogger = TRUE;
+                }
+                #endif
+            break;
+            default:
+                if (
+                    StriSubCmp (L"esp_filter", TokenList[0]) ||
+                    StriSubCmp (L"espfilter", TokenList[0])
+                ) {
+                    DeclineSetting = HandleBoolean (TokenList, TokenCount);
+                    if (MyStriCmp (TokenList[0], L"enable_esp_filter")) {
+                        GlobalConfig.ScanAllESP = (DeclineSetting) ? FALSE : TRUE;
+                    }
+                    else if (
+                        MyStriCmp (TokenList[0], L"disable_esp_filter") ||
+                        MyStriCmp (TokenList[0], L"disable_espfilter")
+                    ) {
+                        // DA_TAG: Duplication Purely to Accomodate Deprecation
+                        //         Change top level 'substring' check when dropped
+                        GlobalConfig.ScanAllESP = DeclineSetting;
+                    }
 
-            #if REFIT_DEBUG > 0
-            if (!AllowIncludes) {
-                MuteLogger = FALSE;
-                LOG_MSG("%s  - Updated:- 'scale_ui'", OffsetNext);
-                MuteLogger = TRUE;
-            }
-            #endif
-        }
+                    #if REFIT_DEBUG > 0
+                    if (!AllowIncludes) {
+                        MuteLogger = FALSE;
+                        LOG_MSG("%s  - Updated:- 'enable_esp_filter'", OffsetNext);
+                        MuteLogger = TRUE;
+                    }
+                    #endif
+                }
+        } // switch
 
-        FreeTokenLine (&TokenList, &TokenCount);
+        FreeTokenLineInPlace (&TokenList, &TokenCount);
     } // for ;;
-    FreeTokenLine (&TokenList, &TokenCount);
+    FreeTokenLineInPlace (&TokenList, &TokenCount);
 
     // Forced Default Settings
     if (AppleFirmware)  GlobalConfig.RansomDrives   = FALSE;
@@ -2237,7 +2281,7 @@ VOID AddSubmenu (
     BREAD_CRUMB(L"%s:  5", FuncTag);
     SubEntry->Enabled = TRUE;
     while ((SubEntry->Enabled)
-        && ((TokenCount = ReadTokenLine (File, &TokenList)) > 0)
+        && ((TokenCount = ReadTokenLineInPlace (File, &TokenList)) > 0)
         && (StrCmp (TokenList[0], L"}") != 0)
     ) {
         LOG_SEP(L"X");
@@ -2299,7 +2343,7 @@ VOID AddSubmenu (
         }
 
         BREAD_CRUMB(L"%s:  5a 2", FuncTag);
-        FreeTokenLine (&TokenList, &TokenCount);
+        FreeTokenLineInPlace (&TokenList, &TokenCount);
 
         BREAD_CRUMB(L"%s:  5a 3 - WHILE LOOP:- END", FuncTag);
         LOG_SEP(L"X");
@@ -2417,7 +2461,7 @@ LOADER_ENTRY * AddStanzaEntries (
     #endif
 
     while (Entry->Enabled
-        && ((TokenCount = ReadTokenLine (File, &TokenList)) > 0)
+        && ((TokenCount = ReadTokenLineInPlace (File, &TokenList)) > 0)
         && (StrCmp (TokenList[0], L"}") != 0)
     ) {
         if (MyStriCmp (TokenList[0], L"disabled")) {
@@ -2568,7 +2612,7 @@ LOADER_ENTRY * AddStanzaEntries (
             AddedSubmenu = TRUE;
         } // Set options to pass to the loader program
 
-        FreeTokenLine (&TokenList, &TokenCount);
+        FreeTokenLineInPlace (&TokenList, &TokenCount);
     } // while Entry->Enabled
 
     if (!Entry->Enabled) {
@@ -2665,7 +2709,7 @@ VOID ScanUserConfigured (
     EFI_STATUS         Status;
     REFIT_FILE         File;
     CHAR16           **TokenList;
-    UINTN              TokenCount, size;
+    UINTN              TokenCount;
     LOADER_ENTRY      *Entry;
 
     #if REFIT_DEBUG > 1
@@ -2681,14 +2725,14 @@ VOID ScanUserConfigured (
     }
 
     if (FileExists (SelfDir, FileName)) {
-        Status = RefitReadFile (SelfDir, FileName, &File, &size);
+        Status = ReadConfigFile (FileName, &File);
         if (!EFI_ERROR(Status)) {
-            while ((TokenCount = ReadTokenLine (&File, &TokenList)) > 0) {
+            while ((TokenCount = ReadTokenLineInPlace (&File, &TokenList)) > 0) {
                 if (MyStriCmp (TokenList[0], L"menuentry") && (TokenCount > 1)) {
                     TotalEntryCount = TotalEntryCount + 1;
                     Entry = AddStanzaEntries (&File, SelfVolume, TokenList[1]);
                     if (Entry == NULL) {
-                        FreeTokenLine (&TokenList, &TokenCount);
+                        FreeTokenLineInPlace (&TokenList, &TokenCount);
                         continue;
                     }
 
@@ -2741,10 +2785,11 @@ VOID ScanUserConfigured (
                     }
                 }
 
-                FreeTokenLine (&TokenList, &TokenCount);
+                FreeTokenLineInPlace (&TokenList, &TokenCount);
             } // while
 
-            FreeTokenLine (&TokenList, &TokenCount);
+            FreeTokenLineInPlace (&TokenList, &TokenCount);
+            MY_FREE_POOL(File.Buffer);
         }
     } // if FileExists
 
@@ -2842,7 +2887,7 @@ REFIT_FILE * GenerateOptionsFromEtcFstab (
     Options->Encoding = ENCODING_UTF16_LE;
 
     BREAD_CRUMB(L"%s:  7", FuncTag);
-    while ((TokenCount = ReadTokenLine (Fstab, &TokenList)) > 0) {
+    while ((TokenCount = ReadTokenLineInPlace (Fstab, &TokenList)) > 0) {
         #if REFIT_DEBUG > 0
         ALT_LOG(1, LOG_THREE_STAR_MID,
             L"Read Line Holding %d Token%s From '/etc/fstab'",
@@ -2905,7 +2950,7 @@ REFIT_FILE * GenerateOptionsFromEtcFstab (
          } // if
 
          BREAD_CRUMB(L"%s:  7a 2", FuncTag);
-         FreeTokenLine (&TokenList, &TokenCount);
+         FreeTokenLineInPlace (&TokenList, &TokenCount);
 
          BREAD_CRUMB(L"%s:  7a 3 - WHILE LOOP:- END", FuncTag);
          LOG_SEP(L"X");
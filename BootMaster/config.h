@@ -66,6 +66,9 @@ typedef struct {
     CHAR8   *End8Ptr;
     CHAR16  *Current16Ptr;
     CHAR16  *End16Ptr;
+    // Set when the file was read back from the parsed config cache
+    struct _config_snapshot *Snapshot;
+    UINTN   SnapshotIndex;
 } REFIT_FILE;
 
 #define CONFIG_FILE_NAME         L"config.conf"
@@ -0,0 +1,358 @@
+/*
+ * BootMaster/config_tokens.c
+ * Configuration file tokenizer and keyword lookup
+ *
+ * Copyright (c) 2006 Christoph Pfisterer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  * Neither the name of Christoph Pfisterer nor the names of the
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Modifications copyright (c) 2012-2021 Roderick W. Smith
+ *
+ * Modifications distributed under the terms of the GNU General Public
+ * License (GPL) version 3 (GPLv3) or (at your option) any later version.
+ *
+ */
+/*
+ * Modified for RefindPlus
+ * Copyright (c) 2020-2023 Dayo Akanji (sf.net/u/dakanji/profile)
+ * Portions Copyright (c) 2021 Joe van Tunen (joevt@shaw.ca)
+ *
+ * Modifications distributed under the preceding terms.
+ */
+
+// Kept apart from the rest of BootMaster/config.c so that the parser can be
+// built and checked on the host. See BootMaster/test.
+#include "config_tokens.h"
+#ifndef HOST_POSIX
+#include "lib.h"
+#include "mystrings.h"
+#endif
+
+//
+// Get a single line of text from a file
+//
+
+// Returns the next line of File, terminated in place in the file buffer.
+// RefitReadFile() leaves every file as CHAR16 text with room for the final
+// terminator, so nothing is copied. The line stays valid while File->Buffer does.
+CHAR16 * ReadLine (
+    REFIT_FILE *File
+) {
+    CHAR16 *p, *LineStart, *LineEnd;
+
+    if (File->Buffer == NULL) {
+        // Early Return
+        return NULL;
+    }
+
+    if (File->Encoding != ENCODING_UTF16_LE) {
+        // Early Return ... Unsupported encoding
+        return NULL;
+    }
+
+    p = File->Current16Ptr;
+    if (p >= File->End16Ptr) {
+        // Early Return
+        return NULL;
+    }
+
+    LineStart = p;
+    for (; p < File->End16Ptr; p++) {
+        if (*p == 13 || *p == 10) {
+            break;
+        }
+    }
+    LineEnd = p;
+    for (; p < File->End16Ptr; p++) {
+        if (*p != 13 && *p != 10) {
+            break;
+        }
+    }
+    File->Current16Ptr = p;
+
+    *LineEnd = 0;
+
+    return LineStart;
+} // CHAR16 * ReadLine()
+
+// Returns TRUE if c ends an unquoted token.
+static
+BOOLEAN IsTokenEnd (
+    IN CHAR16 c
+) {
+    return (c == ' ' || c == '\t' || c == '=' || c == '#' || c == ',');
+} // static BOOLEAN IsTokenEnd()
+
+// Splits Line into tokens in place and adds them to TokenList.
+// Tokens are separated by spaces, tabs, '=' and ',' outside quotes and a
+// '#' outside quotes starts a comment. A '"' toggles quoting, while '""'
+// stands for a literal quote; the token is written back over itself to drop
+// the second quote, so it never needs a copy. Unquoted Unix style directory
+// separators are switched to DOS style ones. IsQuoted carries over to the
+// next line, as a quote left open continues there.
+VOID SplitTokenLine (
+    IN OUT CHAR16    *Line,
+    IN OUT BOOLEAN   *IsQuoted,
+    IN OUT CHAR16  ***TokenList,
+    IN OUT UINTN     *TokenCount
+) {
+    BOOLEAN  LineFinished;
+    CHAR16  *p, *q, *Token;
+
+    p = Line;
+    for (;;) {
+        // Skip whitespace and find start of token
+        while (!(*IsQuoted) &&
+            (
+                *p == ' '  ||
+                *p == '\t' ||
+                *p == '='  ||
+                *p == ','
+            )
+        ) {
+            p++;
+        } // while
+
+        if (*p == 0 || *p == '#') {
+            break;
+        }
+
+        if (*p == '"') {
+            *IsQuoted = !(*IsQuoted);
+            p++;
+        }
+
+        Token = q = p;
+
+        // Find end of token
+        while (*p != L'\0') {
+            if (*p == L'"') {
+                if (p[1] != L'"') {
+                    *IsQuoted = !(*IsQuoted);
+                    break;
+                }
+
+                // Escaped quote ... Keep one
+                p++;
+            }
+            else if (!(*IsQuoted) && IsTokenEnd (*p)) {
+                break;
+            }
+
+            // Switch Unix style to DOS style directory separators
+            *q++ = (*p == L'/' && !(*IsQuoted)) ? L'\\' : *p;
+            p++;
+        } // while
+
+        LineFinished = (*p == L'\0' || *p == L'#');
+        *q = 0;
+
+        AddListElement ((VOID ***) TokenList, TokenCount, (VOID *) Token);
+
+        if (LineFinished) {
+            break;
+        }
+        p++;
+    } // for ;;
+} // VOID SplitTokenLine()
+
+//
+// Config keyword lookup
+//
+
+static CONFIG_KEYWORD ConfigKeywords[] = {
+    { L"timeout",                     CONFIG_KEY_TIMEOUT },
+    { L"shutdown_after_timeout",      CONFIG_KEY_SHUTDOWN_AFTER_TIMEOUT },
+    { L"hideui",                      CONFIG_KEY_HIDEUI },
+    { L"icons_dir",                   CONFIG_KEY_ICONS_DIR },
+    { L"set_boot_args",               CONFIG_KEY_SET_BOOT_ARGS },
+    { L"scanfor",                     CONFIG_KEY_SCANFOR },
+    { L"use_nvram",                   CONFIG_KEY_USE_NVRAM },
+    { L"uefi_deep_legacy_scan",       CONFIG_KEY_UEFI_DEEP_LEGACY_SCAN },
+    { L"disable_rescan_dxe",          CONFIG_KEY_DISABLE_RESCAN_DXE },
+    { L"ransom_drives",               CONFIG_KEY_RANSOM_DRIVES },
+    { L"scan_delay",                  CONFIG_KEY_SCAN_DELAY },
+    { L"log_level",                   CONFIG_KEY_LOG_LEVEL },
+    { L"icon_row_move",               CONFIG_KEY_ICON_ROW_MOVE },
+    { L"icon_row_tune",               CONFIG_KEY_ICON_ROW_TUNE },
+    { L"also_scan_dirs",              CONFIG_KEY_ALSO_SCAN_DIRS },
+    { L"dont_scan_dirs",              CONFIG_KEY_DONT_SCAN_DIRS },
+    { L"don't_scan_dirs",             CONFIG_KEY_DONT_SCAN_DIRS },
+    { L"dont_scan_files",             CONFIG_KEY_DONT_SCAN_FILES },
+    { L"don't_scan_files",            CONFIG_KEY_DONT_SCAN_FILES },
+    { L"dont_scan_tools",             CONFIG_KEY_DONT_SCAN_TOOLS },
+    { L"don't_scan_tools",            CONFIG_KEY_DONT_SCAN_TOOLS },
+    { L"dont_scan_firmware",          CONFIG_KEY_DONT_SCAN_FIRMWARE },
+    { L"don't_scan_firmware",         CONFIG_KEY_DONT_SCAN_FIRMWARE },
+    { L"dont_scan_volumes",           CONFIG_KEY_DONT_SCAN_VOLUMES },
+    { L"don't_scan_volumes",          CONFIG_KEY_DONT_SCAN_VOLUMES },
+    { L"windows_recovery_files",      CONFIG_KEY_WINDOWS_RECOVERY_FILES },
+    { L"scan_driver_dirs",            CONFIG_KEY_SCAN_DRIVER_DIRS },
+    { L"showtools",                   CONFIG_KEY_SHOWTOOLS },
+    { L"banner",                      CONFIG_KEY_BANNER },
+    { L"banner_scale",                CONFIG_KEY_BANNER_SCALE },
+    { L"nvram_variable_limit",        CONFIG_KEY_NVRAM_VARIABLE_LIMIT },
+    { L"small_icon_size",             CONFIG_KEY_SMALL_ICON_SIZE },
+    { L"big_icon_size",               CONFIG_KEY_BIG_ICON_SIZE },
+    { L"mouse_size",                  CONFIG_KEY_MOUSE_SIZE },
+    { L"selection_small",             CONFIG_KEY_SELECTION_SMALL },
+    { L"selection_big",               CONFIG_KEY_SELECTION_BIG },
+    { L"default_selection",           CONFIG_KEY_DEFAULT_SELECTION },
+    { L"textonly",                    CONFIG_KEY_TEXTONLY },
+    { L"textmode",                    CONFIG_KEY_TEXTMODE },
+    { L"resolution",                  CONFIG_KEY_RESOLUTION },
+    { L"screensaver",                 CONFIG_KEY_SCREENSAVER },
+    { L"use_graphics_for",            CONFIG_KEY_USE_GRAPHICS_FOR },
+    { L"font",                        CONFIG_KEY_FONT },
+    { L"scan_all_linux_kernels",      CONFIG_KEY_SCAN_ALL_LINUX_KERNELS },
+    { L"fold_linux_kernels",          CONFIG_KEY_FOLD_LINUX_KERNELS },
+    { L"extra_kernel_version_strings", CONFIG_KEY_EXTRA_KERNEL_VERSION_STRINGS },
+    { L"max_tags",                    CONFIG_KEY_MAX_TAGS },
+    { L"enable_and_lock_vmx",         CONFIG_KEY_ENABLE_AND_LOCK_VMX },
+    { L"spoof_osx_version",           CONFIG_KEY_SPOOF_OSX_VERSION },
+    { L"csr_values",                  CONFIG_KEY_CSR_VALUES },
+    { L"screen_rgb",                  CONFIG_KEY_SCREEN_RGB },
+    { L"include",                     CONFIG_KEY_INCLUDE },
+    { L"write_systemd_vars",          CONFIG_KEY_WRITE_SYSTEMD_VARS },
+    { L"unicode_collation",           CONFIG_KEY_UNICODE_COLLATION },
+    { L"enable_mouse",                CONFIG_KEY_ENABLE_MOUSE },
+    { L"enable_touch",                CONFIG_KEY_ENABLE_TOUCH },
+    { L"provide_console_gop",         CONFIG_KEY_PROVIDE_CONSOLE_GOP },
+    { L"transient_boot",              CONFIG_KEY_TRANSIENT_BOOT },
+    { L"ignore_previous_boot",        CONFIG_KEY_TRANSIENT_BOOT },
+    { L"hidden_icons_ignore",         CONFIG_KEY_HIDDEN_ICONS_IGNORE },
+    { L"ignore_hidden_icons",         CONFIG_KEY_HIDDEN_ICONS_IGNORE },
+    { L"hidden_icons_external",       CONFIG_KEY_HIDDEN_ICONS_EXTERNAL },
+    { L"external_hidden_icons",       CONFIG_KEY_HIDDEN_ICONS_EXTERNAL },
+    { L"hidden_icons_prefer",         CONFIG_KEY_HIDDEN_ICONS_PREFER },
+    { L"prefer_hidden_icons",         CONFIG_KEY_HIDDEN_ICONS_PREFER },
+    { L"renderer_text",               CONFIG_KEY_RENDERER_TEXT },
+    { L"text_renderer",               CONFIG_KEY_RENDERER_TEXT },
+    { L"pass_uga_through",            CONFIG_KEY_PASS_UGA_THROUGH },
+    { L"uga_pass_through",            CONFIG_KEY_PASS_UGA_THROUGH },
+    { L"renderer_direct_gop",         CONFIG_KEY_RENDERER_DIRECT_GOP },
+    { L"direct_gop_renderer",         CONFIG_KEY_RENDERER_DIRECT_GOP },
+    { L"force_trim",                  CONFIG_KEY_FORCE_TRIM },
+    { L"trim_force",                  CONFIG_KEY_FORCE_TRIM },
+    { L"decline_reload_gop",          CONFIG_KEY_DECLINE_RELOAD_GOP },
+    { L"decline_reloadgop",           CONFIG_KEY_DECLINE_RELOAD_GOP },
+    { L"decline_apfs_load",           CONFIG_KEY_DECLINE_APFS_LOAD },
+    { L"decline_apfsload",            CONFIG_KEY_DECLINE_APFS_LOAD },
+    { L"decline_apfs_mute",           CONFIG_KEY_DECLINE_APFS_MUTE },
+    { L"decline_apfsmute",            CONFIG_KEY_DECLINE_APFS_MUTE },
+    { L"decline_apfs_sync",           CONFIG_KEY_DECLINE_APFS_SYNC },
+    { L"decline_apfssync",            CONFIG_KEY_DECLINE_APFS_SYNC },
+    { L"decline_apple_fb",            CONFIG_KEY_DECLINE_APPLE_FB },
+    { L"decline_applefb",             CONFIG_KEY_DECLINE_APPLE_FB },
+    { L"decline_nvram_protect",       CONFIG_KEY_DECLINE_NVRAM_PROTECT },
+    { L"decline_nvramprotect",        CONFIG_KEY_DECLINE_NVRAM_PROTECT },
+    { L"decline_help_tags",           CONFIG_KEY_DECLINE_HELP_TAGS },
+    { L"decline_tags_help",           CONFIG_KEY_DECLINE_HELP_TAGS },
+    { L"decline_tagshelp",            CONFIG_KEY_DECLINE_HELP_TAGS },
+    { L"decline_help_text",           CONFIG_KEY_DECLINE_HELP_TEXT },
+    { L"decline_text_help",           CONFIG_KEY_DECLINE_HELP_TEXT },
+    { L"decline_texthelp",            CONFIG_KEY_DECLINE_HELP_TEXT },
+    { L"csr_normalise",               CONFIG_KEY_CSR_NORMALISE },
+    { L"normalise_csr",               CONFIG_KEY_CSR_NORMALISE },
+    { L"csr_dynamic",                 CONFIG_KEY_CSR_DYNAMIC },
+    { L"active_csr",                  CONFIG_KEY_CSR_DYNAMIC },
+    { L"mouse_speed",                 CONFIG_KEY_MOUSE_SPEED },
+    { L"continue_on_warning",         CONFIG_KEY_CONTINUE_ON_WARNING },
+    { L"decouple_key_f10",            CONFIG_KEY_DECOUPLE_KEY_F10 },
+    { L"disable_nvram_paniclog",      CONFIG_KEY_DISABLE_NVRAM_PANICLOG },
+    { L"disable_compat_check",        CONFIG_KEY_DISABLE_COMPAT_CHECK },
+    { L"disable_amfi",                CONFIG_KEY_DISABLE_AMFI },
+    { L"follow_symlinks",             CONFIG_KEY_FOLLOW_SYMLINKS },
+    { L"prefer_uga",                  CONFIG_KEY_PREFER_UGA },
+    { L"supply_nvme",                 CONFIG_KEY_SUPPLY_NVME },
+    { L"supply_uefi",                 CONFIG_KEY_SUPPLY_UEFI },
+    { L"nvram_protect_ex",            CONFIG_KEY_NVRAM_PROTECT_EX },
+    { L"scale_ui",                    CONFIG_KEY_SCALE_UI },
+};
+
+#define CONFIG_KEYWORD_COUNT      (sizeof (ConfigKeywords) / sizeof (ConfigKeywords[0]))
+#define CONFIG_KEYWORD_HASH_SIZE  (256)
+
+// Hash buckets hold 'index + 1' of the first keyword, and ConfigKeywordNext
+// chains keywords that share a bucket. Zero ends a chain.
+static UINT8   ConfigKeywordHash[CONFIG_KEYWORD_HASH_SIZE];
+static UINT8   ConfigKeywordNext[CONFIG_KEYWORD_COUNT];
+static BOOLEAN ConfigKeywordInit = FALSE;
+
+// FNV-1a over the characters as MyStriCmp() compares them, so keywords
+// that MyStriCmp() treats as equal always land in the same bucket.
+static
+UINTN ConfigKeywordBucket (
+    IN CHAR16 *Keyword
+) {
+    UINT32 Hash = 2166136261U;
+
+    while (*Keyword != L'\0') {
+        Hash = (Hash ^ (UINT32) (*Keyword++ & ~0x20)) * 16777619;
+    }
+
+    return (UINTN) (Hash % CONFIG_KEYWORD_HASH_SIZE);
+} // static UINTN ConfigKeywordBucket()
+
+// Returns the setting named by Keyword, or CONFIG_KEY_UNKNOWN.
+CONFIG_KEY FindConfigKey (
+    IN CHAR16 *Keyword
+) {
+    UINTN i, Bucket;
+
+    if (Keyword == NULL) {
+        // Early Return
+        return CONFIG_KEY_UNKNOWN;
+    }
+
+    if (!ConfigKeywordInit) {
+        for (i = CONFIG_KEYWORD_COUNT; i > 0; i--) {
+            Bucket = ConfigKeywordBucket (ConfigKeywords[i - 1].Keyword);
+            ConfigKeywordNext[i - 1]  = ConfigKeywordHash[Bucket];
+            ConfigKeywordHash[Bucket] = (UINT8) i;
+        }
+        ConfigKeywordInit = TRUE;
+    }
+
+    i = ConfigKeywordHash[ConfigKeywordBucket (Keyword)];
+    while (i != 0) {
+        if (MyStriCmp (ConfigKeywords[i - 1].Keyword, Keyword)) {
+            // Early Return
+            return ConfigKeywords[i - 1].Key;
+        }
+        i = ConfigKeywordNext[i - 1];
+    }
+
+    return CONFIG_KEY_UNKNOWN;
+} // CONFIG_KEY FindConfigKey()
+
+/* EOF */
@@ -0,0 +1,165 @@
+/*
+ * BootMaster/config_tokens.h
+ * Configuration file tokenizer and keyword lookup
+ *
+ * Copyright (c) 2006 Christoph Pfisterer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  * Neither the name of Christoph Pfisterer nor the names of the
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Modifications copyright (c) 2012-2021 Roderick W. Smith
+ *
+ * Modifications distributed under the terms of the GNU General Public
+ * License (GPL) version 3 (GPLv3) or (at your option) any later version.
+ *
+ */
+/*
+ * Modified for RefindPlus
+ * Copyright (c) 2020-2023 Dayo Akanji (sf.net/u/dakanji/profile)
+ * Portions Copyright (c) 2021 Joe van Tunen (joevt@shaw.ca)
+ *
+ * Modifications distributed under the preceding terms.
+ */
+
+#ifndef __CONFIG_TOKENS_H_
+#define __CONFIG_TOKENS_H_
+
+#ifdef HOST_POSIX
+#include "test/cfg_posix_base.h"
+#else
+#include "config.h"
+#endif
+
+
+#define ENCODING_ISO8859_1  (0)
+#define ENCODING_UTF8       (1)
+#define ENCODING_UTF16_LE   (2)
+
+// ReadConfig() settings, one per handler. Deprecated spellings map to the
+// same value as the current keyword.
+typedef enum {
+    CONFIG_KEY_UNKNOWN = 0,
+    CONFIG_KEY_TIMEOUT,
+    CONFIG_KEY_SHUTDOWN_AFTER_TIMEOUT,
+    CONFIG_KEY_HIDEUI,
+    CONFIG_KEY_ICONS_DIR,
+    CONFIG_KEY_SET_BOOT_ARGS,
+    CONFIG_KEY_SCANFOR,
+    CONFIG_KEY_USE_NVRAM,
+    CONFIG_KEY_UEFI_DEEP_LEGACY_SCAN,
+    CONFIG_KEY_DISABLE_RESCAN_DXE,
+    CONFIG_KEY_RANSOM_DRIVES,
+    CONFIG_KEY_SCAN_DELAY,
+    CONFIG_KEY_LOG_LEVEL,
+    CONFIG_KEY_ICON_ROW_MOVE,
+    CONFIG_KEY_ICON_ROW_TUNE,
+    CONFIG_KEY_ALSO_SCAN_DIRS,
+    CONFIG_KEY_DONT_SCAN_DIRS,
+    CONFIG_KEY_DONT_SCAN_FILES,
+    CONFIG_KEY_DONT_SCAN_TOOLS,
+    CONFIG_KEY_DONT_SCAN_FIRMWARE,
+    CONFIG_KEY_DONT_SCAN_VOLUMES,
+    CONFIG_KEY_WINDOWS_RECOVERY_FILES,
+    CONFIG_KEY_SCAN_DRIVER_DIRS,
+    CONFIG_KEY_SHOWTOOLS,
+    CONFIG_KEY_BANNER,
+    CONFIG_KEY_BANNER_SCALE,
+    CONFIG_KEY_NVRAM_VARIABLE_LIMIT,
+    CONFIG_KEY_SMALL_ICON_SIZE,
+    CONFIG_KEY_BIG_ICON_SIZE,
+    CONFIG_KEY_MOUSE_SIZE,
+    CONFIG_KEY_SELECTION_SMALL,
+    CONFIG_KEY_SELECTION_BIG,
+    CONFIG_KEY_DEFAULT_SELECTION,
+    CONFIG_KEY_TEXTONLY,
+    CONFIG_KEY_TEXTMODE,
+    CONFIG_KEY_RESOLUTION,
+    CONFIG_KEY_SCREENSAVER,
+    CONFIG_KEY_USE_GRAPHICS_FOR,
+    CONFIG_KEY_FONT,
+    CONFIG_KEY_SCAN_ALL_LINUX_KERNELS,
+    CONFIG_KEY_FOLD_LINUX_KERNELS,
+    CONFIG_KEY_EXTRA_KERNEL_VERSION_STRINGS,
+    CONFIG_KEY_MAX_TAGS,
+    CONFIG_KEY_ENABLE_AND_LOCK_VMX,
+    CONFIG_KEY_SPOOF_OSX_VERSION,
+    CONFIG_KEY_CSR_VALUES,
+    CONFIG_KEY_SCREEN_RGB,
+    CONFIG_KEY_INCLUDE,
+    CONFIG_KEY_WRITE_SYSTEMD_VARS,
+    CONFIG_KEY_UNICODE_COLLATION,
+    CONFIG_KEY_ENABLE_MOUSE,
+    CONFIG_KEY_ENABLE_TOUCH,
+    CONFIG_KEY_PROVIDE_CONSOLE_GOP,
+    CONFIG_KEY_TRANSIENT_BOOT,
+    CONFIG_KEY_HIDDEN_ICONS_IGNORE,
+    CONFIG_KEY_HIDDEN_ICONS_EXTERNAL,
+    CONFIG_KEY_HIDDEN_ICONS_PREFER,
+    CONFIG_KEY_RENDERER_TEXT,
+    CONFIG_KEY_PASS_UGA_THROUGH,
+    CONFIG_KEY_RENDERER_DIRECT_GOP,
+    CONFIG_KEY_FORCE_TRIM,
+    CONFIG_KEY_DECLINE_RELOAD_GOP,
+    CONFIG_KEY_DECLINE_APFS_LOAD,
+    CONFIG_KEY_DECLINE_APFS_MUTE,
+    CONFIG_KEY_DECLINE_APFS_SYNC,
+    CONFIG_KEY_DECLINE_APPLE_FB,
+    CONFIG_KEY_DECLINE_NVRAM_PROTECT,
+    CONFIG_KEY_DECLINE_HELP_TAGS,
+    CONFIG_KEY_DECLINE_HELP_TEXT,
+    CONFIG_KEY_CSR_NORMALISE,
+    CONFIG_KEY_CSR_DYNAMIC,
+    CONFIG_KEY_MOUSE_SPEED,
+    CONFIG_KEY_CONTINUE_ON_WARNING,
+    CONFIG_KEY_DECOUPLE_KEY_F10,
+    CONFIG_KEY_DISABLE_NVRAM_PANICLOG,
+    CONFIG_KEY_DISABLE_COMPAT_CHECK,
+    CONFIG_KEY_DISABLE_AMFI,
+    CONFIG_KEY_FOLLOW_SYMLINKS,
+    CONFIG_KEY_PREFER_UGA,
+    CONFIG_KEY_SUPPLY_NVME,
+    CONFIG_KEY_SUPPLY_UEFI,
+    CONFIG_KEY_NVRAM_PROTECT_EX,
+    CONFIG_KEY_SCALE_UI,
+} CONFIG_KEY;
+
+typedef struct {
+    CHAR16      *Keyword;
+    CONFIG_KEY   Key;
+} CONFIG_KEYWORD;
+
+CHAR16 * ReadLine (REFIT_FILE *File);
+VOID SplitTokenLine (IN OUT CHAR16 *Line, IN OUT BOOLEAN *IsQuoted, IN OUT CHAR16 ***TokenList, IN OUT UINTN *TokenCount);
+CONFIG_KEY FindConfigKey (IN CHAR16 *Keyword);
+
+#endif
+
+/* EOF */
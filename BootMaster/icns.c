@@ -171,7 +171,7 @@ EG_IMAGE * BuiltinIcon (
 
 // Load an OS icon from among the comma-delimited list provided in OSIconName.
 // Searches for icons with extensions in the ICON_EXTENSIONS list (via
-// egFindIcon()).
+// egFindIcon(), which indexes the icons directories and caches decoded icons).
 // Returns image data. On failure, returns an ugly "dummy" icon.
 EG_IMAGE * LoadOSIcon (
     IN  CHAR16  *OSIconName OPTIONAL,
@@ -227,10 +227,12 @@ EG_IMAGE * LoadOSIcon (
         ALT_LOG(1, LOG_LINE_NORMAL, L"Setting dummy image");
         #endif
 
-        Image = DummyImageEx (GlobalConfig.IconSizes[ICON_SIZE_BIG]);
+        // Early Return ... DummyImageEx keeps its image, so hand out a copy
+        return egCopyImage (DummyImageEx (GlobalConfig.IconSizes[ICON_SIZE_BIG]));
     }
 
-    return egCopyImage (Image);
+    // egFindIcon returns a copy already
+    return Image;
 } // EG_IMAGE * LoadOSIcon()
 
 EG_IMAGE * DummyImage (
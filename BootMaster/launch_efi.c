@@ -82,6 +82,24 @@
 CHAR16         *BootSelection = NULL;
 CHAR16         *ValidText     = L"Invalid Loader";
 
+#define LOADER_VERDICT_BUCKETS  (64)
+
+// Outcome of IsValidLoader() for a file, kept per volume and path until the
+// volume root handles are closed. Entries made from a directory listing also
+// hold the file's size and time stamp, which later listings must match.
+typedef struct _loader_verdict {
+    EFI_FILE                *RootDir;
+    CHAR16                  *FileName;
+    BOOLEAN                  IsValid;
+    BOOLEAN                  Found;
+    BOOLEAN                  Stamped;
+    UINT64                   FileSize;
+    EFI_TIME                 ModificationTime;
+    struct _loader_verdict  *Next;
+} LOADER_VERDICT;
+
+static LOADER_VERDICT *LoaderVerdicts[LOADER_VERDICT_BUCKETS];
+
 extern BOOLEAN  IsBoot;
 extern EFI_GUID AppleVendorOsGuid;
 
@@ -145,10 +163,101 @@ VOID WarnSecureBootError(
     MY_FREE_POOL(MsgStrE);
 } // VOID WarnSecureBootError()
 
+#if defined (EFIX64) || defined (EFI32) || defined (EFIAARCH64)
+// Hashes a volume and path, ignoring case as MyStriCmp() does, to pick a
+// LoaderVerdicts[] bucket.
+static
+UINTN LoaderVerdictBucket (
+    IN EFI_FILE *RootDir,
+    IN CHAR16   *FileName
+) {
+    UINT32 Hash = 2166136261U ^ (UINT32) ((UINTN) RootDir >> 4);
+
+    for (; *FileName; FileName++) {
+        Hash ^= (UINT32) (*FileName & ~0x20);
+        Hash *= 16777619U;
+    }
+
+    return (Hash % LOADER_VERDICT_BUCKETS);
+} // static UINTN LoaderVerdictBucket()
+
+// Reads the header of a file and decides whether it is a loader for this ARCH.
+// OpenStatus is set to the outcome of opening the file.
+static
+BOOLEAN ReadLoaderVerdict (
+    IN  EFI_FILE   *RootDir,
+    IN  CHAR16     *FileName,
+    OUT EFI_STATUS *OpenStatus
+) {
+    EFI_FILE_HANDLE FileHandle;
+    EFI_STATUS      Status;
+    CHAR8           Header[512];
+    UINTN           Size = sizeof (Header);
+
+    // The open also serves as the check that the file exists
+    Status = REFIT_CALL_5_WRAPPER(
+        RootDir->Open, RootDir,
+        &FileHandle, FileName,
+        EFI_FILE_MODE_READ, 0
+    );
+
+    *OpenStatus = Status;
+    if (EFI_ERROR(Status)) {
+        return FALSE;
+    }
+
+    Status = REFIT_CALL_3_WRAPPER(
+        FileHandle->Read, FileHandle,
+        &Size, Header
+    );
+    REFIT_CALL_1_WRAPPER(FileHandle->Close, FileHandle);
+
+    return (
+        !EFI_ERROR(Status) &&
+        Size == sizeof (Header) &&
+        (
+            (
+                (Size = *(UINT32 *) &Header[0x3c]) < 0x180  &&
+                Header[0]                    == 'M'         &&
+                Header[1]                    == 'Z'         &&
+                Header[Size]                 == 'P'         &&
+                Header[Size+1]               == 'E'         &&
+                Header[Size+2]               ==  0          &&
+                Header[Size+3]               ==  0          &&
+                *(UINT16 *) &Header[Size+4]  ==  EFI_STUB_ARCH
+            ) ||
+            (*(UINT32 *) &Header == FAT_ARCH)
+        )
+    );
+} // static BOOLEAN ReadLoaderVerdict()
+#endif
+
+// Forget all loader verdicts.
+// Called whenever volume root handles are closed, as entries are keyed on them.
+VOID FreeLoaderVerdicts (VOID) {
+    LOADER_VERDICT *Verdict;
+    UINTN           i;
+
+    for (i = 0; i < LOADER_VERDICT_BUCKETS; i++) {
+        while (LoaderVerdicts[i] != NULL) {
+            Verdict           = LoaderVerdicts[i];
+            LoaderVerdicts[i] = Verdict->Next;
+
+            MY_FREE_POOL(Verdict->FileName);
+            MY_FREE_POOL(Verdict);
+        }
+    }
+} // VOID FreeLoaderVerdicts()
+
 // Returns TRUE if this file is a valid EFI loader file, and is proper ARCH
+// FileInfo, when given, is the directory entry for the file. A verdict already
+// held for the file is then reused only while its size and time stamp match.
+// Without FileInfo, any verdict held for the file is reused, as nothing that
+// could change the file runs before the volume root handles are closed.
 BOOLEAN IsValidLoader (
-    EFI_FILE *RootDir,
-    CHAR16   *FileName
+    EFI_FILE      *RootDir,
+    CHAR16        *FileName,
+    EFI_FILE_INFO *FileInfo OPTIONAL
 ) {
 #if !defined (EFIX64) && !defined (EFI32) && !defined (EFIAARCH64)
     // DA-TAG: Investigate This
@@ -169,11 +278,10 @@ BOOLEAN IsValidLoader (
 
     return TRUE;
 #else
-    EFI_FILE_HANDLE FileHandle;
+    LOADER_VERDICT *Verdict;
     EFI_STATUS      Status;
     BOOLEAN         IsValid;
-    CHAR8           Header[512];
-    UINTN           Size = sizeof (Header);
+    UINTN           Bucket;
 
     if ((RootDir == NULL) || (FileName == NULL)) {
         // DA-TAG: Investigate This
@@ -196,38 +304,68 @@ BOOLEAN IsValidLoader (
         return TRUE;
     }
 
-    if (!FileExists (RootDir, FileName)) {
-        // DA-TAG: Set ValidText in REL for 'FALSE' outcome
-        //         Allows accurate screen message
-        ValidText = L"EFI File *NOT* Found";
-
-        #if REFIT_DEBUG > 0
-        ALT_LOG(1, LOG_THREE_STAR_MID,
-            L"%s:- '%s'",
-            ValidText,
-            FileName ? FileName : L"NULL File"
-        );
-        if (IsBoot) {
-            LOG_MSG("\n\n");
-            LOG_MSG("INFO: %s ... Aborting", ValidText);
-            LOG_MSG("\n\n");
+    Bucket = LoaderVerdictBucket (RootDir, FileName);
+    for (Verdict = LoaderVerdicts[Bucket]; Verdict != NULL; Verdict = Verdict->Next) {
+        if (Verdict->RootDir == RootDir && MyStriCmp (Verdict->FileName, FileName)) {
+            break;
         }
-        #endif
+    }
 
-        // Early return if file does not exist
-        return FALSE;
+    if (Verdict != NULL &&
+        (
+            FileInfo == NULL ||
+            (
+                Verdict->Stamped &&
+                Verdict->FileSize == FileInfo->FileSize &&
+                CompareMem (
+                    &Verdict->ModificationTime,
+                    &FileInfo->ModificationTime,
+                    sizeof (EFI_TIME)
+                ) == 0
+            )
+        )
+    ) {
+        IsValid = Verdict->IsValid;
+        Status  = (Verdict->Found) ? EFI_SUCCESS : EFI_NOT_FOUND;
     }
+    else {
+        IsValid = ReadLoaderVerdict (RootDir, FileName, &Status);
+
+        // Open errors other than a missing file may pass, so are not kept
+        if (!EFI_ERROR(Status) || Status == EFI_NOT_FOUND) {
+            if (Verdict == NULL) {
+                Verdict = AllocateZeroPool (sizeof (LOADER_VERDICT));
+                if (Verdict != NULL) {
+                    Verdict->FileName = StrDuplicate (FileName);
+                    if (Verdict->FileName == NULL) {
+                        MY_FREE_POOL(Verdict);
+                    }
+                    else {
+                        Verdict->RootDir        = RootDir;
+                        Verdict->Next           = LoaderVerdicts[Bucket];
+                        LoaderVerdicts[Bucket]  = Verdict;
+                    }
+                }
+            }
 
-    Status = REFIT_CALL_5_WRAPPER(
-        RootDir->Open, RootDir,
-        &FileHandle, FileName,
-        EFI_FILE_MODE_READ, 0
-    );
+            if (Verdict != NULL) {
+                Verdict->IsValid = IsValid;
+                Verdict->Found   = (Status != EFI_NOT_FOUND);
+                Verdict->Stamped = (FileInfo != NULL);
+                if (FileInfo != NULL) {
+                    Verdict->FileSize         = FileInfo->FileSize;
+                    Verdict->ModificationTime = FileInfo->ModificationTime;
+                }
+            }
+        }
+    } // if/else Verdict
 
     if (EFI_ERROR(Status)) {
         // DA-TAG: Set ValidText in REL for 'FALSE' outcome
         //         Allows accurate screen message
-        ValidText = L"EFI File is *NOT* Readable";
+        ValidText = (Status == EFI_NOT_FOUND)
+            ? L"EFI File *NOT* Found"
+            : L"EFI File is *NOT* Readable";
 
         #if REFIT_DEBUG > 0
         ALT_LOG(1, LOG_THREE_STAR_MID,
@@ -245,30 +383,6 @@ BOOLEAN IsValidLoader (
         return FALSE;
     }
 
-    Status = REFIT_CALL_3_WRAPPER(
-        FileHandle->Read, FileHandle,
-        &Size, Header
-    );
-    REFIT_CALL_1_WRAPPER(FileHandle->Close, FileHandle);
-
-    IsValid = (
-        !EFI_ERROR(Status) &&
-        Size == sizeof (Header) &&
-        (
-            (
-                (Size = *(UINT32 *) &Header[0x3c]) < 0x180  &&
-                Header[0]                    == 'M'         &&
-                Header[1]                    == 'Z'         &&
-                Header[Size]                 == 'P'         &&
-                Header[Size+1]               == 'E'         &&
-                Header[Size+2]               ==  0          &&
-                Header[Size+3]               ==  0          &&
-                *(UINT16 *) &Header[Size+4]  ==  EFI_STUB_ARCH
-            ) ||
-            (*(UINT32 *) &Header == FAT_ARCH)
-        )
-    );
-
     // DA-TAG: Set ValidText in REL for 'FALSE' outcome
     //         Allows accurate screen message
     ValidText = (IsValid)
@@ -379,7 +493,8 @@ EFI_STATUS StartEFIImage (
 
     MY_FREE_POOL(MsgStr);
 
-    BOOLEAN LoaderValid = IsValidLoader (Volume->RootDir, Filename);
+    // Reuses the verdict from the scan that found this loader, if any
+    BOOLEAN LoaderValid = IsValidLoader (Volume->RootDir, Filename, NULL);
 
     ReturnStatus = Status = EFI_LOAD_ERROR;  // in case the list is empty
     // Some EFIs crash if attempting to load drivers for an invalid architecture, so
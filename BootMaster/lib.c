@@ -58,6 +58,7 @@
 #include "apple.h"
 #include "scan.h"
 #include "mystrings.h"
+#include "launch_efi.h"
 
 #ifdef __MAKEWITH_GNUEFI
 #define EfiReallocatePool ReallocatePool
@@ -513,6 +514,12 @@ VOID UninitRefitLib (VOID) {
 
     UninitVolumes();
 
+    // The icon directory index refers to SelfDir
+    egFreeIconCache();
+
+    // Loader verdicts are keyed on the volume root handles just closed
+    FreeLoaderVerdicts();
+
     if (SelfDir != NULL) {
         REFIT_CALL_1_WRAPPER(SelfDir->Close, SelfDir);
         SelfDir = NULL;
@@ -2476,6 +2483,7 @@ VOID ScanVolumes (VOID) {
             &VolumesCount
         );
         FreeSyncVolumes();
+        FreeLoaderVerdicts();
         ForgetPartitionTables();
     }
 
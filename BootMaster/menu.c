@@ -51,6 +51,7 @@
 #include "screenmgt.h"
 #include "lib.h"
 #include "menu.h"
+#include "menu_tiles.h"
 #include "config.h"
 #include "libeg.h"
 #include "libegint.h"
@@ -93,6 +94,9 @@ static UINTN  TileSizes[2] = {144, 64};
 
 EG_IMAGE *SelectionImages[2] = {NULL, NULL};
 
+// First tile slot of row 1 ... Row 0 slots are its visible positions
+static UINTN MenuTileRow1 = 0;
+
 EFI_EVENT *WaitList          = NULL;
 UINT64     MainMenuLoad      = 0;
 UINTN      WaitListLength    = 0;
@@ -886,7 +890,8 @@ UINTN RunGenericMenu (
 
     BOOLEAN Rotated = FALSE;
     while (MenuExit == 0) {
-        // Update the screen
+        // Update the screen ... Collected into one frame
+        egBeginFrame();
         pdClear();
         if (State.PaintAll && (GlobalConfig.ScreensaverTime != -1)) {
             StyleFunc (Screen, &State, MENU_FUNCTION_PAINT_ALL, NULL);
@@ -897,6 +902,7 @@ UINTN RunGenericMenu (
             State.PaintSelection = FALSE;
         }
         pdDraw();
+        egEndFrame();
 
         if (WaitForRelease) {
             Status = REFIT_CALL_2_WRAPPER(gST->ConIn->ReadKeyStroke, gST->ConIn, &key);
@@ -1970,25 +1976,38 @@ VOID GraphicsMenuStyle (
 // Graphical main menu style
 //
 
+// Tile slot of the entry at Index, given the current scroll position
+static
+UINTN MenuTileSlot (
+    IN SCROLL_STATE *State,
+    IN UINTN         Index,
+    IN UINTN         Row
+) {
+    if (Row == 0) {
+        return Index - State->FirstVisible;
+    }
+
+    return MenuTileRow1 + (Index - State->InitialRow1);
+} // static UINTN MenuTileSlot()
+
 static
 VOID DrawMainMenuEntry (
     REFIT_MENU_ENTRY *Entry,
+    UINTN             Slot,
     BOOLEAN           selected,
     UINTN             XPos,
     UINTN             YPos
 ) {
-    EG_IMAGE *Background;
-
-    // Do not draw selection image when not hoverin if using pointer
-    if (!selected || !DrawSelection) {
-        // Image not selected ... copy background
-        egDrawImageWithTransparency (
-            Entry->Image,
-            Entry->BadgeImage,
-            XPos, YPos,
-            SelectionImages[Entry->Row]->Width,
-            SelectionImages[Entry->Row]->Height
-        );
+    UINTN      TileState;
+    EG_IMAGE  *Background;
+    EG_IMAGE  *Composed;
+
+    // Do not draw selection image when not hovering if using pointer
+    TileState = (selected && DrawSelection) ? 1 : 0;
+
+    Composed = MenuTileFind (Slot, Entry, XPos, YPos, TileState);
+    if (Composed != NULL) {
+        BltImage (Composed, XPos, YPos);
 
         // Early Return
         return;
@@ -2000,23 +2019,33 @@ VOID DrawMainMenuEntry (
         SelectionImages[Entry->Row]->Width,
         SelectionImages[Entry->Row]->Height
     );
+    if (Background == NULL) {
+        // Early Return
+        return;
+    }
 
-    if (Background) {
+    if (TileState == 1) {
         egComposeImage (
             Background,
             SelectionImages[Entry->Row],
             0, 0
         );
+    }
 
-        BltImageCompositeBadge (
-            Background,
-            Entry->Image,
-            Entry->BadgeImage,
-            XPos, YPos
-        );
+    Composed = ComposeImageBadge (
+        Background,
+        Entry->Image,
+        Entry->BadgeImage
+    );
+    MY_FREE_IMAGE(Background);
 
-        MY_FREE_IMAGE(Background);
+    if (Composed == NULL) {
+        // Early Return
+        return;
     }
+
+    BltImage (Composed, XPos, YPos);
+    MenuTileStore (Slot, TileState, Composed);
 } // VOID DrawMainMenuEntry()
 
 static
@@ -2038,7 +2067,7 @@ VOID PaintAll (
         if (Screen->Entries[i]->Row == 0) {
             if (i <= State->LastVisible) {
                 DrawMainMenuEntry (
-                    Screen->Entries[i],
+                    Screen->Entries[i], MenuTileSlot (State, i, 0),
                     (i == State->CurrentSelection) ? TRUE : FALSE,
                     itemPosX[i - State->FirstVisible],
                     row0PosY
@@ -2047,7 +2076,7 @@ VOID PaintAll (
         }
         else {
             DrawMainMenuEntry (
-                Screen->Entries[i],
+                Screen->Entries[i], MenuTileSlot (State, i, 1),
                 (i == State->CurrentSelection) ? TRUE : FALSE,
                 itemPosX[i],
                 row1PosY
@@ -2130,6 +2159,10 @@ VOID PaintSelection (
 
     DrawMainMenuEntry (
         Screen->Entries[State->PreviousSelection],
+        MenuTileSlot (
+            State, State->PreviousSelection,
+            Screen->Entries[State->PreviousSelection]->Row
+        ),
         FALSE,
         itemPosX[XSelectPrev],
         YPosPrev
@@ -2137,6 +2170,10 @@ VOID PaintSelection (
 
     DrawMainMenuEntry (
         Screen->Entries[State->CurrentSelection],
+        MenuTileSlot (
+            State, State->CurrentSelection,
+            Screen->Entries[State->CurrentSelection]->Row
+        ),
         TRUE,
         itemPosX[XSelectCur],
         YPosCur
@@ -2385,6 +2422,10 @@ VOID MainMenuStyle (
                 }
             } // for
 
+            // One tile slot per position on screen
+            MenuTileRow1 = row0Count;
+            MenuTilesInit (row0Count + row1Count);
+
             // Initial painting
             InitSelection();
 
@@ -2399,9 +2440,12 @@ VOID MainMenuStyle (
         break;
         case MENU_FUNCTION_CLEANUP:
             MY_FREE_POOL(itemPosX);
+            MenuTilesFree();
 
         break;
         case MENU_FUNCTION_PAINT_ALL:
+            // The background may have been redrawn ... Recompose all tiles
+            MenuTilesFlush();
             PaintAll (Screen, State, itemPosX, row0PosY, row1PosY, textPosY);
             // For PaintArrows(), the starting Y position is moved to the midpoint
             // of the surrounding row; PaintIcon() adjusts this back up by half the
@@ -0,0 +1,135 @@
+/*
+ * BootMaster/menu_tiles.c
+ * Composed main menu tile cache
+ *
+ * Copyright (c) 2006 Christoph Pfisterer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  * Neither the name of Christoph Pfisterer nor the names of the
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Modifications copyright (c) 2012-2020 Roderick W. Smith
+ *
+ * Modifications distributed under the terms of the GNU General Public
+ * License (GPL) version 3 (GPLv3), or (at your option) any later version.
+ */
+/*
+ * Modified for RefindPlus
+ * Copyright (c) 2020-2023 Dayo Akanji (sf.net/u/dakanji/profile)
+ * Portions Copyright (c) 2021 Joe van Tunen (joevt@shaw.ca)
+ *
+ * Modifications distributed under the preceding terms.
+ */
+
+#include "menu_tiles.h"
+
+static MENU_TILE *MenuTiles     = NULL;
+static UINTN      MenuTileCount = 0;
+
+// Sets up empty slots for the tile positions of a new layout
+BOOLEAN MenuTilesInit (
+    IN UINTN SlotCount
+) {
+    MenuTilesFree();
+
+    if (SlotCount == 0) {
+        // Early Return
+        return FALSE;
+    }
+
+    MenuTiles     = AllocateZeroPool (sizeof (MENU_TILE) * SlotCount);
+    MenuTileCount = (MenuTiles != NULL) ? SlotCount : 0;
+
+    return (MenuTiles != NULL);
+} // BOOLEAN MenuTilesInit()
+
+// Drops all composed tiles but keeps the slots
+VOID MenuTilesFlush (VOID) {
+    UINTN i;
+
+    for (i = 0; i < MenuTileCount; i++) {
+        MY_FREE_IMAGE(MenuTiles[i].Image[0]);
+        MY_FREE_IMAGE(MenuTiles[i].Image[1]);
+        MenuTiles[i].Entry = NULL;
+    }
+} // VOID MenuTilesFlush()
+
+VOID MenuTilesFree (VOID) {
+    MenuTilesFlush();
+    MY_FREE_POOL(MenuTiles);
+    MenuTileCount = 0;
+} // VOID MenuTilesFree()
+
+// Returns the tile cached for Entry at XPos/YPos in Slot, or NULL.
+// A slot that held another entry, or the entry elsewhere, is emptied and
+// handed to Entry, ready for MenuTileStore().
+EG_IMAGE * MenuTileFind (
+    IN UINTN  Slot,
+    IN VOID  *Entry,
+    IN UINTN  XPos,
+    IN UINTN  YPos,
+    IN UINTN  TileState
+) {
+    MENU_TILE *Tile;
+
+    if (Slot >= MenuTileCount) {
+        // Early Return
+        return NULL;
+    }
+
+    Tile = &MenuTiles[Slot];
+    if (Tile->Entry != Entry || Tile->XPos != XPos || Tile->YPos != YPos) {
+        // Row has scrolled ... Drop stale tiles
+        MY_FREE_IMAGE(Tile->Image[0]);
+        MY_FREE_IMAGE(Tile->Image[1]);
+        Tile->Entry = Entry;
+        Tile->XPos  = XPos;
+        Tile->YPos  = YPos;
+    }
+
+    return Tile->Image[TileState];
+} // EG_IMAGE * MenuTileFind()
+
+// Takes over Image as the tile for the entry last found in Slot.
+// Image is freed if there is no such slot.
+VOID MenuTileStore (
+    IN UINTN     Slot,
+    IN UINTN     TileState,
+    IN EG_IMAGE *Image
+) {
+    if (Slot >= MenuTileCount || MenuTiles[Slot].Entry == NULL) {
+        MY_FREE_IMAGE(Image);
+
+        // Early Return
+        return;
+    }
+
+    MY_FREE_IMAGE(MenuTiles[Slot].Image[TileState]);
+    MenuTiles[Slot].Image[TileState] = Image;
+} // VOID MenuTileStore()
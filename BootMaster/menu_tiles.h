@@ -0,0 +1,89 @@
+/*
+ * BootMaster/menu_tiles.h
+ * Composed main menu tile cache
+ *
+ * Copyright (c) 2006 Christoph Pfisterer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  * Neither the name of Christoph Pfisterer nor the names of the
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Modifications copyright (c) 2012-2020 Roderick W. Smith
+ *
+ * Modifications distributed under the terms of the GNU General Public
+ * License (GPL) version 3 (GPLv3), or (at your option) any later version.
+ */
+/*
+ * Modified for RefindPlus
+ * Copyright (c) 2020-2023 Dayo Akanji (sf.net/u/dakanji/profile)
+ * Portions Copyright (c) 2021 Joe van Tunen (joevt@shaw.ca)
+ *
+ * Modifications distributed under the preceding terms.
+ */
+
+#ifndef __MENU_TILES_H_
+#define __MENU_TILES_H_
+
+#ifdef HOST_POSIX
+#include "../libeg/test/eg_posix_base.h"
+#else
+#include "global.h"
+#include "lib.h"
+#endif
+
+// Composed main menu tiles, one slot per tile position on screen.
+// Background, selection image, icon and badge under an entry do not change
+// while it stays put, so both states are built once and then just blitted.
+// A slot is handed to another entry when the row scrolls, so no more than
+// two tiles per position on screen are ever held.
+typedef struct {
+    EG_IMAGE  *Image[2];     // Unselected ... Selected
+    VOID      *Entry;
+    UINTN      XPos;
+    UINTN      YPos;
+} MENU_TILE;
+
+BOOLEAN MenuTilesInit (IN UINTN SlotCount);
+VOID MenuTilesFlush (VOID);
+VOID MenuTilesFree (VOID);
+EG_IMAGE * MenuTileFind (
+    IN UINTN  Slot,
+    IN VOID  *Entry,
+    IN UINTN  XPos,
+    IN UINTN  YPos,
+    IN UINTN  TileState
+);
+VOID MenuTileStore (
+    IN UINTN     Slot,
+    IN UINTN     TileState,
+    IN EG_IMAGE *Image
+);
+
+#endif
+
@@ -1924,7 +1924,7 @@ BOOLEAN ScanLoaderDir (
                 FilenameIn (Volume, Path, DirEntry->FileName, SHELL_NAMES)                ||
                 HasSignedCounterpart (Volume, FullName)                                   ||
                 FilenameIn (Volume, Path, DirEntry->FileName, GlobalConfig.DontScanFiles) ||
-                !IsValidLoader (Volume->RootDir, FullName)
+                !IsValidLoader (Volume->RootDir, FullName, DirEntry)
             ) {
                 //BREAD_CRUMB(L"%s:  2a 2a 6a 1 - WHILE LOOP:- CONTINUE (Skipping This ... Invalid Item:- '%s')", FuncTag,
                 //    DirEntry->FileName
@@ -2105,10 +2105,9 @@ VOID ScanNetboot (VOID) {
     ALT_LOG(1, LOG_LINE_NORMAL, L"Scanning for iPXE boot options");
     #endif
 
-    if (FileExists (SelfVolume->RootDir, IPXE_NAME) &&
-        FileExists (SelfVolume->RootDir, IPXE_DISCOVER_NAME) &&
-        IsValidLoader (SelfVolume->RootDir, IPXE_DISCOVER_NAME) &&
-        IsValidLoader (SelfVolume->RootDir, IPXE_NAME)
+    // IsValidLoader() also checks the files exist
+    if (IsValidLoader (SelfVolume->RootDir, IPXE_DISCOVER_NAME, NULL) &&
+        IsValidLoader (SelfVolume->RootDir, IPXE_NAME, NULL)
     ) {
         Location = RuniPXEDiscover (SelfVolume->DeviceHandle);
         if (Location != NULL && FileExists (SelfVolume->RootDir, iPXEFileName)) {
@@ -3340,8 +3339,9 @@ BOOLEAN IsValidTool (
     CHAR16  *DontScanTools = NULL;
     BOOLEAN  retval = TRUE;
 
-    if (!FileExists (BaseVolume->RootDir, PathName)) {
-        // Early return ... File does not exist
+    // Also the check that the file exists ... Logs the outcome
+    if (!IsValidLoader (BaseVolume->RootDir, PathName, NULL)) {
+        // Early return ... File does not exist or is not a valid loader
         return FALSE;
     }
 
@@ -3361,37 +3361,23 @@ BOOLEAN IsValidTool (
         MergeStrings (&DontScanTools, GlobalConfig.DontScanTools, L',');
     }
 
-    #if REFIT_DEBUG > 0
-    ALT_LOG(1, LOG_LINE_NORMAL,
-        L"Check File is Valid:- '%s'",
-        PathName
-    );
-    #endif
-
-    if (!FileExists (BaseVolume->RootDir, PathName) ||
-        !IsValidLoader (BaseVolume->RootDir, PathName)
-    ) {
-        retval = FALSE;
-    }
-    else {
-        SplitPathName (PathName, &TestVolName, &TestPathName, &TestFileName);
+    SplitPathName (PathName, &TestVolName, &TestPathName, &TestFileName);
 
-        while (retval && (DontScanThis = FindCommaDelimited (DontScanTools, i++))) {
-            SplitPathName (DontScanThis, &DontVolName, &DontPathName, &DontFileName);
+    while (retval && (DontScanThis = FindCommaDelimited (DontScanTools, i++))) {
+        SplitPathName (DontScanThis, &DontVolName, &DontPathName, &DontFileName);
 
-            if (MyStriCmp (TestFileName, DontFileName) &&
-                ((DontPathName == NULL) || (MyStriCmp (TestPathName, DontPathName))) &&
-                ((DontVolName == NULL) || (VolumeMatchesDescription (BaseVolume, DontVolName)))
-            ) {
-                retval = FALSE;
-            }
+        if (MyStriCmp (TestFileName, DontFileName) &&
+            ((DontPathName == NULL) || (MyStriCmp (TestPathName, DontPathName))) &&
+            ((DontVolName == NULL) || (VolumeMatchesDescription (BaseVolume, DontVolName)))
+        ) {
+            retval = FALSE;
+        }
 
-            MY_FREE_POOL(DontVolName);
-            MY_FREE_POOL(DontScanThis);
-            MY_FREE_POOL(DontPathName);
-            MY_FREE_POOL(DontFileName);
-        } // while
-    }
+        MY_FREE_POOL(DontVolName);
+        MY_FREE_POOL(DontScanThis);
+        MY_FREE_POOL(DontPathName);
+        MY_FREE_POOL(DontFileName);
+    } // while
 
     MY_FREE_POOL(TestVolName);
     MY_FREE_POOL(TestPathName);
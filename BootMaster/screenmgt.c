@@ -1758,12 +1758,13 @@ VOID BltImageAlpha (
 //    GraphicsScreenDirty = TRUE;
 //} // VOID BltImageComposite()
 
-VOID BltImageCompositeBadge (
+// Returns a copy of BaseImage with TopImage centred on it and BadgeImage
+// placed in the lower right corner of TopImage. Returns NULL if BaseImage
+// is NULL or the copy could not be made.
+EG_IMAGE * ComposeImageBadge (
     IN EG_IMAGE *BaseImage,
     IN EG_IMAGE *TopImage,
-    IN EG_IMAGE *BadgeImage,
-    IN UINTN     XPos,
-    IN UINTN     YPos
+    IN EG_IMAGE *BadgeImage
 ) {
     UINTN     TotalWidth  = 0;
     UINTN     TotalHeight = 0;
@@ -1809,6 +1810,20 @@ VOID BltImageCompositeBadge (
         egComposeImage (CompImage, BadgeImage, OffsetX, OffsetY);
     }
 
+    return CompImage;
+} // EG_IMAGE * ComposeImageBadge()
+
+VOID BltImageCompositeBadge (
+    IN EG_IMAGE *BaseImage,
+    IN EG_IMAGE *TopImage,
+    IN EG_IMAGE *BadgeImage,
+    IN UINTN     XPos,
+    IN UINTN     YPos
+) {
+    EG_IMAGE *CompImage;
+
+    CompImage = ComposeImageBadge (BaseImage, TopImage, BadgeImage);
+
     // blit to screen and clean up
     if (CompImage != NULL) {
         if (CompImage->HasAlpha) {
@@ -107,6 +107,12 @@ UINTN GetLumIndex (
     UINTN PixelB
 );
 
+EG_IMAGE * ComposeImageBadge (
+    IN EG_IMAGE *BaseImage,
+    IN EG_IMAGE *TopImage,
+    IN EG_IMAGE *BadgeImage
+);
+
 VOID InitScreen (VOID);
 VOID SetupScreen (VOID);
 VOID PauseForKey (VOID);
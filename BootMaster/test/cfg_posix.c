@@ -0,0 +1,89 @@
+/**
+ * \file cfg_posix.c
+ * List and string functions used by the config parser, for the POSIX user
+ * space environment. They behave as their namesakes in BootMaster/lib.c,
+ * BootMaster/mystrings.c and the EDK2 base library.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cfg_posix_base.h"
+
+
+VOID AddListElement (
+    IN OUT VOID ***ListPtr,
+    IN OUT UINTN   *ElementCount,
+    IN     VOID    *NewElement
+) {
+    VOID **NewList;
+
+    // Grows in steps of 16 elements, as lib.c does
+    if (*ListPtr == NULL || (*ElementCount & 15) == 0) {
+        NewList = realloc ((*ElementCount == 0) ? NULL : *ListPtr, sizeof (VOID *) * (*ElementCount + 16));
+        if (NewList == NULL) {
+            return;
+        }
+        *ListPtr = NewList;
+    }
+
+    (*ListPtr)[*ElementCount] = NewElement;
+    (*ElementCount)++;
+}
+
+BOOLEAN MyStriCmp (
+    IN const CHAR16 *FirstString,
+    IN const CHAR16 *SecondString
+) {
+    if (!FirstString || !SecondString) {
+        return FALSE;
+    }
+
+    while ((*FirstString != L'\0') &&
+        ((*FirstString & ~0x20) == (*SecondString & ~0x20))
+    ) {
+        FirstString++;
+        SecondString++;
+    }
+
+    return (*FirstString == *SecondString);
+}
+
+UINTN StrLen (
+    IN const CHAR16 *String
+) {
+    UINTN Length = 0;
+
+    while (String[Length] != 0) {
+        Length++;
+    }
+
+    return Length;
+}
+
+CHAR16 * StrDuplicate (
+    IN const CHAR16 *String
+) {
+    CHAR16 *Copy;
+    UINTN   Size = (StrLen (String) + 1) * sizeof (CHAR16);
+
+    Copy = malloc (Size);
+    if (Copy != NULL) {
+        memcpy (Copy, String, Size);
+    }
+
+    return Copy;
+}
+
+VOID StrCpy (
+    OUT CHAR16       *Destination,
+    IN  const CHAR16 *Source
+) {
+    memmove (Destination, Source, (StrLen (Source) + 1) * sizeof (CHAR16));
+}
+
+// EOF
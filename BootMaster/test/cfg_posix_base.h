@@ -0,0 +1,68 @@
+/**
+ * \file cfg_posix_base.h
+ * Base definitions for building the config parser in the POSIX user space
+ * environment.
+ *
+ * BootMaster/config_tokens.h includes this file instead of config.h when it
+ * is built with HOST_POSIX. It provides the EFI types, the REFIT_FILE
+ * structure and the list and string functions that the tokenizer and the
+ * keyword lookup use. Build with -fshort-wchar, as EFI builds are, so that
+ * L"" strings are CHAR16 strings.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CFG_POSIX_BASE_H_
+#define _CFG_POSIX_BASE_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define IN
+#define OUT
+#define TRUE                    (1)
+#define FALSE                   (0)
+
+typedef void                    VOID;
+typedef char                    CHAR8;
+typedef uint16_t                CHAR16;
+typedef uint8_t                 UINT8;
+typedef uint32_t                UINT32;
+typedef uintptr_t               UINTN;
+typedef unsigned char           BOOLEAN;
+
+typedef struct {
+    UINT8   *Buffer;
+    UINTN   BufferSize;
+    UINTN   Encoding;
+    CHAR8   *Current8Ptr;
+    CHAR8   *End8Ptr;
+    CHAR16  *Current16Ptr;
+    CHAR16  *End16Ptr;
+} REFIT_FILE;
+
+#define AllocatePool(Size)                  malloc (Size)
+
+#define MY_FREE_POOL(Pointer)               \
+    do {                                    \
+        free (Pointer);                     \
+        Pointer = NULL;                     \
+    } while (0)
+
+// Provided by cfg_posix.c
+VOID AddListElement (IN OUT VOID ***ListPtr, IN OUT UINTN *ElementCount, IN VOID *NewElement);
+BOOLEAN MyStriCmp (IN const CHAR16 *String1, IN const CHAR16 *String2);
+CHAR16 * StrDuplicate (IN const CHAR16 *String);
+VOID StrCpy (OUT CHAR16 *Destination, IN const CHAR16 *Source);
+UINTN StrLen (IN const CHAR16 *String);
+
+#endif
+
+// EOF
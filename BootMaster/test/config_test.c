@@ -0,0 +1,556 @@
+/**
+ * \file config_test.c
+ * Config parser conformance test and benchmark for the POSIX user space
+ * environment.
+ *
+ * Tokenizes config files with ReadLine() and SplitTokenLine() from
+ * BootMaster/config_tokens.c, as ReadTokenLineInPlace() does, and checks
+ * every token against the tokenizer that config.c had before, which copied
+ * each line and each token. Then does the same on random short lines made
+ * of the characters the tokenizer treats specially. Checks that every
+ * setting in the files, commented out or not, is found by FindConfigKey()
+ * in any case, and that every keyword in its table is. Finally times both
+ * tokenizers and the keyword lookup against a linear search.
+ * Usage: config_test [-q] config.conf ...; -q skips the timings.
+ * Exits with 1 if any check fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Included rather than linked, to reach the keyword table
+#include "../config_tokens.c"
+
+#include <stdio.h>
+#include <time.h>
+
+
+#define BENCH_RUNS  (2000)
+#define FUZZ_LINES  (200000)
+
+//
+// Reference tokenizer: ReadLine(), KeepReading() and ReadTokenLine() as
+// config.c had them before tokenizing in place, for 8-bit files.
+//
+
+static
+CHAR16 * RefReadLine (
+    REFIT_FILE *File
+) {
+    CHAR8   *p, *LineStart, *LineEnd;
+    CHAR16  *Line, *q;
+
+    p = File->Current8Ptr;
+    if (p >= File->End8Ptr) {
+        return NULL;
+    }
+
+    LineStart = p;
+    for (; p < File->End8Ptr; p++) {
+        if (*p == 13 || *p == 10) {
+            break;
+        }
+    }
+    LineEnd = p;
+    for (; p < File->End8Ptr; p++) {
+        if (*p != 13 && *p != 10) {
+            break;
+        }
+    }
+    File->Current8Ptr = p;
+
+    Line = AllocatePool (sizeof (CHAR16) * ((UINTN) (LineEnd - LineStart) + 1));
+    if (Line == NULL) {
+        return NULL;
+    }
+
+    for (p = LineStart, q = Line; p < LineEnd; ) {
+        *q++ = (UINT8) *p++;
+    }
+    *q = 0;
+
+    return Line;
+}
+
+static
+BOOLEAN RefKeepReading (
+    IN OUT CHAR16  *p,
+    IN OUT BOOLEAN *IsQuoted
+) {
+    BOOLEAN  MoreToRead = FALSE;
+    CHAR16  *Temp       = NULL;
+
+    if (*p == L'\0') {
+        return FALSE;
+    }
+
+    if ((
+        *p != ' '  &&
+        *p != '\t' &&
+        *p != '='  &&
+        *p != '#'  &&
+        *p != ','
+    ) || *IsQuoted) {
+        MoreToRead = TRUE;
+    }
+
+    if (*p == L'"') {
+        if (p[1] != L'"') {
+            *IsQuoted  = !(*IsQuoted);
+            MoreToRead = FALSE;
+        }
+        else {
+            Temp = StrDuplicate (&p[1]);
+            if (Temp != NULL) {
+                StrCpy (p, Temp);
+                MY_FREE_POOL(Temp);
+            }
+            MoreToRead = TRUE;
+        }
+    }
+
+    return MoreToRead;
+}
+
+static
+UINTN RefReadTokenLine (
+    IN  REFIT_FILE   *File,
+    OUT CHAR16     ***TokenList
+) {
+    BOOLEAN  LineFinished, IsQuoted = FALSE;
+    CHAR16  *Line, *Token, *p;
+    UINTN    TokenCount = 0;
+
+    *TokenList = NULL;
+
+    while (TokenCount == 0) {
+        Line = RefReadLine (File);
+        if (Line == NULL) {
+            return 0;
+        }
+
+        p = Line;
+        LineFinished = FALSE;
+        while (!LineFinished) {
+            while (!IsQuoted && (*p == ' ' || *p == '\t' || *p == '=' || *p == ',')) {
+                p++;
+            }
+
+            if (*p == 0 || *p == '#') {
+                break;
+            }
+
+            if (*p == '"') {
+               IsQuoted = !IsQuoted;
+               p++;
+            }
+
+            Token = p;
+
+            while (RefKeepReading (p, &IsQuoted)) {
+               if ((*p == L'/') && !IsQuoted) {
+                   *p = L'\\';
+               }
+               p++;
+            }
+
+            if (*p == L'\0' || *p == L'#') {
+                LineFinished = TRUE;
+            }
+            *p++ = 0;
+
+            AddListElement ((VOID ***) TokenList, &TokenCount, (VOID *) StrDuplicate (Token));
+        }
+
+        MY_FREE_POOL(Line);
+    }
+
+    return TokenCount;
+}
+
+static void ref_free_tokens(CHAR16 **tokens, UINTN count)
+{
+    UINTN       i;
+
+    for (i = 0; i < count; i++)
+        free(tokens[i]);
+    free(tokens);
+}
+
+//
+// Tokenizer under test, used as ReadTokenLineInPlace() uses it
+//
+
+/**
+ * Sets up an 8-bit file for the reference tokenizer.
+ */
+static void open_ref_file(REFIT_FILE *file, const char *data, size_t size)
+{
+    memset(file, 0, sizeof(*file));
+    file->Buffer      = malloc(size + 1);
+    memcpy(file->Buffer, data, size);
+    file->BufferSize  = size;
+    file->Encoding    = ENCODING_ISO8859_1;
+    file->Current8Ptr = (CHAR8 *) file->Buffer;
+    file->End8Ptr     = (CHAR8 *) file->Buffer + size;
+}
+
+/**
+ * Sets up a file as RefitReadFile() leaves it: widened to CHAR16, with room
+ * for the final terminator.
+ */
+static void open_file(REFIT_FILE *file, const char *data, size_t size)
+{
+    CHAR16     *text;
+    size_t      i;
+
+    memset(file, 0, sizeof(*file));
+    text = malloc((size + 1) * sizeof(CHAR16));
+    for (i = 0; i < size; i++)
+        text[i] = (UINT8) data[i];
+    text[size] = 0;
+    file->Buffer       = (UINT8 *) text;
+    file->BufferSize   = size * sizeof(CHAR16);
+    file->Encoding     = ENCODING_UTF16_LE;
+    file->Current16Ptr = text;
+    file->End16Ptr     = text + size;
+}
+
+static UINTN read_token_line(REFIT_FILE *file, CHAR16 ***tokens)
+{
+    BOOLEAN     quoted = FALSE;
+    CHAR16     *line;
+    UINTN       count = 0;
+
+    *tokens = NULL;
+    while (count == 0) {
+        line = ReadLine(file);
+        if (line == NULL)
+            return 0;
+        SplitTokenLine(line, &quoted, tokens, &count);
+    }
+
+    return count;
+}
+
+static void print_str(const CHAR16 *s)
+{
+    while (*s)
+        putchar(*s < 128 ? *s : '?'), s++;
+}
+
+/**
+ * Tokenizes data with both tokenizers and compares every line.
+ * Returns the number of lines that differ.
+ */
+static int compare_tokens(const char *data, size_t size, int verbose)
+{
+    REFIT_FILE  ref_file, file;
+    CHAR16    **ref_tokens, **tokens;
+    UINTN       ref_count, count, i;
+    int         bad = 0, line = 0;
+
+    open_ref_file(&ref_file, data, size);
+    open_file(&file, data, size);
+
+    do {
+        ref_count = RefReadTokenLine(&ref_file, &ref_tokens);
+        count     = read_token_line(&file, &tokens);
+        line++;
+
+        if (ref_count != count) {
+            bad++;
+            if (verbose)
+                printf("  token line %d: %lu tokens, expected %lu\n",
+                       line, (unsigned long) count, (unsigned long) ref_count);
+        } else {
+            for (i = 0; i < count; i++) {
+                if (StrLen(tokens[i]) != StrLen(ref_tokens[i]) ||
+                    memcmp(tokens[i], ref_tokens[i], StrLen(tokens[i]) * sizeof(CHAR16)) != 0) {
+                    bad++;
+                    if (verbose) {
+                        printf("  token line %d: [", line);
+                        print_str(tokens[i]);
+                        printf("], expected [");
+                        print_str(ref_tokens[i]);
+                        printf("]\n");
+                    }
+                    break;
+                }
+            }
+        }
+
+        ref_free_tokens(ref_tokens, ref_count);
+        free(tokens);
+    } while (ref_count != 0 && count != 0);
+
+    free(ref_file.Buffer);
+    free(file.Buffer);
+    return bad;
+}
+
+/**
+ * Checks that the first token of every setting line resolves, with the
+ * comment marker of commented out settings removed. Prose comments start
+ * with "# " and are skipped, as are stanzas and the esp_filter settings,
+ * which ReadConfig() matches by substring.
+ */
+static int check_settings(const char *data, size_t size, int *found)
+{
+    REFIT_FILE  file;
+    CHAR16    **tokens;
+    CHAR16     *line, *p;
+    BOOLEAN     quoted;
+    UINTN       count;
+    int         bad = 0, depth = 0;
+
+    open_file(&file, data, size);
+    *found = 0;
+
+    while ((line = ReadLine(&file)) != NULL) {
+        p = line;
+        if (*p == L'#')
+            p++;
+        if (*p < L'a' || *p > L'z')
+            continue;
+
+        tokens = NULL;
+        count  = 0;
+        quoted = FALSE;
+        SplitTokenLine(p, &quoted, &tokens, &count);
+        if (count == 0) {
+            free(tokens);
+            continue;
+        }
+
+        if (MyStriCmp(tokens[0], L"menuentry") || MyStriCmp(tokens[0], L"submenuentry")) {
+            depth++;
+        } else if (depth > 0) {
+            if (MyStriCmp(tokens[0], L"}"))
+                depth--;
+        } else if (MyStriCmp(tokens[0], L"enable_esp_filter") ||
+                   MyStriCmp(tokens[0], L"disable_esp_filter")) {
+            // Handled outside the keyword table
+        } else if (FindConfigKey(tokens[0]) == CONFIG_KEY_UNKNOWN) {
+            printf("  unknown setting [");
+            print_str(tokens[0]);
+            printf("]\n");
+            bad++;
+        } else {
+            (*found)++;
+        }
+
+        free(tokens);
+    }
+
+    free(file.Buffer);
+    return bad;
+}
+
+static char *read_file(const char *path, size_t *size)
+{
+    FILE       *f;
+    char       *data;
+    long        len;
+
+    f = fopen(path, "rb");
+    if (f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+    data = malloc(len + 1);
+    if (data == NULL || fread(data, 1, len, f) != (size_t) len) {
+        fclose(f);
+        free(data);
+        return NULL;
+    }
+    fclose(f);
+
+    *size = len;
+    return data;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * Times whole-file tokenizing with both tokenizers, and looking up every
+ * line's first token with FindConfigKey() and with the linear MyStriCmp()
+ * search over the same table that ReadConfig() did before.
+ */
+static void bench_file(const char *path, const char *data, size_t size)
+{
+    REFIT_FILE  file;
+    CHAR16    **tokens;
+    UINTN       count, i, j;
+    CHAR16    **keys = NULL;
+    UINTN       key_count = 0;
+    volatile UINTN sink = 0;
+    double      t0, t1, t2, t3, t4;
+    int         k;
+
+    t0 = now_ms();
+    for (k = 0; k < BENCH_RUNS; k++) {
+        open_ref_file(&file, data, size);
+        while ((count = RefReadTokenLine(&file, &tokens)) != 0)
+            ref_free_tokens(tokens, count);
+        free(file.Buffer);
+    }
+    t1 = now_ms();
+    for (k = 0; k < BENCH_RUNS; k++) {
+        open_file(&file, data, size);
+        while ((count = read_token_line(&file, &tokens)) != 0)
+            free(tokens);
+        free(file.Buffer);
+    }
+    t2 = now_ms();
+
+    // First tokens of all lines, including commented out settings
+    open_file(&file, data, size);
+    while ((count = read_token_line(&file, &tokens)) != 0) {
+        AddListElement((VOID ***) &keys, &key_count, tokens[0]);
+        free(tokens);
+    }
+
+    t3 = now_ms();
+    for (k = 0; k < BENCH_RUNS; k++) {
+        for (i = 0; i < key_count; i++)
+            sink += FindConfigKey(keys[i]);
+    }
+    t4 = now_ms();
+    for (k = 0; k < BENCH_RUNS; k++) {
+        for (i = 0; i < key_count; i++) {
+            for (j = 0; j < CONFIG_KEYWORD_COUNT; j++) {
+                if (MyStriCmp(keys[i], ConfigKeywords[j].Keyword)) {
+                    sink += j;
+                    break;
+                }
+            }
+        }
+    }
+    printf("%s: tokenize old %.3f ms new %.3f ms, %lu lookups hashed %.3f ms linear %.3f ms\n",
+           path, (t1 - t0) / BENCH_RUNS, (t2 - t1) / BENCH_RUNS, (unsigned long) key_count,
+           (t4 - t3) / BENCH_RUNS, (now_ms() - t4) / BENCH_RUNS);
+
+    free(keys);
+    free(file.Buffer);
+}
+
+/**
+ * Checks that every keyword in the table resolves to its own setting in
+ * lower and upper case, and that near misses do not resolve.
+ */
+static int check_keywords(void)
+{
+    static CHAR16 *misses[] = { L"", L"nosuchkey", L"timeou", L"timeoutx", L"_timeout", L"time out" };
+    CHAR16      upper[64];
+    CHAR16     *keyword;
+    UINTN       i, j;
+    int         bad = 0;
+
+    for (i = 0; i < CONFIG_KEYWORD_COUNT; i++) {
+        keyword = ConfigKeywords[i].Keyword;
+        for (j = 0; j <= StrLen(keyword) && j < 64; j++)
+            upper[j] = (keyword[j] >= L'a' && keyword[j] <= L'z') ? keyword[j] - 32 : keyword[j];
+
+        if (FindConfigKey(keyword) != ConfigKeywords[i].Key || FindConfigKey(upper) != ConfigKeywords[i].Key) {
+            printf("  keyword [");
+            print_str(keyword);
+            printf("] not found\n");
+            bad++;
+        }
+    }
+    for (i = 0; i < sizeof(misses) / sizeof(misses[0]); i++) {
+        if (FindConfigKey(misses[i]) != CONFIG_KEY_UNKNOWN) {
+            printf("  [");
+            print_str(misses[i]);
+            printf("] found\n");
+            bad++;
+        }
+    }
+    if (FindConfigKey(NULL) != CONFIG_KEY_UNKNOWN)
+        bad++;
+
+    printf("keyword table: %lu keywords, %d failures\n", (unsigned long) CONFIG_KEYWORD_COUNT, bad);
+    return bad;
+}
+
+/**
+ * Compares both tokenizers on random short lines of separators, quotes,
+ * comment markers, slashes and line breaks.
+ */
+static int check_fuzz(void)
+{
+    static const char chars[] = "ab \t=#,\"/\\\r\n x";
+    char        line[40];
+    int         i, j, n, bad = 0;
+
+    srand(7);
+    for (i = 0; i < FUZZ_LINES; i++) {
+        n = rand() % (int) sizeof(line);
+        for (j = 0; j < n; j++)
+            line[j] = chars[rand() % (sizeof(chars) - 1)];
+        bad += compare_tokens(line, n, bad < 5);
+    }
+
+    printf("random lines: %d lines, %d mismatches\n", FUZZ_LINES, bad);
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    char       *data;
+    size_t      size;
+    int         i, bad = 0, lines, found, quiet = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    if (argc > 1 && strcmp(argv[1], "-q") == 0) {
+        quiet = 1;
+        argc--;
+        argv++;
+    }
+    if (argc < 2) {
+        fprintf(stderr, "Usage: config_test [-q] <config.conf>...\n");
+        return 1;
+    }
+
+    for (i = 1; i < argc; i++) {
+        data = read_file(argv[i], &size);
+        if (data == NULL) {
+            fprintf(stderr, "%s: cannot read\n", argv[i]);
+            return 1;
+        }
+
+        lines = compare_tokens(data, size, 1);
+        printf("%s: %d token mismatches\n", argv[i], lines);
+        bad += lines;
+
+        lines = check_settings(data, size, &found);
+        printf("%s: %d settings found, %d unknown\n", argv[i], found, lines);
+        bad += lines;
+        if (found == 0)
+            bad++;
+
+        if (!quiet)
+            bench_file(argv[i], data, size);
+        free(data);
+    }
+
+    bad += check_keywords();
+    bad += check_fuzz();
+
+    return bad != 0;
+}
+
+// EOF
@@ -0,0 +1,210 @@
+/**
+ * \file tiles_test.c
+ * Main menu tile cache test for the POSIX user space environment.
+ *
+ * Drives BootMaster/menu_tiles.c the way MainMenuStyle() does, on a menu
+ * with more loaders than fit on screen plus a row of tools. The selection
+ * walks along both rows and back, scrolling row 0 and repainting it as
+ * needed, and then row 0 scrolls without a repaint, so each slot is handed
+ * to another entry at the same position. Each tile found in the cache must
+ * be the one composed for that entry and state, and no more than two tiles
+ * per position on screen may be held at any time.
+ * Exits with 1 if any check fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Included rather than linked, to count the tiles held in the slots
+#include "../menu_tiles.c"
+
+#include <stdio.h>
+
+
+#define LOADERS         30
+#define TOOLS           6
+#define MAX_VISIBLE     8
+#define ROW0_COUNT      ((LOADERS < MAX_VISIBLE) ? LOADERS : MAX_VISIBLE)
+#define ROW1_SLOT       ROW0_COUNT
+#define SLOT_COUNT      (ROW0_COUNT + TOOLS)
+#define TILE_SIZE       16
+#define ROW0_Y          100
+#define ROW1_Y          300
+
+typedef struct {
+    int         row;
+    int         index;
+} test_entry;
+
+static test_entry   entries[LOADERS + TOOLS];
+static int          first_visible;
+static unsigned     composed, reused;
+static UINTN        max_held;
+static int          bad;
+
+// Same as MenuTileSlot() in menu.c ... Row 1 follows row 0 in the entries
+static UINTN tile_slot(int index)
+{
+    if (entries[index].row == 0)
+        return (UINTN) (index - first_visible);
+
+    return ROW1_SLOT + (UINTN) (index - LOADERS);
+}
+
+static UINTN tile_x(int index)
+{
+    return 10 + tile_slot(index) * (TILE_SIZE + 4);
+}
+
+static UINTN held_tiles(void)
+{
+    UINTN i, held = 0;
+
+    for (i = 0; i < MenuTileCount; i++) {
+        held += (MenuTiles[i].Image[0] != NULL);
+        held += (MenuTiles[i].Image[1] != NULL);
+    }
+
+    return held;
+}
+
+// What DrawMainMenuEntry() does, with each composed tile marked with its
+// entry and state in place of the pixels
+static void draw_entry(int index, int selected)
+{
+    test_entry *entry = &entries[index];
+    EG_IMAGE   *tile;
+    UINTN       slot, x, y, held;
+
+    slot = tile_slot(index);
+    x    = tile_x(index);
+    y    = (entry->row == 0) ? ROW0_Y : ROW1_Y;
+
+    tile = MenuTileFind(slot, entry, x, y, selected);
+    if (tile != NULL) {
+        if (tile->PixelData[0].r != (UINT8) index || tile->PixelData[0].g != (UINT8) selected) {
+            printf("  entry %d: cached tile belongs to entry %u, state %u\n",
+                   index, tile->PixelData[0].r, tile->PixelData[0].g);
+            bad++;
+        }
+        reused++;
+        return;
+    }
+
+    tile = egCreateImage(TILE_SIZE, TILE_SIZE, FALSE);
+    if (tile == NULL) {
+        printf("  out of memory\n");
+        bad++;
+        return;
+    }
+    memset(tile->PixelData, 0, TILE_SIZE * TILE_SIZE * sizeof(EG_PIXEL));
+    tile->PixelData[0].r = (UINT8) index;
+    tile->PixelData[0].g = (UINT8) selected;
+    composed++;
+
+    MenuTileStore(slot, selected, tile);
+
+    held = held_tiles();
+    if (held > 2 * SLOT_COUNT) {
+        printf("  %lu tiles held for %d positions\n", (unsigned long) held, SLOT_COUNT);
+        bad++;
+    }
+    if (held > max_held)
+        max_held = held;
+}
+
+// What MENU_FUNCTION_PAINT_ALL does
+static void paint_all(int selection)
+{
+    int i;
+
+    MenuTilesFlush();
+    for (i = first_visible; i < LOADERS && i < first_visible + MAX_VISIBLE; i++)
+        draw_entry(i, i == selection);
+    for (i = LOADERS; i < LOADERS + TOOLS; i++)
+        draw_entry(i, i == selection);
+}
+
+// What PaintSelection() does, scrolling row 0 like AdjustScrollState()
+static void move_selection(int previous, int current)
+{
+    if (current < LOADERS) {
+        if (current >= first_visible + MAX_VISIBLE) {
+            first_visible = current - MAX_VISIBLE + 1;
+            paint_all(current);
+            return;
+        }
+        if (current < first_visible) {
+            first_visible = current;
+            paint_all(current);
+            return;
+        }
+    }
+
+    draw_entry(previous, FALSE);
+    draw_entry(current, TRUE);
+}
+
+int main(int argc, char **argv)
+{
+    EG_IMAGE   *stray;
+    unsigned    moves = 0;
+    int         i, pass;
+
+    for (i = 0; i < LOADERS + TOOLS; i++) {
+        entries[i].row   = (i < LOADERS) ? 0 : 1;
+        entries[i].index = i;
+    }
+
+    if (!MenuTilesInit(SLOT_COUNT)) {
+        printf("no tile slots\n");
+        return 1;
+    }
+
+    first_visible = 0;
+    paint_all(0);
+
+    // Along both rows and back, twice, so the second pass can reuse tiles
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 1; i < LOADERS + TOOLS; i++, moves++)
+            move_selection(i - 1, i);
+        for (i = LOADERS + TOOLS - 2; i >= 0; i--, moves++)
+            move_selection(i + 1, i);
+    }
+
+    // Back and forth within the visible loaders, as a pointer would
+    for (i = 0; i < 200; i++, moves++)
+        move_selection(i % 3, (i + 1) % 3);
+
+    // Scroll row 0 without a flush ... Each slot now shows another entry at
+    // the same position, so only the entry tells its old tiles apart
+    first_visible = 0;
+    paint_all(0);
+    for (first_visible = 1; first_visible + MAX_VISIBLE <= LOADERS; first_visible++) {
+        for (i = first_visible; i < first_visible + MAX_VISIBLE; i++)
+            draw_entry(i, FALSE);
+    }
+
+    // A tile for a slot that does not exist must be freed, not kept
+    stray = egCreateImage(TILE_SIZE, TILE_SIZE, FALSE);
+    MenuTileStore(SLOT_COUNT, 0, stray);
+    stray = egCreateImage(TILE_SIZE, TILE_SIZE, FALSE);
+    MenuTileStore((UINTN) -1, 1, stray);
+
+    MenuTilesFree();
+    if (MenuTiles != NULL || MenuTileCount != 0) {
+        printf("  slots left after MenuTilesFree()\n");
+        bad++;
+    }
+
+    printf("%u moves: %u tiles composed, %u reused, at most %lu held for %d positions, %d failures\n",
+           moves, composed, reused, (unsigned long) max_held, SLOT_COUNT, bad);
+
+    return bad != 0;
+}
+
+// EOF
@@ -45,6 +45,23 @@ BOOLEAN  DelMsgLog = FALSE;
 
 EFI_FILE_PROTOCOL *mRootDir = NULL;
 
+// Log lines are collected here and written out in one go when the buffer
+// fills, when DEBUG_LOG_FLUSH_MS has passed since the last write, and at
+// WayPointer calls (before loading an image, rebooting or exiting) and on
+// forensic lines. A periodic timer also writes out lines left in the buffer
+// while RefindPlus waits or hangs, and every line is written through at
+// forensic log levels. The log file stays open between writes and is closed
+// at WayPointer calls so it is complete on disk when control leaves RefindPlus.
+#define DEBUG_LOG_BUFFER_SIZE   (16 * 1024)
+#define DEBUG_LOG_FLUSH_MS      (500)
+
+static CHAR8               mLogBuffer[DEBUG_LOG_BUFFER_SIZE];
+static UINTN               mLogBufferLen  = 0;
+static UINT64              mLogFlushMS    = 0;
+static EFI_FILE_PROTOCOL  *mLogFile       = NULL;
+static EFI_EVENT           mLogFlushEvent = NULL;
+static volatile BOOLEAN    mLogBusy       = FALSE;
+
 static
 CHAR16 * GetAltMonth (VOID) {
     CHAR16 *AltMonth = NULL;
@@ -206,26 +223,149 @@ EFI_FILE_PROTOCOL * GetDebugLogFile (VOID) {
     return LogProtocol;
 } // static EFI_FILE_PROTOCOL * GetDebugLogFile()
 
+// Appends Text to the log file, opening it and moving to EOF if not yet open.
+static
+VOID WriteDebugLogFile (
+    IN CHAR8 *Text,
+    IN UINTN  TextLen
+) {
+    EFI_FILE_INFO *Info;
+
+    if (mLogFile == NULL) {
+        // Get/Open Logfile
+        mLogFile = GetDebugLogFile();
+        if (mLogFile == NULL) {
+            return;
+        }
+
+        // Get File Info for LogFile
+        Info = EfiLibFileInfo (mLogFile);
+        if (Info == NULL) {
+            mLogFile->Close (mLogFile);
+            mLogFile = NULL;
+
+            return;
+        }
+
+        // Advance to EOF (Append Output)
+        mLogFile->SetPosition (mLogFile, Info->FileSize);
+        MY_FREE_POOL(Info);
+    }
+
+    // Write message out
+    mLogFile->Write (mLogFile, &TextLen, Text);
+} // static VOID WriteDebugLogFile()
+
+// Writes out buffered log lines and commits them to disk.
+// Closes the log file and stops the flush timer as well when CloseFile is TRUE.
+static
+VOID FlushDebugLogFile (
+    IN BOOLEAN CloseFile
+) {
+    BOOLEAN WasBusy = mLogBusy;
+
+    mLogBusy = TRUE;
+
+    if (mLogBufferLen > 0) {
+        WriteDebugLogFile (mLogBuffer, mLogBufferLen);
+        mLogBufferLen = 0;
+
+        if (mLogFile != NULL && !CloseFile) {
+            mLogFile->Flush (mLogFile);
+        }
+    }
+    mLogFlushMS = GetCurrentMS();
+
+    if (CloseFile) {
+        // DA-TAG: The timer must not outlive RefindPlus
+        //         Started again with the next buffered line
+        if (mLogFlushEvent != NULL) {
+            REFIT_CALL_1_WRAPPER(gBS->CloseEvent, mLogFlushEvent);
+            mLogFlushEvent = NULL;
+        }
+
+        if (mLogFile != NULL) {
+            // Close Logfile
+            mLogFile->Close (mLogFile);
+            mLogFile = NULL;
+        }
+    }
+
+    mLogBusy = WasBusy;
+} // static VOID FlushDebugLogFile()
+
+// Flush timer notify function.
+// Writes out lines that have sat in the buffer since the last tick, so that
+// they reach the disk while RefindPlus waits for input, stalls or hangs.
+static
+VOID EFIAPI FlushDebugLogTimer (
+    IN EFI_EVENT  Event,
+    IN VOID      *Context
+) {
+    // DA-TAG: Runs at TPL_CALLBACK and may interrupt the logger
+    //         Leave the buffer alone while lines are added or written
+    //         Only write to an already open file ... Opening it may log
+    if (mLogBusy || mLogBufferLen == 0 || mLogFile == NULL) {
+        // Early Return ... Try again on the next tick
+        return;
+    }
+
+    FlushDebugLogFile (FALSE);
+} // static VOID EFIAPI FlushDebugLogTimer()
+
+// Starts the periodic flush timer if not already running.
+static
+VOID StartDebugLogTimer (VOID) {
+    EFI_STATUS Status;
+
+    if (mLogFlushEvent != NULL) {
+        // Early Return
+        return;
+    }
+
+    Status = REFIT_CALL_5_WRAPPER(
+        gBS->CreateEvent, EVT_TIMER | EVT_NOTIFY_SIGNAL,
+        TPL_CALLBACK, FlushDebugLogTimer,
+        NULL, &mLogFlushEvent
+    );
+    if (EFI_ERROR(Status)) {
+        mLogFlushEvent = NULL;
+
+        return;
+    }
+
+    Status = REFIT_CALL_3_WRAPPER(
+        gBS->SetTimer, mLogFlushEvent,
+        TimerPeriodic, DEBUG_LOG_FLUSH_MS * 10000
+    );
+    if (EFI_ERROR(Status)) {
+        REFIT_CALL_1_WRAPPER(gBS->CloseEvent, mLogFlushEvent);
+        mLogFlushEvent = NULL;
+    }
+} // static VOID StartDebugLogTimer()
+
 static
 VOID SaveMessageToDebugLogFile (
     IN CHAR8 *LastMessage
 ) {
     UINTN             TextLen;
-    CHAR8            *Text;
-    EFI_FILE_INFO    *Info;
     EFI_FILE_HANDLE   LogFile;
 
-    // Get/Open Logfile
-    LogFile = GetDebugLogFile();
-    if (LogFile == NULL) {
-        return;
-    }
-
-    if (GlobalConfig.LogLevel < MINLOGLEVEL) {
+    if (GlobalConfig.LogLevel < MINLOGLEVEL && !DelMsgLog) {
         // DA-TAG: Undocumented feature
         //         Allows using DEBUG build without logging
         //         Set 'log-level' to negative value to activate
         // Delete Logfile on invalid log level
+        mLogBufferLen = 0;
+        FlushDebugLogFile (TRUE);
+
+        // Get/Open Logfile
+        LogFile = GetDebugLogFile();
+        if (LogFile == NULL) {
+            return;
+        }
+        LogFile->Close (LogFile);
+
         EFI_STATUS Status = REFIT_CALL_5_WRAPPER(
             mRootDir->Open, mRootDir,
             &LogFile, mDebugLog,
@@ -244,37 +384,36 @@ VOID SaveMessageToDebugLogFile (
         return;
     }
 
-    // Get File Info for LogFile
-    Info = EfiLibFileInfo (LogFile);
-    if (Info) {
-        // DA-TAG: Investigate This
-        //         'Softly' disable combining buffer
-        //         Review and make permanent later
-        //         Means removing 'FirstTimeSave'
-        //         Currently just set to 'FALSE'
-        //         Change to 'TRUE' if keeping
-        static BOOLEAN FirstTimeSave = FALSE;
-
-        // Use whole buffer on 'FirstTimeSave'
-        Text = (FirstTimeSave)
-            ? GetMemLogBuffer()
-            : LastMessage;
-        TextLen = (FirstTimeSave)
-            ? GetMemLogLen()
-            : AsciiStrLen (LastMessage);
-
-        // Advance to EOF (Append Output)
-        LogFile->SetPosition (LogFile, Info->FileSize);
+    // Keep the flush timer off the buffer until done
+    mLogBusy = TRUE;
 
-        // Write message out
-        LogFile->Write (LogFile, &TextLen, Text);
+    TextLen = AsciiStrLen (LastMessage);
+    if (mLogBufferLen + TextLen > DEBUG_LOG_BUFFER_SIZE) {
+        FlushDebugLogFile (FALSE);
+    }
 
-        // Update 'FirstTimeSave'
-        FirstTimeSave = FALSE;
+    if (TextLen > DEBUG_LOG_BUFFER_SIZE) {
+        // Too long to buffer ... Write it out directly
+        WriteDebugLogFile (LastMessage, TextLen);
+        FlushDebugLogFile (FALSE);
+    }
+    else {
+        CopyMem (mLogBuffer + mLogBufferLen, LastMessage, TextLen);
+        mLogBufferLen += TextLen;
+
+        // Write through when forensic logging or when the file is not open
+        // The flush timer only writes to an open file
+        if (GlobalConfig.LogLevel > MAXLOGLEVEL
+            || mLogFile == NULL
+            || (GetCurrentMS() - mLogFlushMS) >= DEBUG_LOG_FLUSH_MS
+        ) {
+            FlushDebugLogFile (FALSE);
+        }
     }
 
-    // Close Logfile
-    LogFile->Close (LogFile);
+    StartDebugLogTimer();
+
+    mLogBusy = FALSE;
 } // static VOID SaveMessageToDebugLogFile()
 
 VOID WayPointer (
@@ -301,6 +440,10 @@ VOID WayPointer (
 
     // Restore LogLevel if changed
     GlobalConfig.LogLevel = TmpLogLevelStore;
+
+    // Control may be about to leave RefindPlus
+    // Write out buffered lines and close the logfile
+    FlushDebugLogFile (TRUE);
 } // VOID WayPointer()
 
 VOID DeepLoggger (
@@ -387,6 +530,11 @@ VOID DeepLoggger (
 
             // Disable Native Logging
             UseMsgLog = FALSE;
+
+            // Get forensic lines on disk straight away
+            if (type == LOG_LINE_FORENSIC) {
+                FlushDebugLogFile (FALSE);
+            }
         }
     }
 
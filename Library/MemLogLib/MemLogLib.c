@@ -24,6 +24,10 @@
  */
 
 
+// The TSC calibration arithmetic builds on the host as well. See test/.
+#ifdef HOST_POSIX
+#include "test/memlog_posix_base.h"
+#else
 #include <Uefi.h>
 #include <Library/BaseLib.h>
 #include <Library/PrintLib.h>
@@ -35,9 +39,215 @@
 
 #include <Library/IoLib.h>
 #include <Library/PciLib.h>
+#include <Guid/Acpi.h>
+#include <IndustryStandard/Acpi.h>
+#include <IndustryStandard/HighPrecisionEventTimerTable.h>
 #include "GenericIch.h"
 #include "../../BootMaster/rp_funcs.h"
 #include "../../include/refit_call_wrapper.h"
+#endif
+
+// TSC calibration
+// Counter windows start at TSC_CAL_MIN_MS and double up to TSC_CAL_MAX_MS
+// until two successive estimates agree within TSC_CAL_TARGET_PPM.
+#define TSC_CAL_MIN_MS            2
+#define TSC_CAL_MAX_MS            100
+#define TSC_CAL_TARGET_PPM        250
+#define TSC_CAL_STUCK_LIMIT       (1ULL << 24)  // TSC ticks without a counter tick before giving up
+#define TSC_CAL_SPIN_LIMIT        (1ULL << 31)  // TSC ticks before any window is abandoned
+#define TSC_CRYSTAL_PPM           100           // Usual tolerance of the CPUID 0x15 crystal
+#define TSC_CAL_READ_JITTER_NS    1500          // Port or MMIO read latency, with margin
+#define STALL_JITTER_US           50
+
+#define HPET_GENERAL_CAPABILITIES   0x000
+#define HPET_GENERAL_CONFIGURATION  0x010
+#define HPET_MAIN_COUNTER           0x0F0
+#define HPET_ENABLE_CNF             BIT0
+#define HPET_MAX_PERIOD_FS          0x05F5E100  // 100ns, the slowest period the spec allows
+
+typedef enum {
+    TSC_SOURCE_NONE = 0,
+    TSC_SOURCE_CPUID,
+    TSC_SOURCE_HPET,
+    TSC_SOURCE_PM_TIMER,
+    TSC_SOURCE_STALL
+} TSC_SOURCE;
+
+static CHAR8 *mTscSourceNames[] = {
+    "None",
+    "CPUID Crystal Ratio",
+    "HPET",
+    "ACPI PM Timer",
+    "Boot Services Stall"
+};
+
+typedef UINT32 (*TSC_REF_COUNTER) (IN UINTN Address);
+
+/**
+  Derives the TSC frequency from CPUID leaves 0x15 and 0x16.
+
+  @param  MaxLeaf      Highest basic CPUID leaf (leaf 0 EAX).
+  @param  Denominator  Leaf 0x15 EAX, TSC/crystal ratio denominator.
+  @param  Numerator    Leaf 0x15 EBX, TSC/crystal ratio numerator.
+  @param  CrystalHz    Leaf 0x15 ECX, crystal frequency or 0 if not enumerated.
+  @param  BaseMHz      Leaf 0x16 EAX, processor base frequency.
+  @param  ErrorPpm     Receives the error bound of the result.
+
+  @retval TSC ticks per second, or 0 if the leaves do not describe it.
+**/
+static
+UINT64 TscFreqFromCpuid (
+    IN  UINT32  MaxLeaf,
+    IN  UINT32  Denominator,
+    IN  UINT32  Numerator,
+    IN  UINT32  CrystalHz,
+    IN  UINT32  BaseMHz,
+    OUT UINT32 *ErrorPpm
+) {
+    if (MaxLeaf < 0x15 || Denominator == 0 || Numerator == 0) {
+        // Early return ... Ratio not enumerated
+        return 0;
+    }
+
+    if (CrystalHz != 0) {
+        *ErrorPpm = TSC_CRYSTAL_PPM;
+
+        return DivU64x32 (MultU64x32 (CrystalHz, Numerator), Denominator);
+    }
+
+    // Crystal not enumerated ... The ratio applied to the crystal then
+    // gives the base frequency, so use leaf 0x16 where present.
+    BaseMHz &= 0xFFFF;
+    if (MaxLeaf < 0x16 || BaseMHz == 0) {
+        // Early return
+        return 0;
+    }
+
+    // Bounded by the rounding of the MHz figure
+    *ErrorPpm = (500000 + BaseMHz - 1) / BaseMHz;
+
+    return MultU64x32 (1000000, BaseMHz);
+}
+
+/**
+  Checks whether a TSC frequency estimate has settled.
+
+  @param  Estimate      Estimate over the current window.
+  @param  PrevEstimate  Estimate over the previous, shorter window, or 0.
+  @param  WindowTicks   Reference ticks in the current window.
+  @param  JitterTicks   Reference ticks a window end may be off by.
+  @param  ErrorPpm      Receives the larger of the disagreement between the
+                        two estimates and the read jitter of both window
+                        ends over the window.
+
+  @retval TRUE if the estimate is within TSC_CAL_TARGET_PPM.
+**/
+static
+BOOLEAN TscEstimateSettled (
+    IN  UINT64  Estimate,
+    IN  UINT64  PrevEstimate,
+    IN  UINT64  WindowTicks,
+    IN  UINT32  JitterTicks,
+    OUT UINT32 *ErrorPpm
+) {
+    UINT64    Diff;
+    UINT64    DiffPpm;
+    UINT64    JitterPpm;
+
+    if (Estimate == 0 || WindowTicks == 0) {
+        *ErrorPpm = MAX_UINT32;
+
+        // Early return
+        return FALSE;
+    }
+
+    JitterPpm = DivU64x64Remainder (MultU64x32 (2000000, JitterTicks), WindowTicks, NULL);
+
+    if (PrevEstimate == 0) {
+        DiffPpm = MAX_UINT32;
+    }
+    else {
+        Diff    = (Estimate > PrevEstimate) ? Estimate - PrevEstimate : PrevEstimate - Estimate;
+        DiffPpm = DivU64x64Remainder (MultU64x32 (Diff, 1000000), Estimate, NULL);
+    }
+
+    *ErrorPpm = (UINT32) MIN (MAX (DiffPpm, JitterPpm), MAX_UINT32);
+
+    return (DiffPpm <= TSC_CAL_TARGET_PPM && JitterPpm <= TSC_CAL_TARGET_PPM);
+}
+
+/**
+  Calibrates the TSC against a free running counter over doubling windows,
+  stopping as soon as the estimate settles.
+
+  @param  ReadCounter  Reads the counter.
+  @param  Address      Counter address passed to ReadCounter.
+  @param  CounterHz    Counter frequency.
+  @param  CounterMask  Counter width mask, for wrap around.
+  @param  ErrorPpm     Receives the error bound of the result.
+
+  @retval TSC ticks per second, or 0 if the counter stopped.
+**/
+static
+UINT64 CalibrateTscAgainstCounter (
+    IN  TSC_REF_COUNTER  ReadCounter,
+    IN  UINTN            Address,
+    IN  UINT64           CounterHz,
+    IN  UINT32           CounterMask,
+    OUT UINT32          *ErrorPpm
+) {
+    UINT64    Tsc0, Tsc1;
+    UINT64    Estimate, PrevEstimate;
+    UINT32    Start, Ticks;
+    UINT32    Target, MaxTarget;
+    UINT32    JitterTicks;
+
+    // Read latency plus the tick a read may land short of
+    JitterTicks = (UINT32) DivU64x32 (MultU64x32 (CounterHz, TSC_CAL_READ_JITTER_NS), 1000000000) + 1;
+
+    Target    = (UINT32) DivU64x32 (MultU64x32 (CounterHz, TSC_CAL_MIN_MS), 1000);
+    MaxTarget = (UINT32) DivU64x32 (MultU64x32 (CounterHz, TSC_CAL_MAX_MS), 1000);
+
+    PrevEstimate = 0;
+    Start        = ReadCounter (Address);
+    Tsc0         = AsmReadTsc();
+
+    for (;;) {
+        do {
+            CpuPause();
+
+            Ticks = (ReadCounter (Address) - Start) & CounterMask;
+            Tsc1  = AsmReadTsc();
+
+            if ((Ticks == 0 && Tsc1 - Tsc0 > TSC_CAL_STUCK_LIMIT) ||
+                Tsc1 - Tsc0 > TSC_CAL_SPIN_LIMIT
+            ) {
+                // Early return ... Counter is not advancing
+                return 0;
+            }
+        } while (Ticks < Target);
+
+        Estimate = DivU64x64Remainder (
+            MultU64x64 (Tsc1 - Tsc0, CounterHz),
+            Ticks,
+            NULL
+        );
+
+        if (TscEstimateSettled (Estimate, PrevEstimate, Ticks, JitterTicks, ErrorPpm) ||
+            Target >= MaxTarget
+        ) {
+            break;
+        }
+
+        PrevEstimate = Estimate;
+        Target       = MIN (Target * 2, MaxTarget);
+    } // for ;;
+
+    return Estimate;
+}
+
+#ifndef HOST_POSIX
+// The log itself and the reference counters need the firmware
 
 // Struct for holding mem buffer.
 typedef struct {
@@ -69,6 +279,7 @@ CHAR8     mTimingTxt[32];
 BOOLEAN   mTimerPrev = FALSE;
 
 
+
 UINT64 GetCurrentMS (VOID) {
 	UINT64    CurrentMS  = 0;
 	UINT64    CurrentTsc = 0;
@@ -156,6 +367,107 @@ CHAR8 * GetTiming (VOID) {
 
 
 
+static
+UINT32 ReadPmTimer (
+    IN UINTN Address
+) {
+    return IoRead32 (Address);
+}
+
+static
+UINT32 ReadHpetCounter (
+    IN UINTN Address
+) {
+    return MmioRead32 (Address + HPET_MAIN_COUNTER);
+}
+
+/**
+  Calibrates the TSC against a single TSC_CAL_MAX_MS gBS->Stall(), as a last
+  resort when no hardware reference counter is usable.
+
+  Windows do not double here as they do for counters. Stall() may be off by
+  STALL_JITTER_US at each end, which only settles within TSC_CAL_TARGET_PPM
+  over 400ms, so no shorter window could ever stop early.
+
+  @param  ErrorPpm     Receives the error bound of the result.
+
+  @retval TSC ticks per second.
+**/
+static
+UINT64 CalibrateTscAgainstStall (
+    OUT UINT32 *ErrorPpm
+) {
+    UINT64    Tsc0, Tsc1;
+
+    Tsc0 = AsmReadTsc();
+    gBS->Stall (TSC_CAL_MAX_MS * 1000);
+    Tsc1 = AsmReadTsc();
+
+    *ErrorPpm = (UINT32) DivU64x32 (MultU64x32 (2000000, STALL_JITTER_US), TSC_CAL_MAX_MS * 1000);
+
+    return DivU64x32 (MultU64x32 (Tsc1 - Tsc0, 1000), TSC_CAL_MAX_MS);
+}
+
+/**
+  Finds an ACPI table through the RSDP in the EFI configuration table.
+
+  @param  Signature  Table signature.
+
+  @retval The table, or NULL if not found.
+**/
+static
+VOID * FindAcpiTable (
+    IN UINT32 Signature
+) {
+    EFI_ACPI_2_0_ROOT_SYSTEM_DESCRIPTION_POINTER  *Rsdp = NULL;
+    EFI_ACPI_DESCRIPTION_HEADER                   *Sdt;
+    EFI_ACPI_DESCRIPTION_HEADER                   *Table;
+    UINT8                                         *Entry;
+    UINTN                                          EntrySize;
+    UINTN                                          Count, i;
+
+    for (i = 0; i < gST->NumberOfTableEntries; i++) {
+        if (CompareGuid (&gST->ConfigurationTable[i].VendorGuid, &gEfiAcpi20TableGuid)) {
+            Rsdp = gST->ConfigurationTable[i].VendorTable;
+            break;
+        }
+        if (CompareGuid (&gST->ConfigurationTable[i].VendorGuid, &gEfiAcpi10TableGuid)) {
+            Rsdp = gST->ConfigurationTable[i].VendorTable;
+        }
+    }
+    if (Rsdp == NULL) {
+        // Early return
+        return NULL;
+    }
+
+    if (Rsdp->Revision >= 2 && Rsdp->XsdtAddress != 0) {
+        Sdt       = (EFI_ACPI_DESCRIPTION_HEADER *) (UINTN) Rsdp->XsdtAddress;
+        EntrySize = sizeof (UINT64);
+    }
+    else {
+        Sdt       = (EFI_ACPI_DESCRIPTION_HEADER *) (UINTN) Rsdp->RsdtAddress;
+        EntrySize = sizeof (UINT32);
+    }
+    if (Sdt == NULL || Sdt->Length < sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+        // Early return
+        return NULL;
+    }
+
+    Count = (Sdt->Length - sizeof (EFI_ACPI_DESCRIPTION_HEADER)) / EntrySize;
+    Entry = (UINT8 *) (Sdt + 1);
+    for (i = 0; i < Count; i++, Entry += EntrySize) {
+        Table = (EntrySize == sizeof (UINT64))
+            ? (EFI_ACPI_DESCRIPTION_HEADER *) (UINTN) ReadUnaligned64 ((UINT64 *) Entry)
+            : (EFI_ACPI_DESCRIPTION_HEADER *) (UINTN) ReadUnaligned32 ((UINT32 *) Entry);
+
+        if (Table != NULL && Table->Signature == Signature) {
+            return Table;
+        }
+    }
+
+    return NULL;
+}
+
 /**
   Inits mem log.
 
@@ -163,11 +475,18 @@ CHAR8 * GetTiming (VOID) {
 **/
 EFI_STATUS EFIAPI MemLogInit (VOID) {
     EFI_STATUS      Status;
+    TSC_SOURCE      Source;
     UINT32          TimerAddr = 0;
-    UINT64          Tsc0, Tsc1;
-    UINT32          AcpiTick0, AcpiTick1, AcpiTicksDelta, AcpiTicksTarget;
+    UINT32          TimerMask;
+    UINT32          ErrorPpm  = 0;
+    UINT32          MaxLeaf, Denominator, Numerator, CrystalHz, BaseMHz;
+    UINT32          HpetPeriod;
+    UINTN           HpetBase;
     CHAR8           InitError[50];
 
+    EFI_ACPI_2_0_FIXED_ACPI_DESCRIPTION_TABLE         *Fadt;
+    EFI_ACPI_HIGH_PRECISION_EVENT_TIMER_TABLE_HEADER  *Hpet;
+
     static BOOLEAN  SkipLog = FALSE;
 
     if (SkipLog) {
@@ -218,97 +537,105 @@ EFI_STATUS EFIAPI MemLogInit (VOID) {
     // Calibrate TSC for timings
     InitError[0]='\0';
 
-    // We will try to calibrate TSC frequency according to the ACPI Power Management Timer.
-    // The ACPI PM Timer is running at a universal known frequency of 3579545Hz.
-    // So, we wait 357954 clocks of the ACPI timer (100ms), and compare with how much TSC advanced.
-    // This seems to provide a much more accurate calibration than using gBS->Stall(),
-    // especially on UEFI machines, and is important as this value is used later to calculate FSBFrequency.
+    // Try the calibration sources in turn, cheapest first:
+    //   - CPUID leaves 0x15/0x16 state the TSC frequency outright.
+    //   - The HPET and the ACPI PM Timer run at known frequencies. The TSC is
+    //     measured against them over short windows that double until the
+    //     estimate settles, rather than a flat 100ms.
+    //   - A flat 100ms gBS->Stall() is used only if none of those is usable.
+    Source = TSC_SOURCE_NONE;
+
+    AsmCpuid (0, &MaxLeaf, NULL, NULL, NULL);
+    if (MaxLeaf >= 0x15) {
+        AsmCpuid (0x15, &Denominator, &Numerator, &CrystalHz, NULL);
+        BaseMHz = 0;
+        if (MaxLeaf >= 0x16) {
+            AsmCpuid (0x16, &BaseMHz, NULL, NULL, NULL);
+        }
 
-    // Check if we can use the timer - we need to be on Intel ICH,
-    //  get ACPI PM Timer Address from PCI, and check that it is sane
-    if ((PciRead16( PCI_ICH_LPC_ADDRESS(0))) != 0x8086) {
-        // Intel ICH device was not found
-        TimerAddr = 0;
-        AsciiSPrint (InitError, sizeof (InitError), "Intel ICH Device Not Found");
+        mMemLog->TscFreqSec = TscFreqFromCpuid (
+            MaxLeaf, Denominator, Numerator,
+            CrystalHz, BaseMHz, &ErrorPpm
+        );
+        if (mMemLog->TscFreqSec != 0) {
+            Source = TSC_SOURCE_CPUID;
+        }
     }
-    else if ((PciRead8 (PCI_ICH_LPC_ADDRESS(R_ICH_LPC_ACPI_CNT)) & B_ICH_LPC_ACPI_CNT_ACPI_EN) == 0) {
-        AsciiSPrint (InitError, sizeof (InitError), "ACPI I/O Space Not Enabled");
+
+    if (Source == TSC_SOURCE_NONE) {
+        Hpet = FindAcpiTable (EFI_ACPI_3_0_HIGH_PRECISION_EVENT_TIMER_TABLE_SIGNATURE);
+        if (Hpet != NULL &&
+            Hpet->BaseAddressLower32Bit.AddressSpaceId == EFI_ACPI_2_0_SYSTEM_MEMORY &&
+            Hpet->BaseAddressLower32Bit.Address != 0
+        ) {
+            HpetBase   = (UINTN) Hpet->BaseAddressLower32Bit.Address;
+            HpetPeriod = MmioRead32 (HpetBase + HPET_GENERAL_CAPABILITIES + 4);
+
+            // Only use an HPET the firmware left running
+            if (HpetPeriod != 0 &&
+                HpetPeriod <= HPET_MAX_PERIOD_FS &&
+                (MmioRead32 (HpetBase + HPET_GENERAL_CONFIGURATION) & HPET_ENABLE_CNF) != 0
+            ) {
+                mMemLog->TscFreqSec = CalibrateTscAgainstCounter (
+                    ReadHpetCounter, HpetBase,
+                    DivU64x32 (1000000000000000ULL, HpetPeriod),
+                    0xFFFFFFFF, &ErrorPpm
+                );
+                if (mMemLog->TscFreqSec != 0) {
+                    Source = TSC_SOURCE_HPET;
+                }
+            }
+        }
     }
-    else {
-        TimerAddr = ((PciRead16 (PCI_ICH_LPC_ADDRESS(R_ICH_LPC_ACPI_BASE))) & B_ICH_LPC_ACPI_BASE_BAR) +
-            R_ACPI_PM1_TMR;
 
-        if (TimerAddr < 9) {
+    if (Source == TSC_SOURCE_NONE) {
+        // The ACPI PM Timer is running at a universal known frequency of 3579545Hz.
+        // Find its port in the FADT, else from the PCI config of an Intel ICH.
+        TimerMask = 0x00FFFFFF;
+        Fadt = FindAcpiTable (EFI_ACPI_2_0_FIXED_ACPI_DESCRIPTION_TABLE_SIGNATURE);
+        if (Fadt != NULL && Fadt->PmTmrBlk != 0) {
+            TimerAddr = Fadt->PmTmrBlk;
+            if ((Fadt->Flags & EFI_ACPI_2_0_TMR_VAL_EXT) != 0) {
+                TimerMask = 0xFFFFFFFF;
+            }
+        }
+        else if ((PciRead16( PCI_ICH_LPC_ADDRESS(0))) != 0x8086) {
+            // Intel ICH device was not found
             TimerAddr = 0;
-            AsciiSPrint (InitError, sizeof (InitError), "Timer Address Not Obtained");
+            AsciiSPrint (InitError, sizeof (InitError), "Intel ICH Device Not Found");
+        }
+        else if ((PciRead8 (PCI_ICH_LPC_ADDRESS(R_ICH_LPC_ACPI_CNT)) & B_ICH_LPC_ACPI_CNT_ACPI_EN) == 0) {
+            AsciiSPrint (InitError, sizeof (InitError), "ACPI I/O Space Not Enabled");
         }
         else {
-            // Check that Timer is advancing
-            AcpiTick0 = IoRead32 (TimerAddr);
-            gBS->Stall(1000); // 1ms
-            AcpiTick1 = IoRead32 (TimerAddr);
+            TimerAddr = ((PciRead16 (PCI_ICH_LPC_ADDRESS(R_ICH_LPC_ACPI_BASE))) & B_ICH_LPC_ACPI_BASE_BAR) +
+                R_ACPI_PM1_TMR;
 
-            if (AcpiTick0 == AcpiTick1) {
+            if (TimerAddr < 9) {
                 TimerAddr = 0;
-                AsciiSPrint (InitError, sizeof (InitError), "Timer Not Advancing");
+                AsciiSPrint (InitError, sizeof (InitError), "Timer Address Not Obtained");
             }
         }
-    }
-
-    // We prefer to use the ACPI PM Timer when possible. If it is not available we fallback to old method.
-    if (TimerAddr == 0) {
-        // ACPI PM Timer is not working, fall back on the old method
-
-        // Read Current Tsc
-        Tsc0 = AsmReadTsc();
-
-        // Wait for 100ms
-        gBS->Stall(100000); // 100ms
-
-        // Read New Current Tsc
-        Tsc1 = AsmReadTsc();
 
-        // Get Frequency from Tsc Difference
-        mMemLog->TscFreqSec = MultU64x32 ((Tsc1 - Tsc0), 10);
-    }
-    else {
-        // ACPI PM Timer seems to be working
-        // ACPI PM timers are usually of 24-bit length but there are some less common cases of 32-bit lengths.
-        //   When the maximal number is reached, it overflows.
-        // The code below can handle overflow with AcpiTicksTarget of up to 24-bit size,
-        AcpiTicksTarget = V_ACPI_TMR_FREQUENCY/10; // 357954 clocks of ACPI timer (100ms)
-        AcpiTick0       = IoRead32 (TimerAddr); // read ACPI tick
-        Tsc0            = AsmReadTsc(); // read TSC
-
-        do {
-            CpuPause();
-
-            // Check how many AcpiTicks have passed since we started
-            AcpiTick1 = IoRead32 (TimerAddr);
-            if (AcpiTick0 <= AcpiTick1) {
-                // No overflow
-                AcpiTicksDelta = AcpiTick1 - AcpiTick0;
-            }
-            else if (AcpiTick0 - AcpiTick1 <= 0x00FFFFFF) {
-                // Overflow, 24-bit timer
-                AcpiTicksDelta = (0x00FFFFFF - AcpiTick0) + AcpiTick1;
+        if (TimerAddr != 0) {
+            mMemLog->TscFreqSec = CalibrateTscAgainstCounter (
+                ReadPmTimer, TimerAddr,
+                V_ACPI_TMR_FREQUENCY,
+                TimerMask, &ErrorPpm
+            );
+            if (mMemLog->TscFreqSec != 0) {
+                Source = TSC_SOURCE_PM_TIMER;
             }
             else {
-                // Overflow, 32-bit timer
-                AcpiTicksDelta = (0xFFFFFFFF - AcpiTick0) + AcpiTick1;
+                AsciiSPrint (InitError, sizeof (InitError), "Timer Not Advancing");
             }
-        } while (AcpiTicksDelta < AcpiTicksTarget); // Keep checking Acpi ticks until target is reached
-
-        Tsc1 = AsmReadTsc();
+        }
+    }
 
-        // Done ... get another TSC
-        mMemLog->TscFreqSec = DivU64x32 (
-            MultU64x32 (
-                (Tsc1 - Tsc0),
-                V_ACPI_TMR_FREQUENCY
-            ),
-            AcpiTicksDelta
-        );
+    if (Source == TSC_SOURCE_NONE) {
+        // No usable timer ... Fall back on the old method
+        mMemLog->TscFreqSec = CalibrateTscAgainstStall (&ErrorPpm);
+        Source = TSC_SOURCE_STALL;
     }
 
     // Set timer and flag this
@@ -333,9 +660,14 @@ EFI_STATUS EFIAPI MemLogInit (VOID) {
     }
 
     // Show Notice if Required
-    if (InitError[0] != '\0') {
+    if (Source == TSC_SOURCE_STALL && InitError[0] != '\0') {
         MemLog (FALSE, 1, "** Could Not Calibrate ACPI PM Timer ... %a **\n\n", InitError);
     }
+    MemLog (
+        FALSE, 1,
+        "TSC Calibrated via %a ... %ld Hz (+/- %d ppm)\n\n",
+        mTscSourceNames[Source], mMemLog->TscFreqSec, ErrorPpm
+    );
 
     return EFI_SUCCESS;
 }
@@ -519,3 +851,5 @@ UINT64 EFIAPI GetMemLogTscTicksPerSecond (VOID) {
 
     return mMemLog->TscFreqSec;
 }
+
+#endif // HOST_POSIX
@@ -0,0 +1,72 @@
+/**
+ * \file memlog_posix_base.h
+ * Base definitions for building MemLogLib's TSC calibration in the POSIX
+ * user space environment.
+ *
+ * Library/MemLogLib/MemLogLib.c includes this file instead of the EDK2
+ * headers when it is built with HOST_POSIX, which leaves out everything but
+ * the calibration arithmetic. It provides the EFI types and the BaseLib
+ * functions that code uses. AsmReadTsc() and CpuPause() come from the test,
+ * which runs them on a simulated clock.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MEMLOG_POSIX_BASE_H_
+#define _MEMLOG_POSIX_BASE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+#define IN
+#define OUT
+#define TRUE                    (1)
+#define FALSE                   (0)
+#define BIT0                    (1)
+#define MAX_UINT32              (0xFFFFFFFF)
+#define MIN(a, b)               (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)               (((a) > (b)) ? (a) : (b))
+
+typedef void                    VOID;
+typedef char                    CHAR8;
+typedef uint32_t                UINT32;
+typedef uint64_t                UINT64;
+typedef uintptr_t               UINTN;
+typedef unsigned char           BOOLEAN;
+
+static inline UINT64 MultU64x32 (UINT64 Multiplicand, UINT32 Multiplier)
+{
+    return Multiplicand * Multiplier;
+}
+
+static inline UINT64 MultU64x64 (UINT64 Multiplicand, UINT64 Multiplier)
+{
+    return Multiplicand * Multiplier;
+}
+
+static inline UINT64 DivU64x32 (UINT64 Dividend, UINT32 Divisor)
+{
+    return Dividend / Divisor;
+}
+
+static inline UINT64 DivU64x64Remainder (UINT64 Dividend, UINT64 Divisor, UINT64 *Remainder)
+{
+    if (Remainder != NULL) {
+        *Remainder = Dividend % Divisor;
+    }
+    return Dividend / Divisor;
+}
+
+// Provided by the test
+UINT64 AsmReadTsc (VOID);
+VOID CpuPause (VOID);
+
+#endif
+
+// EOF
@@ -0,0 +1,231 @@
+/**
+ * \file tsc_test.c
+ * TSC calibration test for the POSIX user space environment.
+ *
+ * Checks TscFreqFromCpuid() on CPUID leaf 0x15 and 0x16 values, then runs
+ * TscEstimateSettled() edge cases, then runs CalibrateTscAgainstCounter()
+ * against simulated PM timer, HPET and 24MHz counters. The simulated TSC
+ * runs at 1 to 5.2GHz, and counter reads land up to TSC_CAL_READ_JITTER_NS
+ * early at random. Each
+ * estimate must be within the error bound the calibration reports. A
+ * counter that never advances must be given up. Prints the longest
+ * calibration time per counter. Exits with 1 if any check fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Included rather than linked, to reach the static calibration functions
+#include "../MemLogLib.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define PAUSE_NS        (40e-9)     // Time a CpuPause() takes
+#define TSC_READ_NS     (20e-9)     // Time a TSC read takes
+#define RUNS            (20)
+
+static double       sim_time;       // Seconds since the simulated boot
+static double       sim_tsc_hz;
+static double       sim_counter_hz;
+static double       sim_read_s;     // Time a counter read takes
+static double       sim_jitter_s;   // How early a counter read may land
+static UINT32       sim_counter_base;
+static int          sim_stuck;
+
+UINT64 AsmReadTsc (VOID)
+{
+    sim_time += TSC_READ_NS;
+    return (UINT64) (sim_time * sim_tsc_hz);
+}
+
+VOID CpuPause (VOID)
+{
+    sim_time += PAUSE_NS;
+}
+
+static UINT32 read_sim_counter(UINTN Address)
+{
+    double      seen;
+
+    sim_time += sim_read_s;
+    if (sim_stuck)
+        return sim_counter_base;
+
+    seen = sim_time - sim_jitter_s * rand() / RAND_MAX;
+    return sim_counter_base + (UINT32) (UINT64) (seen * sim_counter_hz);
+}
+
+static int check_cpuid(void)
+{
+    static const struct {
+        UINT32      max_leaf, denominator, numerator, crystal_hz, base_mhz;
+        UINT64      hz;
+        UINT32      ppm;
+    } cases[] = {
+        // Crystal enumerated
+        { 0x16, 2, 176, 24000000, 2100, 2112000000ULL, 100 },
+        { 0x15, 2, 216, 25000000, 0,    2700000000ULL, 100 },
+        { 0x1F, 3, 250, 38400000, 3200, 3200000000ULL, 100 },
+        // Crystal not enumerated ... Base frequency from leaf 0x16
+        { 0x16, 2, 300, 0,        3000, 3000000000ULL, 167 },
+        { 0x16, 2, 300, 0,        0xABCD0834, 2100000000ULL, 239 },
+        // Not described
+        { 0x14, 2, 176, 24000000, 2100, 0, 0 },
+        { 0x16, 0, 176, 24000000, 2100, 0, 0 },
+        { 0x16, 2, 0,   24000000, 2100, 0, 0 },
+        { 0x15, 2, 300, 0,        3000, 0, 0 },
+        { 0x16, 2, 300, 0,        0,    0, 0 },
+    };
+    UINT64      hz;
+    UINT32      ppm;
+    size_t      i;
+    int         bad = 0;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ppm = 0;
+        hz  = TscFreqFromCpuid(cases[i].max_leaf, cases[i].denominator, cases[i].numerator,
+                               cases[i].crystal_hz, cases[i].base_mhz, &ppm);
+        if (hz != cases[i].hz || (hz != 0 && ppm != cases[i].ppm)) {
+            printf("  CPUID case %zu: %llu Hz +-%u ppm, expected %llu Hz +-%u ppm\n", i,
+                   (unsigned long long) hz, ppm,
+                   (unsigned long long) cases[i].hz, cases[i].ppm);
+            bad++;
+        }
+    }
+
+    printf("CPUID decoding: %zu cases, %d failures\n", sizeof(cases) / sizeof(cases[0]), bad);
+    return bad;
+}
+
+static int check_settled(void)
+{
+    static const struct {
+        UINT64      estimate, prev, window;
+        UINT32      jitter;
+        BOOLEAN     settled;
+        UINT32      ppm;
+    } cases[] = {
+        // No estimate or empty window
+        { 0,          3000000000ULL, 7159,  6,  FALSE, MAX_UINT32 },
+        { 3000000000ULL, 3000000000ULL, 0,  6,  FALSE, MAX_UINT32 },
+        // First window ... Nothing to compare against
+        { 3000000000ULL, 0,          57273, 6,  FALSE, MAX_UINT32 },
+        // Agreeing estimates ... Window long enough
+        { 3000000000ULL, 3000300000ULL, 57273, 6, TRUE, 209 },
+        { 3000300000ULL, 3000000000ULL, 57273, 6, TRUE, 209 },
+        // Agreeing estimates ... Window too short for the read jitter
+        { 3000000000ULL, 3000000000ULL, 7159, 6, FALSE, 1676 },
+        // Window long enough ... Estimates disagree
+        { 3000000000ULL, 3001500000ULL, 57273, 6, FALSE, 500 },
+        // Exactly on the target
+        { 4000000000ULL, 4001000000ULL, 48000, 6, TRUE, 250 },
+        // Disagreement larger than a UINT32 of ppm
+        { 1000, 5000000000ULL, 57273, 6, FALSE, MAX_UINT32 },
+    };
+    BOOLEAN     settled;
+    UINT32      ppm;
+    size_t      i;
+    int         bad = 0;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ppm     = 0;
+        settled = TscEstimateSettled(cases[i].estimate, cases[i].prev, cases[i].window,
+                                     cases[i].jitter, &ppm);
+        if (settled != cases[i].settled || ppm != cases[i].ppm) {
+            printf("  Settle case %zu: %s +-%u ppm, expected %s +-%u ppm\n", i,
+                   settled ? "settled" : "not settled", ppm,
+                   cases[i].settled ? "settled" : "not settled", cases[i].ppm);
+            bad++;
+        }
+    }
+
+    printf("Settle check: %zu cases, %d failures\n", sizeof(cases) / sizeof(cases[0]), bad);
+    return bad;
+}
+
+static int check_counter(const char *name, double counter_hz, UINT32 mask, double read_s)
+{
+    static const double tsc_hz[]   = { 1.0e9, 2.1e9, 3.6e9, 5.2e9 };
+    static const double jitter_s[] = { 0, 0.5e-6, TSC_CAL_READ_JITTER_NS * 1e-9 };
+    UINT64      estimate;
+    UINT32      ppm;
+    double      start, err_ppm, took, max_took = 0, max_ppm = 0;
+    size_t      i, j;
+    int         run, bad = 0;
+
+    for (i = 0; i < sizeof(tsc_hz) / sizeof(tsc_hz[0]); i++) {
+        for (j = 0; j < sizeof(jitter_s) / sizeof(jitter_s[0]); j++) {
+            for (run = 0; run < RUNS; run++) {
+                sim_time         = 1.0 + run * 0.37;
+                sim_tsc_hz       = tsc_hz[i];
+                sim_counter_hz   = counter_hz;
+                sim_read_s       = read_s;
+                sim_jitter_s     = jitter_s[j];
+                sim_stuck        = 0;
+                // Start some runs just below the wrap around
+                sim_counter_base = (run & 1) ? (mask - 1000) - (UINT32) (sim_time * counter_hz) : (UINT32) rand();
+
+                start    = sim_time;
+                ppm      = 0;
+                estimate = CalibrateTscAgainstCounter(read_sim_counter, 0, (UINT64) counter_hz,
+                                                      mask, &ppm);
+                took     = sim_time - start;
+                err_ppm  = fabs((double) estimate - tsc_hz[i]) * 1e6 / tsc_hz[i];
+
+                if (estimate == 0 || err_ppm > ppm) {
+                    printf("  %s: TSC %.1fGHz, jitter %.1fus: %llu Hz is %.0f ppm off, bound %u ppm\n",
+                           name, tsc_hz[i] / 1e9, jitter_s[j] * 1e6,
+                           (unsigned long long) estimate, err_ppm, ppm);
+                    bad++;
+                }
+                if (took > max_took)
+                    max_took = took;
+                if (err_ppm > max_ppm)
+                    max_ppm = err_ppm;
+            }
+        }
+    }
+
+    // A counter that never ticks
+    sim_stuck = 1;
+    sim_tsc_hz = 3.0e9;
+    start = sim_time;
+    if (CalibrateTscAgainstCounter(read_sim_counter, 0, (UINT64) counter_hz, mask, &ppm) != 0 ||
+        (sim_time - start) * sim_tsc_hz > 2.0 * TSC_CAL_STUCK_LIMIT) {
+        printf("  %s: stopped counter not given up\n", name);
+        bad++;
+    }
+
+    printf("%-10s calibration: longest %.1f ms, largest error %.0f ppm, %d failures\n",
+           name, max_took * 1e3, max_ppm, bad);
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    int         bad = 0;
+
+    srand(1);
+
+    bad += check_cpuid();
+    bad += check_settled();
+    bad += check_counter("PM timer", 3579545.0, 0xFFFFFF, 1.0e-6);
+    bad += check_counter("HPET", 14318180.0, 0xFFFFFFFF, 0.5e-6);
+    bad += check_counter("HPET 24MHz", 24000000.0, 0xFFFFFFFF, 0.5e-6);
+
+    if (sizeof(mTscSourceNames) / sizeof(mTscSourceNames[0]) != TSC_SOURCE_STALL + 1) {
+        printf("mTscSourceNames does not name every TSC_SOURCE\n");
+        bad++;
+    }
+
+    return bad != 0;
+}
+
+// EOF
@@ -67,7 +67,13 @@
 #define MINILZO_CFG_SKIP_LZO1X_DECOMPRESS 1
 #define MINILZO_CFG_SKIP_LZO1X_1_COMPRESS 1
 #include "minilzo.c"
+#ifdef HOST_POSIX
+/* the host test programs mount a single image, there are no other disks to scan */
+static struct fsw_volume *clone_dummy_volume(struct fsw_volume *vol) { return NULL; }
+static int scan_disks(int (*hook)(struct fsw_volume *, struct fsw_volume *), struct fsw_volume *master) { return -1; }
+#else
 #include "scandisk.c"
+#endif
 
 #define BTRFS_DEFAULT_BLOCK_SIZE 4096
 #define GRUB_BTRFS_SIGNATURE "_BHRfS_M"
@@ -146,6 +152,29 @@ struct fsw_btrfs_recover_cache
     BOOLEAN valid;
 };
 
+/* whole tree nodes kept per volume, keyed by logical address */
+#define BTRFS_NODE_CACHE_SIZE 16
+struct fsw_btrfs_node_cache
+{
+    uint64_t addr;
+    uint32_t last_use;
+    int busy;
+    uint8_t *data;
+};
+
+/* decompressed file extents kept per volume, keyed by tree, inode and offset */
+#define BTRFS_EXTENT_CACHE_SIZE 8
+#define BTRFS_EXTENT_CACHE_MAX  0x20000
+struct fsw_btrfs_extent_cache
+{
+    uint64_t tree;
+    uint64_t ino;
+    uint64_t start;
+    uint32_t size;
+    uint32_t last_use;
+    uint8_t *data;
+};
+
 struct fsw_btrfs_volume
 {
     struct fsw_volume g;            //!< Generic volume structure
@@ -161,6 +190,7 @@ struct fsw_btrfs_volume
     unsigned num_devices;
     unsigned sectorshift;
     unsigned sectorsize;
+    unsigned nodesize;
     int is_master;
     int rescan_once;
 
@@ -176,6 +206,16 @@ struct fsw_btrfs_volume
     uint32_t extsize;
     struct btrfs_extent_data *extent;
     struct fsw_btrfs_recover_cache *rcache;
+
+    /* Cached tree nodes.  */
+    struct fsw_btrfs_node_cache ncache[BTRFS_NODE_CACHE_SIZE];
+    uint32_t ncache_clock;
+
+    /* Decompressed extents.  */
+    struct fsw_btrfs_extent_cache ecache[BTRFS_EXTENT_CACHE_SIZE];
+    uint32_t ecache_clock;
+    /* zstd stream workspace, allocated on first use.  */
+    void *zstd_workspace;
 };
 
 enum
@@ -388,6 +428,7 @@ static fsw_status_t btrfs_set_superblock_info(struct fsw_btrfs_volume *vol, stru
     vol->total_bytes = fsw_u64_le_swap(sb->total_bytes);
     vol->bytes_used = fsw_u64_le_swap(sb->bytes_used);
 
+    vol->nodesize = fsw_u32_le_swap(sb->nodesize);
     vol->sectorshift = 0;
     vol->sectorsize = fsw_u32_le_swap(sb->sectorsize);
     for(i=9; i<20; i++) {
@@ -511,13 +552,71 @@ static fsw_status_t save_ref (struct fsw_btrfs_leaf_descriptor *desc,
     return FSW_SUCCESS;
 }
 
+/*
+ * Get a whole tree node, from the node cache or from disk. The returned buffer
+ * stays valid until the next call, which may recycle it.
+ */
+static fsw_status_t btrfs_get_node (struct fsw_btrfs_volume *vol, uint64_t addr,
+        int rdepth, int cache_level, struct btrfs_header **node_out)
+{
+    struct fsw_btrfs_node_cache *nc, *victim = NULL;
+    struct btrfs_header *head;
+    fsw_status_t err;
+    unsigned i;
+
+    for (i = 0; i < BTRFS_NODE_CACHE_SIZE; i++)
+    {
+        nc = &vol->ncache[i];
+        if (nc->data && !nc->busy && nc->addr == addr)
+        {
+            nc->last_use = ++vol->ncache_clock;
+            *node_out = (struct btrfs_header *) nc->data;
+            return FSW_SUCCESS;
+        }
+        if (nc->busy)
+            continue;
+        if (!victim || !nc->data || (victim->data && nc->last_use < victim->last_use))
+            victim = nc;
+    }
+    if (!victim)
+        return FSW_VOLUME_CORRUPTED;
+
+    if (!victim->data)
+    {
+        victim->data = AllocatePool (vol->nodesize);
+        if (!victim->data)
+            return FSW_OUT_OF_MEMORY;
+    }
+
+    /* the chunk lookup may recurse into here, keep this slot for ourselves */
+    victim->addr = ~0ULL;
+    victim->busy = 1;
+    err = fsw_btrfs_read_logical (vol, addr, victim->data, vol->nodesize,
+            rdepth + 1, cache_level);
+    victim->busy = 0;
+    if (err)
+        return err;
+
+    head = (struct btrfs_header *) victim->data;
+    if ((uint64_t) fsw_u32_le_swap (head->nitems)
+            * (head->level ? sizeof (struct btrfs_internal_node) : sizeof (struct btrfs_leaf_node))
+            > vol->nodesize - sizeof (struct btrfs_header))
+        return FSW_VOLUME_CORRUPTED;
+
+    victim->addr = addr;
+    victim->last_use = ++vol->ncache_clock;
+    *node_out = head;
+    return FSW_SUCCESS;
+}
+
 static int next (struct fsw_btrfs_volume *vol,
         struct fsw_btrfs_leaf_descriptor *desc,
         uint64_t * outaddr, fsw_size_t * outsize,
         struct btrfs_key *key_out)
 {
     fsw_status_t err;
-    struct btrfs_leaf_node leaf;
+    struct btrfs_header *head;
+    struct btrfs_leaf_node *leaf;
 
     for (; desc->depth > 0; desc->depth--)
     {
@@ -530,37 +629,32 @@ static int next (struct fsw_btrfs_volume *vol,
         return 0;
     while (!desc->data[desc->depth - 1].leaf)
     {
-        struct btrfs_internal_node node;
-        struct btrfs_header head;
-        fsw_memzero(&node, sizeof (node));
-
-        err = fsw_btrfs_read_logical (vol, desc->data[desc->depth - 1].iter
-                * sizeof (node)
-                + sizeof (struct btrfs_header)
-                + desc->data[desc->depth - 1].addr,
-                &node, sizeof (node), 0, 1);
+        struct btrfs_internal_node *node;
+        uint64_t addr;
+
+        err = btrfs_get_node (vol, desc->data[desc->depth - 1].addr, 0, 1, &head);
         if (err)
             return -err;
+        node = (struct btrfs_internal_node *) (head + 1) + desc->data[desc->depth - 1].iter;
+        addr = fsw_u64_le_swap (node->addr);
 
-        err = fsw_btrfs_read_logical (vol, fsw_u64_le_swap (node.addr),
-                &head, sizeof (head), 0, 1);
+        err = btrfs_get_node (vol, addr, 0, 1, &head);
         if (err)
             return -err;
 
-        save_ref (desc, fsw_u64_le_swap (node.addr), 0,
-                fsw_u32_le_swap (head.nitems), !head.level);
+        err = save_ref (desc, addr, 0,
+                fsw_u32_le_swap (head->nitems), !head->level);
+        if (err)
+            return -err;
     }
-    err = fsw_btrfs_read_logical (vol, desc->data[desc->depth - 1].iter
-            * sizeof (leaf)
-            + sizeof (struct btrfs_header)
-            + desc->data[desc->depth - 1].addr, &leaf,
-            sizeof (leaf), 0, 1);
+    err = btrfs_get_node (vol, desc->data[desc->depth - 1].addr, 0, 1, &head);
     if (err)
         return -err;
-    *outsize = fsw_u32_le_swap (leaf.size);
+    leaf = (struct btrfs_leaf_node *) (head + 1) + desc->data[desc->depth - 1].iter;
+    *outsize = fsw_u32_le_swap (leaf->size);
     *outaddr = desc->data[desc->depth - 1].addr + sizeof (struct btrfs_header)
-        + fsw_u32_le_swap (leaf.offset);
-    *key_out = leaf.key;
+        + fsw_u32_le_swap (leaf->offset);
+    *key_out = leaf->key;
     return 1;
 }
 
@@ -596,119 +690,81 @@ static fsw_status_t lower_bound (struct fsw_btrfs_volume *vol,
     while (1)
     {
         fsw_status_t err;
-        struct btrfs_header head;
-        fsw_memzero(&head, sizeof (head));
+        struct btrfs_header *head;
+        unsigned nitems, lo, hi, mid;
 
-reiter:
         depth++;
-        /* FIXME: preread few nodes into buffer. */
-        err = fsw_btrfs_read_logical (vol, addr, &head, sizeof (head),
-                rdepth + 1, depth2cache(rdepth));
+        err = btrfs_get_node (vol, addr, rdepth, depth2cache(rdepth), &head);
         if (err)
             return err;
-        addr += sizeof (head);
-        if (head.level)
-        {
-            unsigned i;
-            struct btrfs_internal_node node, node_last;
-            int have_last = 0;
-            fsw_memzero (&node_last, sizeof (node_last));
-            for (i = 0; i < fsw_u32_le_swap (head.nitems); i++)
-            {
-                err = fsw_btrfs_read_logical (vol, addr + i * sizeof (node),
-                        &node, sizeof (node), rdepth + 1, depth2cache(rdepth));
-                if (err)
-                    return err;
+        nitems = fsw_u32_le_swap (head->nitems);
 
-                DPRINT (L"btrfs: internal node (depth %d) %lx %x %lx\n", depth,
-                        node.key.object_id, node.key.type,
-                        node.key.offset);
+        /* find the last item with a key not above key_in */
+        lo = 0;
+        hi = nitems;
+        if (head->level)
+        {
+            struct btrfs_internal_node *nodes = (struct btrfs_internal_node *) (head + 1);
 
-                if (key_cmp (&node.key, key_in) == 0)
-                {
-                    err = FSW_SUCCESS;
-                    if (desc)
-                        err = save_ref (desc, addr - sizeof (head), i,
-                                fsw_u32_le_swap (head.nitems), 0);
-                    if (err)
-                        return err;
-                    addr = fsw_u64_le_swap (node.addr);
-                    goto reiter;
-                }
-                if (key_cmp (&node.key, key_in) > 0)
-                    break;
-                fsw_memcpy (&node_last, &node, sizeof(node_last));
-                have_last = 1;
+            while (lo < hi)
+            {
+                mid = lo + (hi - lo) / 2;
+                if (key_cmp (&nodes[mid].key, key_in) <= 0)
+                    lo = mid + 1;
+                else
+                    hi = mid;
             }
-            if (have_last)
+
+            if (lo > 0)
             {
+                DPRINT (L"btrfs: internal node (depth %d) %lx %x %lx\n", depth,
+                        nodes[lo - 1].key.object_id, nodes[lo - 1].key.type,
+                        nodes[lo - 1].key.offset);
                 err = FSW_SUCCESS;
                 if (desc)
-                    err = save_ref (desc, addr - sizeof (head), i - 1,
-                            fsw_u32_le_swap (head.nitems), 0);
+                    err = save_ref (desc, addr, lo - 1, nitems, 0);
                 if (err)
                     return err;
-                addr = fsw_u64_le_swap (node_last.addr);
-                goto reiter;
+                addr = fsw_u64_le_swap (nodes[lo - 1].addr);
+                continue;
             }
             *outsize = 0;
             *outaddr = 0;
             fsw_memzero (key_out, sizeof (*key_out));
             if (desc)
-                return save_ref (desc, addr - sizeof (head), -1,
-                        fsw_u32_le_swap (head.nitems), 0);
+                return save_ref (desc, addr, -1, nitems, 0);
             return FSW_SUCCESS;
         }
         {
-            unsigned i;
-            struct btrfs_leaf_node leaf, leaf_last;
-            int have_last    = 0;
-            leaf_last.size   = 0;
-            leaf_last.offset = 0;
-            for (i = 0; i < fsw_u32_le_swap (head.nitems); i++)
-            {
-                err = fsw_btrfs_read_logical (vol, addr + i * sizeof (leaf),
-                        &leaf, sizeof (leaf), rdepth + 1, depth2cache(rdepth));
-                if (err)
-                    return err;
-
-                DPRINT (L"btrfs: leaf (depth %d) %lx %x %lx\n", depth,
-                        leaf.key.object_id, leaf.key.type, leaf.key.offset);
+            struct btrfs_leaf_node *leaves = (struct btrfs_leaf_node *) (head + 1);
 
-                if (key_cmp (&leaf.key, key_in) == 0)
-                {
-                    fsw_memcpy (key_out, &leaf.key, sizeof (*key_out));
-                    *outsize = fsw_u32_le_swap (leaf.size);
-                    *outaddr = addr + fsw_u32_le_swap (leaf.offset);
-                    if (desc)
-                        return save_ref (desc, addr - sizeof (head), i,
-                                fsw_u32_le_swap (head.nitems), 1);
-                    return FSW_SUCCESS;
-                }
-
-                if (key_cmp (&leaf.key, key_in) > 0)
-                    break;
-
-                have_last = 1;
-                leaf_last = leaf;
+            while (lo < hi)
+            {
+                mid = lo + (hi - lo) / 2;
+                if (key_cmp (&leaves[mid].key, key_in) <= 0)
+                    lo = mid + 1;
+                else
+                    hi = mid;
             }
 
-            if (have_last)
+            if (lo > 0)
             {
-                fsw_memcpy (key_out, &leaf_last.key, sizeof (*key_out));
-                *outsize = fsw_u32_le_swap (leaf_last.size);
-                *outaddr = addr + fsw_u32_le_swap (leaf_last.offset);
+                DPRINT (L"btrfs: leaf (depth %d) %lx %x %lx\n", depth,
+                        leaves[lo - 1].key.object_id, leaves[lo - 1].key.type,
+                        leaves[lo - 1].key.offset);
+                fsw_memcpy (key_out, &leaves[lo - 1].key, sizeof (*key_out));
+                *outsize = fsw_u32_le_swap (leaves[lo - 1].size);
+                *outaddr = addr + sizeof (struct btrfs_header)
+                    + fsw_u32_le_swap (leaves[lo - 1].offset);
                 if (desc)
-                    return save_ref (desc, addr - sizeof (head), i - 1,
-                            fsw_u32_le_swap (head.nitems), 1);
+                    return save_ref (desc, addr, lo - 1, nitems, 1);
                 return FSW_SUCCESS;
             }
             *outsize = 0;
             *outaddr = 0;
             fsw_memzero (key_out, sizeof (*key_out));
             if (desc)
-                return save_ref (desc, addr - sizeof (head), -1,
-                        fsw_u32_le_swap (head.nitems), 1);
+                return save_ref (desc, addr, -1, nitems, 1);
             return FSW_SUCCESS;
         }
     }
@@ -867,7 +923,7 @@ static struct fsw_btrfs_recover_cache *get_recover_cache(struct fsw_btrfs_volume
 	if(fsw_alloc_zero(sizeof (struct fsw_btrfs_recover_cache) * RECOVER_CACHE_SIZE, (void **) &vol->rcache) != FSW_SUCCESS)
 	    return NULL;
     }
-#ifdef __MAKEWITH_TIANO
+#if defined(__MAKEWITH_TIANO) || defined(HOST_POSIX)
     unsigned hash;
 #else
     UINTN hash;
@@ -1322,6 +1378,9 @@ static fsw_status_t fsw_btrfs_volume_mount(struct fsw_volume *volg) {
     if(vol->sectorshift == 0)
         return FSW_UNSUPPORTED;
 
+    if(vol->nodesize < sizeof (struct btrfs_header) || vol->nodesize > 0x10000)
+        return FSW_UNSUPPORTED;
+
     if(vol->num_devices >= BTRFS_MAX_NUM_DEVICES)
         return FSW_UNSUPPORTED;
 
@@ -1398,10 +1457,18 @@ static void fsw_btrfs_volume_free(struct fsw_volume *volg)
     }
     if(vol->extent)
         FreePool (vol->extent);
+    for(i = 0; i < BTRFS_NODE_CACHE_SIZE; i++)
+        if(vol->ncache[i].data)
+            FreePool (vol->ncache[i].data);
+    for(i = 0; i < BTRFS_EXTENT_CACHE_SIZE; i++)
+        if(vol->ecache[i].data)
+            FreePool (vol->ecache[i].data);
+    if(vol->zstd_workspace)
+        FreePool (vol->zstd_workspace);
     if(vol->rcache) {
 	for(i = 0; i < RECOVER_CACHE_SIZE; i++)
-	    if(vol->rcache->buffer)
-		FreePool(vol->rcache->buffer);
+	    if(vol->rcache[i].buffer)
+		FreePool(vol->rcache[i].buffer);
         FreePool (vol->rcache);
     }
 }
@@ -1600,17 +1667,92 @@ typedef fsw_ssize_t (*decompressor_t)(char *ibuf, fsw_size_t isize, grub_off_t o
 static decompressor_t btrfs_decompressor_table[GRUB_BTRFS_COMPRESSION_MAX] = {
 	grub_zlib_decompress,
 	grub_btrfs_lzo_decompress,
-	zstd_decompress,
+	NULL, /* zstd keeps its stream per volume */
 };
 
-static fsw_ssize_t btrfs_decompress(uint8_t comp,
+static fsw_ssize_t btrfs_decompress(struct fsw_btrfs_volume *vol, uint8_t comp,
 	char *ibuf, fsw_size_t isize,
 	grub_off_t off,
         char *obuf, fsw_size_t osize)
 {
+	if (comp == GRUB_BTRFS_COMPRESSION_ZSTD)
+		return zstd_decompress(&vol->zstd_workspace, ibuf, isize, off, obuf, osize);
 	return btrfs_decompressor_table[comp-1](ibuf, isize, off, obuf, osize);
 }
 
+/*
+ * Decompress the whole current extent (file bytes extstart..extend) through the
+ * extent cache, so seeking around in a compressed file decompresses each extent
+ * only once. The returned buffer stays valid until the next call.
+ */
+static fsw_status_t btrfs_get_decompressed (struct fsw_btrfs_volume *vol,
+        uint8_t **data_out)
+{
+    struct fsw_btrfs_extent_cache *ec, *victim = NULL;
+    uint32_t size = (uint32_t) (vol->extend - vol->extstart);
+    fsw_ssize_t ret;
+    fsw_status_t err;
+    unsigned i;
+
+    for (i = 0; i < BTRFS_EXTENT_CACHE_SIZE; i++)
+    {
+        ec = &vol->ecache[i];
+        if (ec->size && ec->tree == vol->exttree && ec->ino == vol->extino
+                && ec->start == vol->extstart && ec->size == size)
+        {
+            ec->last_use = ++vol->ecache_clock;
+            *data_out = ec->data;
+            return FSW_SUCCESS;
+        }
+        if (!victim || (victim->size && (!ec->size || ec->last_use < victim->last_use)))
+            victim = ec;
+    }
+
+    if (!victim->data)
+    {
+        victim->data = AllocatePool (BTRFS_EXTENT_CACHE_MAX);
+        if (!victim->data)
+            return FSW_OUT_OF_MEMORY;
+    }
+    victim->size = 0;
+
+    if (vol->extent->type == GRUB_BTRFS_EXTENT_INLINE)
+        ret = btrfs_decompress (vol, vol->extent->compression,
+                vol->extent->inl, vol->extsize -
+                ((uint8_t *) vol->extent->inl - (uint8_t *) vol->extent),
+                0, (char *) victim->data, size);
+    else
+    {
+        char *tmp;
+        uint64_t zsize;
+
+        zsize = fsw_u64_le_swap (vol->extent->compressed_size);
+        tmp = AllocatePool (zsize);
+        if (!tmp)
+            return FSW_OUT_OF_MEMORY;
+        err = fsw_btrfs_read_logical (vol, fsw_u64_le_swap (vol->extent->laddr), tmp, zsize, 0, 0);
+        if (err)
+        {
+            FreePool (tmp);
+            return FSW_VOLUME_CORRUPTED;
+        }
+        ret = btrfs_decompress (vol, vol->extent->compression, tmp, zsize,
+                fsw_u64_le_swap (vol->extent->offset),
+                (char *) victim->data, size);
+        FreePool (tmp);
+    }
+    if (ret != (fsw_ssize_t) size)
+        return FSW_VOLUME_CORRUPTED;
+
+    victim->tree = vol->exttree;
+    victim->ino = vol->extino;
+    victim->start = vol->extstart;
+    victim->size = size;
+    victim->last_use = ++vol->ecache_clock;
+    *data_out = victim->data;
+    return FSW_SUCCESS;
+}
+
 static fsw_status_t fsw_btrfs_get_extent(struct fsw_volume *volg, struct fsw_dnode *dnog,
         struct fsw_extent *extent)
 {
@@ -1703,7 +1845,22 @@ static fsw_status_t fsw_btrfs_get_extent(struct fsw_volume *volg, struct fsw_dno
     }
 
     count = ( csize + vol->sectorsize - 1) >> vol->sectorshift;
-    switch (vol->extent->type)
+    if (vol->extent->compression != GRUB_BTRFS_COMPRESSION_NONE
+            && (vol->extent->type == GRUB_BTRFS_EXTENT_INLINE
+                || (vol->extent->type == GRUB_BTRFS_EXTENT_REGULAR && vol->extent->laddr))
+            && vol->extend - vol->extstart <= BTRFS_EXTENT_CACHE_MAX)
+    {
+        uint8_t *data;
+
+        err = btrfs_get_decompressed (vol, &data);
+        if (err)
+            return err;
+        buf = AllocatePool( count << vol->sectorshift);
+        if(!buf)
+            return FSW_OUT_OF_MEMORY;
+        fsw_memcpy (buf, data + extoff, csize);
+    }
+    else switch (vol->extent->type)
     {
         case GRUB_BTRFS_EXTENT_INLINE:
             buf = AllocatePool( count << vol->sectorshift);
@@ -1711,7 +1868,7 @@ static fsw_status_t fsw_btrfs_get_extent(struct fsw_volume *volg, struct fsw_dno
                 return FSW_OUT_OF_MEMORY;
             if (vol->extent->compression == GRUB_BTRFS_COMPRESSION_NONE)
                 fsw_memcpy (buf, vol->extent->inl + extoff, csize);
-            else if (btrfs_decompress (vol->extent->compression,
+            else if (btrfs_decompress (vol, vol->extent->compression,
 				vol->extent->inl, vol->extsize -
                             ((uint8_t *) vol->extent->inl
                              - (uint8_t *) vol->extent),
@@ -1772,7 +1929,7 @@ static fsw_status_t fsw_btrfs_get_extent(struct fsw_volume *volg, struct fsw_dno
                     return FSW_OUT_OF_MEMORY;
                 }
 
-		ret = btrfs_decompress ( vol->extent->compression,
+		ret = btrfs_decompress (vol, vol->extent->compression,
 			tmp, zsize,
 			extoff + fsw_u64_le_swap (vol->extent->offset),
 			buf, csize);
@@ -1780,7 +1937,7 @@ static fsw_status_t fsw_btrfs_get_extent(struct fsw_volume *volg, struct fsw_dno
                 FreePool (tmp);
 
                 if (ret != (fsw_ssize_t) csize) {
-                    FreePool(tmp);
+                    FreePool(buf);
                     return -FSW_VOLUME_CORRUPTED;
                 }
 
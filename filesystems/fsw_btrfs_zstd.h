@@ -51,7 +51,15 @@ static inline void put_unaligned_le16(uint16_t v, void *s)
 #define ZSTD_BTRFS_MAX_INPUT (1 << ZSTD_BTRFS_MAX_WINDOWLOG)
 
 
-static fsw_ssize_t zstd_decompress(char *data_in, fsw_size_t srclen,
+/*
+ * Decode a btrfs zstd frame straight into data_out, starting start_byte bytes
+ * into the frame, and stop once destlen bytes are produced. The skipped head
+ * is decoded into data_out as well, which is only a sink for the stream, and
+ * frames that fit are decoded in a single pass without the window copy.
+ * The stream workspace is allocated on first use and kept in *workspace_p
+ * for the next call; the caller frees it.
+ */
+static fsw_ssize_t zstd_decompress(void **workspace_p, char *data_in, fsw_size_t srclen,
 		grub_off_t start_byte,
 		char *data_out, fsw_size_t destlen)
 {
@@ -62,23 +70,27 @@ static fsw_ssize_t zstd_decompress(char *data_in, fsw_size_t srclen,
 	size_t ret2;
 
 	size_t workspace_size = ZSTD_DStreamWorkspaceBound(ZSTD_BTRFS_MAX_INPUT);
-	void * workspace;
 
 	in_buf.src = data_in;
 	in_buf.pos = 0;
 	in_buf.size = srclen;
 
-	out_buf.dst = NULL;
+	out_buf.dst = data_out;
 	out_buf.pos = 0;
+	out_buf.size = 0;
 
-	workspace = AllocatePool(workspace_size);
+	if(destlen == 0)
+		return 0;
 
-	if(!workspace) {
-		ret = -FSW_OUT_OF_MEMORY;
-		goto finish;
+	if(*workspace_p == NULL) {
+		*workspace_p = AllocatePool(workspace_size);
+		if(!*workspace_p) {
+			ret = -FSW_OUT_OF_MEMORY;
+			goto finish;
+		}
 	}
 
-	stream = ZSTD_initDStream(ZSTD_BTRFS_MAX_INPUT, workspace, workspace_size);
+	stream = ZSTD_initDStream(ZSTD_BTRFS_MAX_INPUT, *workspace_p, workspace_size);
 	if (!stream) {
 		DPRINT(L"BTRFS: ZSTD_initDStream failed\n");
 		ret = -FSW_OUT_OF_MEMORY;
@@ -86,9 +98,7 @@ static fsw_ssize_t zstd_decompress(char *data_in, fsw_size_t srclen,
 	}
 
 	while(start_byte > 0) {
-	    out_buf.size = start_byte < PAGE_SIZE ? start_byte : PAGE_SIZE;
-	    if(out_buf.dst == NULL)
-		out_buf.dst = AllocatePool(out_buf.size);
+	    out_buf.size = start_byte < destlen ? start_byte : destlen;
 	    out_buf.pos = 0;
 
 	    ret2 = ZSTD_decompressStream(stream, &out_buf, &in_buf);
@@ -107,10 +117,6 @@ static fsw_ssize_t zstd_decompress(char *data_in, fsw_size_t srclen,
 	    start_byte -= out_buf.pos;
 	}
 
-	if(out_buf.dst)
-		FreePool(out_buf.dst);
-
-	out_buf.dst = data_out;
 	out_buf.size = destlen;
 	out_buf.pos = 0;
 
@@ -123,10 +129,6 @@ static fsw_ssize_t zstd_decompress(char *data_in, fsw_size_t srclen,
 
 	ret = destlen;
 finish:
-	if(out_buf.dst && out_buf.dst != data_out)
-		FreePool(out_buf.dst);
-	if(workspace)
-		FreePool(workspace);
 	if (out_buf.pos < destlen)
 		memset(data_out + out_buf.pos, 0, destlen - out_buf.pos);
 	return ret;
@@ -38,14 +38,78 @@
  */
 
 #include "fsw_core.h"
+#ifndef HOST_POSIX
 #include "fsw_efi.h"
+#endif
 
 
 // functions
 
 static void fsw_blockcache_free(struct fsw_volume *vol);
+static void fsw_dcache_free(struct fsw_volume *vol);
 
-#define MAX_CACHE_LEVEL (5)
+#define MAX_CACHE_LEVEL FSW_MAX_CACHE_LEVEL
+#define FSW_DIRECT_READ_MAX_BYTES (0x40000000)
+
+/**
+ * Map a physical block number to its block cache hash bucket.
+ */
+
+static fsw_u32 fsw_blockcache_hash(fsw_u64 phys_bno)
+{
+    return ((fsw_u32) phys_bno ^ (fsw_u32) FSW_U64_SHR(phys_bno, 32)) & (FSW_BCACHE_HASH_SIZE - 1);
+}
+
+/**
+ * Remove a block cache entry from its hash bucket.
+ */
+
+static void fsw_blockcache_hash_unlink(struct fsw_volume *vol, struct fsw_blockcache *bc)
+{
+    struct fsw_blockcache **link;
+
+    for (link = &vol->bcache[fsw_blockcache_hash(bc->phys_bno)]; *link != NULL; link = &(*link)->hash_next) {
+        if (*link == bc) {
+            *link = bc->hash_next;
+            break;
+        }
+    }
+    bc->hash_next = NULL;
+}
+
+/**
+ * Append an unreferenced block cache entry to the LRU list of its cache level.
+ */
+
+static void fsw_blockcache_lru_append(struct fsw_volume *vol, struct fsw_blockcache *bc)
+{
+    bc->lru_next = NULL;
+    bc->lru_prev = vol->bcache_lru_tail[bc->cache_level];
+    if (bc->lru_prev != NULL)
+        bc->lru_prev->lru_next = bc;
+    else
+        vol->bcache_lru_head[bc->cache_level] = bc;
+    vol->bcache_lru_tail[bc->cache_level] = bc;
+}
+
+/**
+ * Remove a block cache entry from the LRU list of its cache level. Called when an
+ * unreferenced entry is referenced again or recycled.
+ */
+
+static void fsw_blockcache_lru_unlink(struct fsw_volume *vol, struct fsw_blockcache *bc)
+{
+    if (bc->lru_prev != NULL)
+        bc->lru_prev->lru_next = bc->lru_next;
+    else
+        vol->bcache_lru_head[bc->cache_level] = bc->lru_next;
+    if (bc->lru_next != NULL)
+        bc->lru_next->lru_prev = bc->lru_prev;
+    else
+        vol->bcache_lru_tail[bc->cache_level] = bc->lru_prev;
+    bc->lru_prev = NULL;
+    bc->lru_next = NULL;
+}
 
 /**
  * Mount a volume with a given file system driver. This function is called by the
@@ -82,6 +146,7 @@ fsw_status_t fsw_mount(void *host_data,
     vol->host_table     = host_table;
     vol->fstype_table   = fstype_table;
     vol->host_string_type = host_table->native_string_type;
+    vol->bcache_max_bytes = FSW_BCACHE_MAX_BYTES;
 
     // let the fs driver mount the file system
     status = vol->fstype_table->volume_mount(vol);
@@ -108,6 +173,9 @@ errorexit:
 
 void fsw_unmount(struct fsw_volume *vol)
 {
+    // cached lookups hold references on their dnodes
+    fsw_dcache_free(vol);
+
     if (vol->root)
         fsw_dnode_release(vol->root);
     // TODO: check that no other dnodes are still around
@@ -136,8 +204,8 @@ fsw_status_t fsw_volume_stat(struct fsw_volume *vol, struct fsw_volume_stat *sb)
  * Usually both sizes will be the same but there may be file systems that need to access
  * metadata at a smaller block size than the allocation unit for files.
  *
- * Calling this function causes the block cache to be dropped. All pointers returned
- * from fsw_block_get become invalid. This function should only be called while
+ * Calling this function causes the block cache and the directory entry cache to be
+ * dropped. All pointers returned from fsw_block_get become invalid. This function should only be called while
  * mounting the file system, not as a part of file access operations.
  *
  * Both sizes are measured in bytes, must be powers of 2, and must not be smaller
@@ -149,8 +217,9 @@ void fsw_set_blocksize(struct fsw_volume *vol, fsw_u32 phys_blocksize, fsw_u32 l
     // TODO: Check the sizes. Both must be powers of 2. log_blocksize must not be smaller than
     //  phys_blocksize.
 
-    // drop core block cache if present
+    // drop core block cache and remembered lookups if present
     fsw_blockcache_free(vol);
+    fsw_dcache_free(vol);
 
     // signal host driver to drop caches etc.
     vol->host_table->change_blocksize(vol,
@@ -174,6 +243,10 @@ void fsw_set_blocksize(struct fsw_volume *vol, fsw_u32 phys_blocksize, fsw_u32 l
  *  - 2: File system metadata
  *  - 3..5: File system metadata with a high rate of access
  *
+ * Cached blocks are found through a hash table. Once the cache has grown to
+ * vol->bcache_max_bytes, the least recently used unreferenced block of the lowest
+ * level is recycled.
+ *
  * If this function returns successfully, the returned data pointer is valid until the
  * caller calls fsw_block_release.
  */
@@ -181,8 +254,9 @@ void fsw_set_blocksize(struct fsw_volume *vol, fsw_u32 phys_blocksize, fsw_u32 l
 fsw_status_t fsw_block_get(struct VOLSTRUCTNAME *vol, fsw_u64 phys_bno, fsw_u32 cache_level, void **buffer_out)
 {
     fsw_status_t    status;
-    fsw_u32         i, discard_level, new_bcache_size;
-    struct fsw_blockcache *new_bcache;
+    fsw_u32         level, max_entries;
+    struct fsw_blockcache **bucket;
+    struct fsw_blockcache *bc;
 
     // TODO: allow the host driver to do its own caching; just call through if
     //  the appropriate function pointers are set
@@ -190,74 +264,72 @@ fsw_status_t fsw_block_get(struct VOLSTRUCTNAME *vol, fsw_u64 phys_bno, fsw_u32
     if (cache_level > MAX_CACHE_LEVEL)
         cache_level = MAX_CACHE_LEVEL;
 
+    // create the hash table on first use
+    if (vol->bcache == NULL) {
+        status = fsw_alloc_zero(FSW_BCACHE_HASH_SIZE * sizeof (struct fsw_blockcache *), (void **) &vol->bcache);
+        if (status)
+            return status;
+    }
+
     // check block cache
-    for (i = 0; i < vol->bcache_size; i++) {
-        if (vol->bcache[i].phys_bno == phys_bno) {
+    bucket = &vol->bcache[fsw_blockcache_hash(phys_bno)];
+    for (bc = *bucket; bc != NULL; bc = bc->hash_next) {
+        if (bc->phys_bno == phys_bno) {
             // cache hit!
-            if (vol->bcache[i].cache_level < cache_level)
-                vol->bcache[i].cache_level = cache_level;  // promote the entry
-            vol->bcache[i].refcount++;
-            *buffer_out = vol->bcache[i].data;
+            vol->bcache_hits++;
+            if (bc->refcount == 0)
+                fsw_blockcache_lru_unlink(vol, bc);
+            if (bc->cache_level < cache_level)
+                bc->cache_level = cache_level;  // promote the entry
+            bc->refcount++;
+            *buffer_out = bc->data;
             return FSW_SUCCESS;
         }
     }
 
-    // find a free entry in the cache table
-    for (i = 0; i < vol->bcache_size; i++) {
-        if (vol->bcache[i].phys_bno == (fsw_u64)FSW_INVALID_BNO)
-            break;
-    }
-    if (i >= vol->bcache_size) {
-        for (discard_level = 0; discard_level <= MAX_CACHE_LEVEL; discard_level++) {
-            for (i = 0; i < vol->bcache_size; i++) {
-                if (vol->bcache[i].refcount == 0 && vol->bcache[i].cache_level <= discard_level)
-                    break;
-            }
-            if (i < vol->bcache_size)
+    // once the memory ceiling is reached, recycle the least recently used
+    //  unreferenced entry, starting with the least important level
+    bc = NULL;
+    max_entries = vol->bcache_max_bytes / vol->phys_blocksize;
+    if (max_entries < 16)
+        max_entries = 16;
+    if (vol->bcache_size >= max_entries) {
+        for (level = 0; level <= MAX_CACHE_LEVEL; level++) {
+            bc = vol->bcache_lru_head[level];
+            if (bc != NULL) {
+                fsw_blockcache_lru_unlink(vol, bc);
+                fsw_blockcache_hash_unlink(vol, bc);
                 break;
+            }
         }
     }
-    if (i >= vol->bcache_size) {
-        // enlarge / create the cache
-        if (vol->bcache_size < 16)
-            new_bcache_size = 16;
-        else
-            new_bcache_size = vol->bcache_size << 1;
-        status = fsw_alloc(new_bcache_size * sizeof (struct fsw_blockcache), &new_bcache);
+    if (bc == NULL) {
+        // below the ceiling, or all entries are in use: add a new entry
+        status = fsw_alloc(sizeof (struct fsw_blockcache) + vol->phys_blocksize, &bc);
         if (status)
             return status;
-        if (vol->bcache_size > 0)
-            fsw_memcpy(new_bcache, vol->bcache, vol->bcache_size * sizeof (struct fsw_blockcache));
-        for (i = vol->bcache_size; i < new_bcache_size; i++) {
-            new_bcache[i].refcount = 0;
-            new_bcache[i].cache_level = 0;
-            new_bcache[i].phys_bno = (fsw_u64)FSW_INVALID_BNO;
-            new_bcache[i].data = NULL;
-        }
-        i = vol->bcache_size;
-
-        // switch caches
-        if (vol->bcache != NULL)
-            fsw_free(vol->bcache);
-        vol->bcache = new_bcache;
-        vol->bcache_size = new_bcache_size;
+        bc->data = (fsw_u8 *) bc + sizeof (struct fsw_blockcache);
+        vol->bcache_size++;
     }
-    vol->bcache[i].phys_bno = (fsw_u64)FSW_INVALID_BNO;
 
     // read the data
-    if (vol->bcache[i].data == NULL) {
-        status = fsw_alloc(vol->phys_blocksize, &vol->bcache[i].data);
-        if (status)
-            return status;
-    }
-    status = vol->host_table->read_block(vol, phys_bno, vol->bcache[i].data);
-    if (status)
+    vol->bcache_misses++;
+    status = vol->host_table->read_block(vol, phys_bno, bc->data);
+    if (status) {
+        fsw_free(bc);
+        vol->bcache_size--;
         return status;
+    }
 
-    vol->bcache[i].phys_bno = phys_bno;
-    vol->bcache[i].cache_level = cache_level;
-    vol->bcache[i].refcount = 1;
-    *buffer_out = vol->bcache[i].data;
+    bc->phys_bno = phys_bno;
+    bc->cache_level = cache_level;
+    bc->refcount = 1;
+    bc->lru_prev = NULL;
+    bc->lru_next = NULL;
+    bc->hash_next = *bucket;
+    *bucket = bc;
+
+    *buffer_out = bc->data;
     return FSW_SUCCESS;
 }
 
@@ -268,15 +340,24 @@ fsw_status_t fsw_block_get(struct VOLSTRUCTNAME *vol, fsw_u64 phys_bno, fsw_u32
 
 void fsw_block_release(struct VOLSTRUCTNAME *vol, fsw_u64 phys_bno, void *buffer)
 {
-    fsw_u32 i;
+    struct fsw_blockcache *bc;
 
     // TODO: allow the host driver to do its own caching; just call through if
     //  the appropriate function pointers are set
 
+    if (vol->bcache == NULL)
+        return;
+
     // update block cache
-    for (i = 0; i < vol->bcache_size; i++) {
-        if (vol->bcache[i].phys_bno == phys_bno && vol->bcache[i].refcount > 0)
-            vol->bcache[i].refcount--;
+    for (bc = vol->bcache[fsw_blockcache_hash(phys_bno)]; bc != NULL; bc = bc->hash_next) {
+        if (bc->phys_bno == phys_bno) {
+            if (bc->refcount > 0) {
+                bc->refcount--;
+                if (bc->refcount == 0)
+                    fsw_blockcache_lru_append(vol, bc);
+            }
+            break;
+        }
     }
 }
 
@@ -288,32 +369,83 @@ void fsw_block_release(struct VOLSTRUCTNAME *vol, fsw_u64 phys_bno, void *buffer
 static void fsw_blockcache_free(struct fsw_volume *vol)
 {
     fsw_u32 i;
+    struct fsw_blockcache *bc, *next_bc;
 
-    for (i = 0; i < vol->bcache_size; i++) {
-        if (vol->bcache[i].data != NULL)
-            fsw_free(vol->bcache[i].data);
-    }
     if (vol->bcache != NULL) {
+        for (i = 0; i < FSW_BCACHE_HASH_SIZE; i++) {
+            for (bc = vol->bcache[i]; bc != NULL; bc = next_bc) {
+                next_bc = bc->hash_next;
+                fsw_free(bc);
+            }
+        }
         fsw_free(vol->bcache);
         vol->bcache = NULL;
     }
+    for (i = 0; i <= MAX_CACHE_LEVEL; i++) {
+        vol->bcache_lru_head[i] = NULL;
+        vol->bcache_lru_tail[i] = NULL;
+    }
     vol->bcache_size = 0;
+#ifndef HOST_POSIX
     fsw_efi_clear_cache();
+#endif
+}
+
+/**
+ * Map a (tree_id, dnode_id) pair to its dnode hash bucket.
+ */
+
+static fsw_u32 fsw_dnode_hash(fsw_u64 tree_id, fsw_u64 dnode_id)
+{
+    fsw_u32 h;
+
+    h = (fsw_u32) dnode_id ^ (fsw_u32) FSW_U64_SHR(dnode_id, 32);
+    h ^= ((fsw_u32) tree_id ^ (fsw_u32) FSW_U64_SHR(tree_id, 32)) * 0x9E3779B1;
+    return h & (FSW_DNODE_HASH_SIZE - 1);
 }
 
 /**
  * Add a new dnode to the list of known dnodes. This internal function is used when a
- * dnode is created to add it to the dnode list that is used to search for existing
- * dnodes by id.
+ * dnode is created to add it to the dnode list and to the hash table that is used to
+ * search for existing dnodes by id.
  */
 
 static void fsw_dnode_register(struct fsw_volume *vol, struct fsw_dnode *dno)
 {
+    struct fsw_dnode **bucket = &vol->dnode_hash[fsw_dnode_hash(dno->tree_id, dno->dnode_id)];
+
     dno->next = vol->dnode_head;
     if (vol->dnode_head != NULL)
         vol->dnode_head->prev = dno;
     dno->prev = NULL;
     vol->dnode_head = dno;
+
+    dno->hash_next = *bucket;
+    *bucket = dno;
+}
+
+/**
+ * Remove a dnode from the list and the hash table of known dnodes. This internal
+ * function is used when the last reference to a dnode is released.
+ */
+
+static void fsw_dnode_unregister(struct fsw_volume *vol, struct fsw_dnode *dno)
+{
+    struct fsw_dnode **link;
+
+    if (dno->next)
+        dno->next->prev = dno->prev;
+    if (dno->prev)
+        dno->prev->next = dno->next;
+    if (vol->dnode_head == dno)
+        vol->dnode_head = dno->next;
+
+    for (link = &vol->dnode_hash[fsw_dnode_hash(dno->tree_id, dno->dnode_id)]; *link != NULL; link = &(*link)->hash_next) {
+        if (*link == dno) {
+            *link = dno->hash_next;
+            break;
+        }
+    }
 }
 
 /**
@@ -379,7 +511,7 @@ fsw_status_t fsw_dnode_create_with_tree(struct fsw_dnode *parent_dno, fsw_u64 tr
     struct fsw_dnode *dno;
 
     // check if we already have a dnode with the same id
-    for (dno = vol->dnode_head; dno; dno = dno->next) {
+    for (dno = vol->dnode_hash[fsw_dnode_hash(tree_id, dnode_id)]; dno; dno = dno->hash_next) {
         if (dno->dnode_id == dnode_id && dno->tree_id == tree_id) {
             fsw_dnode_retain(dno);
             *dno_out = dno;
@@ -446,13 +578,8 @@ void fsw_dnode_release(struct fsw_dnode *dno)
     if (dno->refcount == 0) {
         parent_dno = dno->parent;
 
-        // de-register from volume's list
-        if (dno->next)
-            dno->next->prev = dno->prev;
-        if (dno->prev)
-            dno->prev->next = dno->next;
-        if (vol->dnode_head == dno)
-            vol->dnode_head = dno->next;
+        // de-register from volume's list and hash table
+        fsw_dnode_unregister(vol, dno);
 
         // run fstype-specific cleanup
         vol->fstype_table->dnode_free(vol, dno);
@@ -509,6 +636,202 @@ fsw_status_t fsw_dnode_stat(struct fsw_dnode *dno, struct fsw_dnode_stat *sb)
     return status;
 }
 
+/**
+ * Hash a lookup name for the directory entry cache. ASCII letters are folded to lower
+ * case so that the spellings of a name on case-insensitive file systems share a bucket;
+ * entries themselves are still compared exactly. Returns boolean false if the string
+ * type is not supported by the cache.
+ */
+
+static int fsw_dcache_hash_name(struct fsw_string *name, fsw_u32 *hash_out)
+{
+    fsw_u32         h = 2166136261U;
+    fsw_u32         c;
+    int             i;
+
+    if (name->type == FSW_STRING_TYPE_ISO88591 || name->type == FSW_STRING_TYPE_UTF8) {
+        fsw_u8 *p = (fsw_u8 *)name->data;
+
+        for (i = 0; i < name->size; i++) {
+            c = p[i];
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+            h = (h ^ c) * 16777619U;
+        }
+
+    } else if (name->type == FSW_STRING_TYPE_UTF16) {
+        fsw_u16 *p = (fsw_u16 *)name->data;
+
+        for (i = 0; i < name->len; i++) {
+            c = p[i];
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+            h = (h ^ c) * 16777619U;
+        }
+
+    } else
+        return 0;
+
+    *hash_out = h;
+    return 1;
+}
+
+/**
+ * Memory charged to a directory entry cache entry: the entry, its name and, for a
+ * positive entry, the dnode it keeps alive.
+ */
+
+static fsw_u32 fsw_dcache_cost(struct fsw_volume *vol, struct fsw_dentry *de)
+{
+    return sizeof(struct fsw_dentry) + de->name.size +
+           (de->dnode != NULL ? vol->fstype_table->dnode_struct_size : 0);
+}
+
+/**
+ * Remove an entry from the directory entry cache and free it, releasing the dnode
+ * it refers to.
+ */
+
+static void fsw_dcache_drop(struct fsw_volume *vol, struct fsw_dentry *de)
+{
+    struct fsw_dentry **link;
+
+    for (link = &vol->dcache_hash[de->hash & (FSW_DCACHE_HASH_SIZE - 1)]; *link != NULL; link = &(*link)->hash_next) {
+        if (*link == de) {
+            *link = de->hash_next;
+            break;
+        }
+    }
+
+    if (de->lru_prev != NULL)
+        de->lru_prev->lru_next = de->lru_next;
+    else
+        vol->dcache_lru_head = de->lru_next;
+    if (de->lru_next != NULL)
+        de->lru_next->lru_prev = de->lru_prev;
+    else
+        vol->dcache_lru_tail = de->lru_prev;
+    vol->dcache_size--;
+    vol->dcache_bytes -= fsw_dcache_cost(vol, de);
+
+    if (de->dnode != NULL)
+        fsw_dnode_release(de->dnode);
+    fsw_strfree(&de->name);
+    fsw_free(de);
+}
+
+/**
+ * Append a directory entry cache entry to the LRU list, making it the newest entry.
+ */
+
+static void fsw_dcache_lru_append(struct fsw_volume *vol, struct fsw_dentry *de)
+{
+    de->lru_next = NULL;
+    de->lru_prev = vol->dcache_lru_tail;
+    if (de->lru_prev != NULL)
+        de->lru_prev->lru_next = de;
+    else
+        vol->dcache_lru_head = de;
+    vol->dcache_lru_tail = de;
+}
+
+/**
+ * Remember the result of a directory lookup. A NULL child_dno records that the name
+ * does not exist in the directory. The least recently used entries are dropped to
+ * keep the cache within FSW_DCACHE_MAX_BYTES. Failing to allocate an entry is not an
+ * error, the lookup is simply not remembered.
+ */
+
+static void fsw_dcache_insert(struct fsw_volume *vol, struct fsw_dnode *dno, struct fsw_string *lookup_name,
+                              fsw_u32 hash, struct fsw_dnode *child_dno)
+{
+    struct fsw_dentry **bucket;
+    struct fsw_dentry *de;
+    fsw_u32         cost;
+
+    if (fsw_alloc_zero(sizeof(struct fsw_dentry), (void **) &de))
+        return;
+    if (fsw_strdup_coerce(&de->name, vol->host_table->native_string_type, lookup_name)) {
+        fsw_free(de);
+        return;
+    }
+    de->parent_tree_id = dno->tree_id;
+    de->parent_id = dno->dnode_id;
+    de->hash = hash;
+    de->dnode = child_dno;
+    cost = fsw_dcache_cost(vol, de);
+    while (vol->dcache_lru_head != NULL && vol->dcache_bytes + cost > FSW_DCACHE_MAX_BYTES)
+        fsw_dcache_drop(vol, vol->dcache_lru_head);
+    if (child_dno != NULL)
+        fsw_dnode_retain(child_dno);
+
+    bucket = &vol->dcache_hash[hash & (FSW_DCACHE_HASH_SIZE - 1)];
+    de->hash_next = *bucket;
+    *bucket = de;
+    fsw_dcache_lru_append(vol, de);
+    vol->dcache_size++;
+    vol->dcache_bytes += cost;
+}
+
+/**
+ * Drop all remembered directory lookups of a volume.
+ */
+
+static void fsw_dcache_free(struct fsw_volume *vol)
+{
+    while (vol->dcache_lru_head != NULL)
+        fsw_dcache_drop(vol, vol->dcache_lru_head);
+}
+
+/**
+ * Look up a name in a directory dnode, consulting the directory entry cache first.
+ * The caller must have made sure that dno is a directory. Only successful lookups and
+ * FSW_NOT_FOUND results are remembered; names in a string type other than the host's
+ * native one bypass the cache.
+ */
+
+static fsw_status_t fsw_dnode_lookup_cached(struct fsw_volume *vol, struct fsw_dnode *dno,
+                                            struct fsw_string *lookup_name, struct fsw_dnode **child_dno_out)
+{
+    fsw_status_t    status;
+    fsw_u32         hash;
+    struct fsw_dentry *de;
+
+    if (lookup_name->type != vol->host_table->native_string_type || !fsw_dcache_hash_name(lookup_name, &hash))
+        return vol->fstype_table->dir_lookup(vol, dno, lookup_name, child_dno_out);
+
+    for (de = vol->dcache_hash[hash & (FSW_DCACHE_HASH_SIZE - 1)]; de; de = de->hash_next) {
+        if (de->hash == hash && de->parent_id == dno->dnode_id && de->parent_tree_id == dno->tree_id &&
+            fsw_streq(&de->name, lookup_name)) {
+            vol->dcache_hits++;
+
+            // refresh the entry's position in the LRU list
+            if (de != vol->dcache_lru_tail) {
+                if (de->lru_prev != NULL)
+                    de->lru_prev->lru_next = de->lru_next;
+                else
+                    vol->dcache_lru_head = de->lru_next;
+                de->lru_next->lru_prev = de->lru_prev;
+                fsw_dcache_lru_append(vol, de);
+            }
+
+            if (de->dnode == NULL)
+                return FSW_NOT_FOUND;
+            fsw_dnode_retain(de->dnode);
+            *child_dno_out = de->dnode;
+            return FSW_SUCCESS;
+        }
+    }
+
+    vol->dcache_misses++;
+    status = vol->fstype_table->dir_lookup(vol, dno, lookup_name, child_dno_out);
+    if (status == FSW_SUCCESS)
+        fsw_dcache_insert(vol, dno, lookup_name, hash, *child_dno_out);
+    else if (status == FSW_NOT_FOUND)
+        fsw_dcache_insert(vol, dno, lookup_name, hash, NULL);
+    return status;
+}
+
 /**
  * Lookup a directory entry by name. This function is called by the host driver.
  * Given a directory dnode and a file name, it looks up the named entry in the
@@ -517,6 +840,9 @@ fsw_status_t fsw_dnode_stat(struct fsw_dnode *dno, struct fsw_dnode_stat *sb)
  * If the dnode is not a directory, the call will fail. The caller is responsible for
  * resolving symbolic links before calling this function.
  *
+ * Results, including names that were not found, are remembered in the volume's
+ * directory entry cache so that repeated lookups do not touch the disk.
+ *
  * If the function returns FSW_SUCCESS, *child_dno_out points to the requested directory
  * entry. The caller must call fsw_dnode_release on it.
  */
@@ -532,7 +858,7 @@ fsw_status_t fsw_dnode_lookup(struct fsw_dnode *dno,
     if (dno->type != FSW_DNODE_TYPE_DIR)
         return FSW_UNSUPPORTED;
 
-    return dno->vol->fstype_table->dir_lookup(dno->vol, dno, lookup_name, child_dno_out);
+    return fsw_dnode_lookup_cached(dno->vol, dno, lookup_name, child_dno_out);
 }
 
 /**
@@ -624,7 +950,7 @@ fsw_status_t fsw_dnode_lookup_path(struct fsw_dnode *dno,
 
             } else {
                 // do an actual lookup
-                status = vol->fstype_table->dir_lookup(vol, dno, &lookup_name, &child_dno);
+                status = fsw_dnode_lookup_cached(vol, dno, &lookup_name, &child_dno);
                 if (status)
                     goto errorexit;
             }
@@ -856,6 +1182,10 @@ void fsw_shandle_close(struct fsw_shandle *shand)
 /**
  * Read data from a shandle (storage handle for a dnode). This function is called by the
  * host driver or internally when data is read from a file. TODO: more
+ *
+ * If the host provides a read_blocks function, runs of at least FSW_DIRECT_READ_MIN_BYTES
+ * of whole blocks inside a physical extent are read straight into the caller's buffer.
+ * Unaligned head and tail blocks still go through the block cache.
  */
 
 fsw_status_t fsw_shandle_read(struct fsw_shandle *shand, fsw_u32 *buffer_size_inout, void *buffer_in)
@@ -866,7 +1196,7 @@ fsw_status_t fsw_shandle_read(struct fsw_shandle *shand, fsw_u32 *buffer_size_in
     fsw_u8          *buffer, *block_buffer;
     fsw_u64         buflen, copylen, pos;
     fsw_u64         log_bno, pos_in_extent, phys_bno, pos_in_physblock;
-    fsw_u32         cache_level;
+    fsw_u32         cache_level, block_count;
 
     if (shand->pos >= dno->size) {   // already at EOF
         *buffer_size_inout = 0;
@@ -908,18 +1238,39 @@ fsw_status_t fsw_shandle_read(struct fsw_shandle *shand, fsw_u32 *buffer_size_in
             // convert to physical block number and offset
             phys_bno = shand->extent.phys_start + FSW_U64_DIV(pos_in_extent, vol->phys_blocksize);
             pos_in_physblock = pos_in_extent & (vol->phys_blocksize - 1);
-            copylen = vol->phys_blocksize - pos_in_physblock;
-            if (copylen > buflen)
-                copylen = buflen;
 
-            // Get one physical block
-            status = fsw_block_get(vol, phys_bno, cache_level, (void **) &block_buffer);
-            if (status)
-                return status;
+            // count the whole blocks left in both the extent and the request
+            block_count = 0;
+            if (pos_in_physblock == 0 && vol->host_table->read_blocks != NULL) {
+                copylen = (fsw_u64)shand->extent.log_count * vol->log_blocksize - pos_in_extent;
+                if (copylen > buflen)
+                    copylen = buflen;
+                if (copylen > FSW_DIRECT_READ_MAX_BYTES)
+                    copylen = FSW_DIRECT_READ_MAX_BYTES;
+                block_count = (fsw_u32)FSW_U64_DIV(copylen, vol->phys_blocksize);
+            }
 
-            // Copy data from it
-            fsw_memcpy(buffer, block_buffer + pos_in_physblock, copylen);
-            fsw_block_release(vol, phys_bno, block_buffer);
+            if ((fsw_u64)block_count * vol->phys_blocksize >= FSW_DIRECT_READ_MIN_BYTES) {
+                // Read the run straight into the caller's buffer, bypassing the block cache
+                copylen = (fsw_u64)block_count * vol->phys_blocksize;
+                status = vol->host_table->read_blocks(vol, phys_bno, block_count, buffer);
+                if (status)
+                    return status;
+
+            } else {
+                copylen = vol->phys_blocksize - pos_in_physblock;
+                if (copylen > buflen)
+                    copylen = buflen;
+
+                // Get one physical block
+                status = fsw_block_get(vol, phys_bno, cache_level, (void **) &block_buffer);
+                if (status)
+                    return status;
+
+                // Copy data from it
+                fsw_memcpy(buffer, block_buffer + pos_in_physblock, copylen);
+                fsw_block_release(vol, phys_bno, block_buffer);
+            }
 
         } else if (shand->extent.type == FSW_EXTENT_TYPE_BUFFER) {
             copylen = shand->extent.log_count * vol->log_blocksize - pos_in_extent;
@@ -53,8 +53,28 @@
 /** Expands to the name of a fstype dispatch table (fsw_fstype_table) for a named file system type. */
 #define FSW_FSTYPE_TABLE_NAME(t) FSW_CONCAT3(fsw_,t,_table)
 
-/** Indicates that the block cache entry is empty. */
-#define FSW_INVALID_BNO 0xFFFFFFFFFFFFFFFF
+/** Highest cache level accepted by fsw_block_get. */
+#define FSW_MAX_CACHE_LEVEL (5)
+/** Number of hash buckets in the block cache. Must be a power of 2. */
+#define FSW_BCACHE_HASH_SIZE (1024)
+#ifndef FSW_BCACHE_MAX_BYTES
+/** Default memory ceiling for the block cache of a volume, in bytes. */
+#define FSW_BCACHE_MAX_BYTES (8 * 1024 * 1024)
+#endif
+/** Number of hash buckets for looking up dnodes by id. Must be a power of 2. */
+#define FSW_DNODE_HASH_SIZE (512)
+/** Number of hash buckets in the directory entry cache. Must be a power of 2. */
+#define FSW_DCACHE_HASH_SIZE (1024)
+#ifndef FSW_DCACHE_MAX_BYTES
+/** Default memory ceiling for the directory entry cache of a volume, in bytes. Entries
+    are charged for their name and the dnode they keep alive; at 1 MiB this holds a few
+    thousand entries, enough for a large directory. */
+#define FSW_DCACHE_MAX_BYTES (1024 * 1024)
+#endif
+#ifndef FSW_DIRECT_READ_MIN_BYTES
+/** Smallest run of whole blocks that fsw_shandle_read hands to the host's read_blocks. */
+#define FSW_DIRECT_READ_MIN_BYTES (64 * 1024)
+#endif
 
 
 //
@@ -213,6 +233,27 @@ struct fsw_blockcache {
     fsw_u32     cache_level;        //!< Level of importance of this block
     fsw_u64     phys_bno;           //!< Physical block number
     void        *data;              //!< Block data buffer
+
+    struct fsw_blockcache *hash_next;   //!< Next entry in the same hash bucket
+    struct fsw_blockcache *lru_prev;    //!< LRU list of unreferenced entries: previous (older) entry
+    struct fsw_blockcache *lru_next;    //!< LRU list of unreferenced entries: next (newer) entry
+};
+
+/**
+ * Core: Remembers the result of a directory lookup. A NULL dnode records a name
+ * that was not found in the directory.
+ */
+
+struct fsw_dentry {
+    fsw_u64     parent_tree_id;     //!< Tree id of the directory that was searched
+    fsw_u64     parent_id;          //!< Dnode id of the directory that was searched
+    fsw_u32     hash;               //!< Hash of the case-folded name
+    struct fsw_string name;         //!< Name that was looked up, in the host's native encoding
+    struct fsw_dnode *dnode;        //!< Retained dnode that was found, or NULL for a negative entry
+
+    struct fsw_dentry *hash_next;   //!< Next entry in the same hash bucket
+    struct fsw_dentry *lru_prev;    //!< LRU list: previous (older) entry
+    struct fsw_dentry *lru_next;    //!< LRU list: next (newer) entry
 };
 
 /**
@@ -227,9 +268,23 @@ struct fsw_volume {
     struct fsw_string label;        //!< Volume label
 
     struct fsw_dnode *dnode_head;   //!< List of all dnodes allocated for this volume
-
-    struct fsw_blockcache *bcache;  //!< Array of block cache entries
-    fsw_u32     bcache_size;        //!< Number of entries in the block cache array
+    struct fsw_dnode *dnode_hash[FSW_DNODE_HASH_SIZE];  //!< Hash table of all dnodes, keyed on (tree_id, dnode_id)
+
+    struct fsw_blockcache **bcache; //!< Hash table of block cache entries, keyed on phys_bno
+    struct fsw_blockcache *bcache_lru_head[FSW_MAX_CACHE_LEVEL + 1];  //!< Per-level LRU lists: oldest entry
+    struct fsw_blockcache *bcache_lru_tail[FSW_MAX_CACHE_LEVEL + 1];  //!< Per-level LRU lists: newest entry
+    fsw_u32     bcache_size;        //!< Number of entries in the block cache
+    fsw_u32     bcache_max_bytes;   //!< Memory ceiling for the block cache, in bytes
+    fsw_u64     bcache_hits;        //!< Block cache lookups served from memory
+    fsw_u64     bcache_misses;      //!< Block cache lookups that had to read the disk
+
+    struct fsw_dentry *dcache_hash[FSW_DCACHE_HASH_SIZE];  //!< Hash table of cached lookups, keyed on (parent, folded name)
+    struct fsw_dentry *dcache_lru_head; //!< Least recently used directory entry
+    struct fsw_dentry *dcache_lru_tail; //!< Most recently used directory entry
+    fsw_u32     dcache_size;        //!< Number of entries in the directory entry cache
+    fsw_u32     dcache_bytes;       //!< Memory charged to the directory entry cache, in bytes
+    fsw_u64     dcache_hits;        //!< Directory lookups answered from the cache
+    fsw_u64     dcache_misses;      //!< Directory lookups passed on to the file system driver
 
     void        *host_data;         //!< Hook for a host-specific data structure
     struct fsw_host_table *host_table;      //!< Dispatch table for host-specific functions
@@ -255,6 +310,7 @@ struct fsw_dnode {
 
     struct fsw_dnode *next;         //!< Doubly-linked list of all dnodes: previous dnode
     struct fsw_dnode *prev;         //!< Doubly-linked list of all dnodes: next dnode
+    struct fsw_dnode *hash_next;    //!< Next dnode in the same hash bucket
 };
 
 /**
@@ -343,6 +399,7 @@ struct fsw_host_table
                                      fsw_u32 old_phys_blocksize, fsw_u32 old_log_blocksize,
                                      fsw_u32 new_phys_blocksize, fsw_u32 new_log_blocksize);
     fsw_status_t EFIAPI (*read_block)(struct fsw_volume *vol, fsw_u64 phys_bno, void *buffer);
+    fsw_status_t EFIAPI (*read_blocks)(struct fsw_volume *vol, fsw_u64 phys_bno, fsw_u32 count, void *buffer);  //!< Optional, may be NULL
 };
 
 /**
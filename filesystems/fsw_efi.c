@@ -127,6 +127,12 @@ fsw_status_t EFIAPI fsw_efi_read_block(
     fsw_u64 phys_bno,
     void *buffer
 );
+fsw_status_t EFIAPI fsw_efi_read_blocks(
+    struct fsw_volume *vol,
+    fsw_u64 phys_bno,
+    fsw_u32 count,
+    void *buffer
+);
 EFI_STATUS fsw_efi_map_status(
     fsw_status_t     fsw_status,
     FSW_VOLUME_DATA *Volume
@@ -182,20 +188,52 @@ EFI_STATUS fsw_efi_dnode_fill_FileInfo(
 );
 
 /**
- * Structure for holding disk cache data.
+ * Structure for holding disk cache data. The cache is set-associative: each
+ * CACHE_SIZE aligned chunk of a volume maps to one set of CACHE_WAYS slots.
+ * Slots are stored way by way in one buffer, and consecutive chunks of a
+ * volume map to consecutive sets, so the slots for a run of chunks follow
+ * each other in the buffer, carrying on into the next way after the last
+ * set. A read-ahead run is read straight into them, and is cut at the end
+ * of the buffer so it always takes a single read. The geometry can be
+ * overridden at build time; the default tops out at 2MiB.
+ *
+ * Read-ahead only serves the block cache: metadata, small files and the
+ * unaligned ends of large reads. Longer runs of file data go straight to
+ * the caller's buffer through fsw_efi_read_blocks(). A run is held to half
+ * the cache by default, so one can never push out more than half the ways
+ * of any set.
  */
 
-#define CACHE_SIZE 131072 /* 128KiB */
+#define CACHE_SHIFT 17
+#define CACHE_SIZE (1 << CACHE_SHIFT) /* 128KiB */
+#ifndef CACHE_SETS
+#define CACHE_SETS 4 /* Must be a power of 2 */
+#endif
+#ifndef CACHE_WAYS
+#define CACHE_WAYS 4
+#endif
+#define NUM_CACHES (CACHE_SETS * CACHE_WAYS)
+#ifndef CACHE_READAHEAD_MAX
+#define CACHE_READAHEAD_MAX ((NUM_CACHES + 1) / 2) /* In chunks; 1MiB by default */
+#endif
+#if CACHE_READAHEAD_MAX < 1 || CACHE_READAHEAD_MAX > NUM_CACHES
+#error "CACHE_READAHEAD_MAX must be between 1 and CACHE_SETS * CACHE_WAYS"
+#endif
+
 struct cache_data {
    fsw_u8            *Cache;
    fsw_u64           CacheStart;
+   fsw_u64           LastUse;
    BOOLEAN           CacheValid;
    FSW_VOLUME_DATA   *Volume; // NOTE: Do not deallocate; copied here to ID volume
 };
 
-#define NUM_CACHES 2 /* Do not increase without modifying fsw_efi_read_block() */
 static struct cache_data    Caches[NUM_CACHES];
-static int LastRead = -1;
+static fsw_u8              *CacheBuffer      = NULL;
+static fsw_u64              CacheClock       = 0;
+static UINTN                ReadAheadChunks  = 1;
+static FSW_VOLUME_DATA     *LastMissVolume   = NULL;
+static fsw_u64              LastMissStart    = 0;
 
 /**
  * Interface structure for the UEFI Driver Binding protocol.
@@ -225,7 +263,8 @@ REFINDPLUS_EFI_COMPONENT_NAME_PROTOCOL fsw_efi_ComponentName_table = {
 struct fsw_host_table   fsw_efi_host_table = {
     FSW_STRING_TYPE_UTF16,
     fsw_efi_change_blocksize,
-    fsw_efi_read_block
+    fsw_efi_read_block,
+    fsw_efi_read_blocks
 };
 
 extern struct fsw_fstype_table   FSW_FSTYPE_TABLE_NAME(FSTYPE);
@@ -235,19 +274,135 @@ VOID EFIAPI fsw_efi_clear_cache(VOID) {
    int i;
 
    // clear the cache
+   if (CacheBuffer != NULL) {
+      FreePool(CacheBuffer);
+      CacheBuffer = NULL;
+   } // if
    for (i = 0; i < NUM_CACHES; i++) {
-      if (Caches[i].Cache != NULL) {
-         FreePool(Caches[i].Cache);
-         Caches[i].Cache = NULL;
-      } // if
-
+      Caches[i].Cache      = NULL;
       Caches[i].CacheStart = 0;
+      Caches[i].LastUse    = 0;
       Caches[i].CacheValid = FALSE;
       Caches[i].Volume     = NULL;
    }
-   LastRead = -1;
+   CacheClock      = 0;
+   ReadAheadChunks = 1;
+   LastMissVolume  = NULL;
+   LastMissStart   = 0;
 } // VOID EFIAPI fsw_efi_clear_cache();
 
+/**
+ * Return the cache set for a given chunk. Consecutive chunks of a volume map
+ * to consecutive sets.
+ */
+
+static UINTN fsw_efi_cache_set(FSW_VOLUME_DATA *Volume, fsw_u64 ChunkStart) {
+   UINTN Key = (UINTN) RShiftU64(ChunkStart, CACHE_SHIFT) + ((UINTN) Volume >> 4);
+
+   return Key & (CACHE_SETS - 1);
+} // static UINTN fsw_efi_cache_set()
+
+/**
+ * Look up a cached chunk. Returns the slot index or -1 on a miss.
+ */
+
+static int fsw_efi_cache_find(FSW_VOLUME_DATA *Volume, fsw_u64 ChunkStart) {
+   UINTN Set = fsw_efi_cache_set(Volume, ChunkStart);
+   UINTN i;
+
+   for (i = Set; i < NUM_CACHES; i += CACHE_SETS) {
+      if (Caches[i].CacheValid &&
+          Caches[i].Volume     == Volume &&
+          Caches[i].CacheStart == ChunkStart) {
+         return (int) i;
+      }
+   }
+
+   return -1;
+} // static int fsw_efi_cache_find()
+
+/**
+ * Check whether a read-ahead run may overwrite a slot: it must be unused, or
+ * no slot of its set that the run leaves alone may have been used less
+ * recently. Slots the run has already taken, from RunStart up to Slot, do not
+ * count.
+ */
+
+static BOOLEAN fsw_efi_cache_evictable(UINTN Slot, UINTN RunStart) {
+   UINTN i;
+
+   if (!Caches[Slot].CacheValid) {
+      return TRUE;
+   }
+
+   for (i = Slot % CACHE_SETS; i < NUM_CACHES; i += CACHE_SETS) {
+      if (i >= RunStart && i <= Slot) {
+         continue;
+      }
+      if (!Caches[i].CacheValid || Caches[i].LastUse < Caches[Slot].LastUse) {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+} // static BOOLEAN fsw_efi_cache_evictable()
+
+/**
+ * Pick the slots for a run of up to *Count chunks starting at ChunkStart. The
+ * run may start in any way of the chunk's set and carries on through the
+ * slots that follow, so each way is tried and each try is cut at the first
+ * slot that may not be overwritten, or at the end of the buffer. The least
+ * recently used slot of the set always may be, so a run gets at least one
+ * chunk. The longest run wins, and
+ * of runs as long, the one whose newest slot is oldest. Returns the first
+ * slot and sets *Count to the run length, or -1 if no buffer could be
+ * allocated.
+ */
+
+static int fsw_efi_cache_victim_run(FSW_VOLUME_DATA *Volume, fsw_u64 ChunkStart, UINTN *Count) {
+   UINTN  Set = fsw_efi_cache_set(Volume, ChunkStart);
+   UINTN  i, Way, Start, Length, Slot;
+   UINTN  BestStart, BestLength;
+   fsw_u64 Newest, BestNewest;
+
+   if (CacheBuffer == NULL) {
+      CacheBuffer = AllocatePool((UINTN) NUM_CACHES * CACHE_SIZE);
+      if (CacheBuffer == NULL) {
+         return -1;
+      }
+      for (i = 0; i < NUM_CACHES; i++) {
+         Caches[i].Cache = CacheBuffer + i * CACHE_SIZE;
+      }
+   }
+
+   BestStart  = Set;
+   BestLength = 0;
+   BestNewest = 0;
+   for (Way = 0; Way < CACHE_WAYS; Way++) {
+      Start  = Way * CACHE_SETS + Set;
+      Newest = 0;
+      for (Length = 0; Length < *Count && Start + Length < NUM_CACHES; Length++) {
+         Slot = Start + Length;
+         if (!fsw_efi_cache_evictable(Slot, Start)) {
+            break;
+         }
+         if (Caches[Slot].CacheValid && Caches[Slot].LastUse > Newest) {
+            Newest = Caches[Slot].LastUse;
+         }
+      }
+
+      if (Length > BestLength || (Length == BestLength && Length > 0 && Newest < BestNewest)) {
+         BestStart  = Start;
+         BestLength = Length;
+         BestNewest = Newest;
+      }
+   }
+
+   *Count = BestLength;
+
+   return (int) BestStart;
+} // static int fsw_efi_cache_victim_run()
+
 /**
  * Image entry point. Installs the Driver Binding and Component Name protocols
  * on the image's handle. Actually mounting a file system is initiated through
@@ -555,12 +710,18 @@ void EFIAPI fsw_efi_change_blocksize(
 /**
  * FSW interface function to read data blocks. This function is called by the FSW core
  * to read a block of data from the device. The buffer is allocated by the core code.
- * Two caches are maintained, so as to improve performance on some systems. (VirtualBox
- * is particularly susceptible to performance problems with an uncached driver -- the
- * ext2 driver can take 200 seconds to load a Linux kernel under VirtualBox, whereas
- * the time is more like 3 seconds with a cache!) Two independent caches are maintained
- * because the ext2fs driver tends to alternate between accessing two parts of the
- * disk.
+ * The disk is read in 128KiB chunks which are kept in a set-associative cache, so as to
+ * improve performance on some systems. (VirtualBox is particularly susceptible to
+ * performance problems with an uncached driver -- the ext2 driver can take 200 seconds
+ * to load a Linux kernel under VirtualBox, whereas the time is more like 3 seconds with
+ * a cache!) Several ways are kept per set because drivers tend to alternate between
+ * file data and metadata in different parts of the disk.
+ *
+ * Consecutive misses on ascending chunks double the read-ahead window, up to
+ * CACHE_READAHEAD_MAX chunks, so sequential reads through the cache are served by a
+ * few big Disk I/O calls. A run only takes slots that are the least recently used of
+ * their set, so it stops short of hot metadata. Any other miss resets the window to
+ * a single chunk.
  */
 
 fsw_status_t EFIAPI fsw_efi_read_block(
@@ -568,44 +729,48 @@ fsw_status_t EFIAPI fsw_efi_read_block(
     fsw_u64            phys_bno,
     void              *buffer
 ) {
-   int              i, ReadCache = -1;
+   int              ReadCache;
+   UINTN            i, Count;
    FSW_VOLUME_DATA  *Volume = (FSW_VOLUME_DATA *)vol->host_data;
    EFI_STATUS       Status = EFI_SUCCESS;
-   BOOLEAN          ReadOneBlock = FALSE;
    UINT64           StartRead = (UINT64) phys_bno * (UINT64) vol->phys_blocksize;
+   UINT64           ChunkStart = StartRead & ~((UINT64) CACHE_SIZE - 1);
 
    if (buffer == NULL)
       return (fsw_status_t) EFI_BAD_BUFFER_SIZE;
 
-   // Initialize static data structures, if necessary.
-   if (LastRead < 0) {
-      fsw_efi_clear_cache();
-   } // if
+   if (vol->phys_blocksize == 0 || vol->phys_blocksize > CACHE_SIZE) {
+      ReadCache = -1;
+   } else {
+      // Look for a cache hit on the current query.
+      ReadCache = fsw_efi_cache_find(Volume, ChunkStart);
+   }
 
-   // Look for a cache hit on the current query.
-   i = 0;
-   do {
-      if ((Caches[i].Volume == Volume) &&
-          Caches[i].CacheValid &&
-          (StartRead >= Caches[i].CacheStart) &&
-          ((StartRead + vol->phys_blocksize) <= (Caches[i].CacheStart + CACHE_SIZE))) {
-         ReadCache = i;
+   // No cache hit found; load new cache and pass it on.
+   if (ReadCache < 0 && vol->phys_blocksize > 0 && vol->phys_blocksize <= CACHE_SIZE) {
+      // Grow the read-ahead window on sequential misses.
+      if (Volume == LastMissVolume && ChunkStart == LastMissStart + CACHE_SIZE) {
+         ReadAheadChunks <<= 1;
+         if (ReadAheadChunks > CACHE_READAHEAD_MAX)
+            ReadAheadChunks = CACHE_READAHEAD_MAX;
+      } else {
+         ReadAheadChunks = 1;
       }
-      i++;
-   } while ((i < NUM_CACHES) && (ReadCache < 0));
 
-   // No cache hit found; load new cache and pass it on.
-   if (ReadCache < 0) {
-      if (LastRead == -1)
-         LastRead = 1;
-      ReadCache = 1 - LastRead; // NOTE: If NUM_CACHES > 2, this must become more complex
-      Caches[ReadCache].CacheValid = FALSE;
-      if (Caches[ReadCache].Cache == NULL) {
-          Caches[ReadCache].Cache = AllocatePool(CACHE_SIZE);
+      // Stop the run at the first chunk that is already cached.
+      Count = 1;
+      while (Count < ReadAheadChunks &&
+             fsw_efi_cache_find(Volume, ChunkStart + (UINT64) Count * CACHE_SIZE) < 0) {
+         Count++;
       }
-      if (Caches[ReadCache].Cache == NULL) {
-         ReadOneBlock = TRUE;
-      } else {
+
+      ReadCache = fsw_efi_cache_victim_run(Volume, ChunkStart, &Count);
+      if (ReadCache >= 0) {
+         // The run fills the slots from ReadCache on.
+         for (i = 0; i < Count; i++) {
+            Caches[ReadCache + i].CacheValid = FALSE;
+         }
+
          // TODO: Below call hangs on my 32-bit Mac Mini when compiled with GNU-EFI.
          // The same binary is fine under VirtualBox, and the same call is fine when
          // compiled with Tianocore. Further clue: Omitting "Status =" avoids the
@@ -618,30 +783,43 @@ fsw_status_t EFIAPI fsw_efi_read_block(
          // the way the function is being called. FIGURE THIS OUT!
          Status = REFIT_CALL_5_WRAPPER(
              Volume->DiskIo->ReadDisk, Volume->DiskIo,
-             Volume->MediaId, StartRead,
-             (UINTN) CACHE_SIZE, (VOID*) Caches[ReadCache].Cache
+             Volume->MediaId, ChunkStart,
+             Count * CACHE_SIZE, (VOID*) Caches[ReadCache].Cache
          );
+         if (EFI_ERROR(Status) && Count > 1) {
+            // Probably ran past the end of the disk; retry with one chunk.
+            Count  = 1;
+            Status = REFIT_CALL_5_WRAPPER(
+                Volume->DiskIo->ReadDisk, Volume->DiskIo,
+                Volume->MediaId, ChunkStart,
+                (UINTN) CACHE_SIZE, (VOID*) Caches[ReadCache].Cache
+            );
+         }
          if (EFI_ERROR(Status)) {
-            ReadOneBlock = TRUE;
+            ReadCache = -1;
          } else {
-            Caches[ReadCache].CacheStart = StartRead;
-            Caches[ReadCache].CacheValid = TRUE;
-            Caches[ReadCache].Volume     = Volume;
-            LastRead                     = ReadCache;
+            for (i = 0; i < Count; i++) {
+               Caches[ReadCache + i].CacheStart = ChunkStart + (UINT64) i * CACHE_SIZE;
+               Caches[ReadCache + i].LastUse    = ++CacheClock;
+               Caches[ReadCache + i].CacheValid = TRUE;
+               Caches[ReadCache + i].Volume     = Volume;
+            }
          }
       } // if cache memory allocated
+
+      LastMissVolume = Volume;
+      LastMissStart  = ChunkStart + (UINT64) (Count - 1) * CACHE_SIZE;
    } // if (ReadCache < 0)
 
-   if (Caches[ReadCache].Cache != NULL && Caches[ReadCache].CacheValid && vol->phys_blocksize > 0) {
-      CopyMem(buffer, &Caches[ReadCache].Cache[StartRead - Caches[ReadCache].CacheStart], vol->phys_blocksize);
+   if (ReadCache >= 0) {
+      Caches[ReadCache].LastUse = ++CacheClock;
+      CopyMem(buffer, &Caches[ReadCache].Cache[StartRead - ChunkStart], vol->phys_blocksize);
+      Status = EFI_SUCCESS;
    } else {
-      ReadOneBlock = TRUE;
-   }
-
-   if (ReadOneBlock) { // Something's failed, so try a simple disk read of one block.
+      // Something's failed, so try a simple disk read of one block.
       Status = REFIT_CALL_5_WRAPPER(
           Volume->DiskIo->ReadDisk, Volume->DiskIo,
-          Volume->MediaId, phys_bno * vol->phys_blocksize,
+          Volume->MediaId, StartRead,
           (UINTN) vol->phys_blocksize, (VOID*) buffer
       );
    }
@@ -650,6 +828,35 @@ fsw_status_t EFIAPI fsw_efi_read_block(
    return Status;
 } // fsw_status_t *fsw_efi_read_block()
 
+/**
+ * FSW interface function to read a run of data blocks. This function is called by the
+ * FSW core for large file reads and reads straight into the caller's buffer with a
+ * single Disk I/O call. The disk cache is bypassed, as the data is unlikely to be read
+ * again and would only push metadata out of the cache.
+ */
+
+fsw_status_t EFIAPI fsw_efi_read_blocks(
+    struct fsw_volume *vol,
+    fsw_u64            phys_bno,
+    fsw_u32            count,
+    void              *buffer
+) {
+   FSW_VOLUME_DATA  *Volume = (FSW_VOLUME_DATA *)vol->host_data;
+   EFI_STATUS       Status;
+
+   if (buffer == NULL)
+      return (fsw_status_t) EFI_BAD_BUFFER_SIZE;
+
+   Status = REFIT_CALL_5_WRAPPER(
+       Volume->DiskIo->ReadDisk, Volume->DiskIo,
+       Volume->MediaId, (UINT64) phys_bno * (UINT64) vol->phys_blocksize,
+       (UINTN) count * vol->phys_blocksize, (VOID*) buffer
+   );
+   Volume->LastIOStatus = Status;
+
+   return Status;
+} // fsw_status_t *fsw_efi_read_blocks()
+
 /**
  * Map FSW status codes to EFI status codes. The FSW_IO_ERROR code is only produced
  * by fsw_efi_read_block, so we map it back to the EFI status code remembered from
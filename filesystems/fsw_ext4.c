@@ -47,6 +47,8 @@ static fsw_status_t fsw_ext4_dir_lookup(struct fsw_ext4_volume *vol, struct fsw_
 static fsw_status_t fsw_ext4_dir_read(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
                                       struct fsw_shandle *shand, struct fsw_ext4_dnode **child_dno);
 static fsw_status_t fsw_ext4_read_dentry(struct fsw_shandle *shand, struct ext4_dir_entry *entry);
+static fsw_status_t fsw_ext4_dx_lookup(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                       struct fsw_string *lookup_name, fsw_u32 *child_ino_out);
 
 static fsw_status_t fsw_ext4_readlink(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
                                       struct fsw_string *link);
@@ -142,7 +144,7 @@ static fsw_status_t fsw_ext4_volume_mount(struct fsw_ext4_volume *vol)
         (vol->sb->s_feature_incompat & ~(EXT4_FEATURE_INCOMPAT_FILETYPE | EXT4_FEATURE_INCOMPAT_RECOVER |
                                          EXT4_FEATURE_INCOMPAT_EXTENTS | EXT4_FEATURE_INCOMPAT_FLEX_BG |
                                          EXT4_FEATURE_INCOMPAT_64BIT | EXT4_FEATURE_INCOMPAT_META_BG |
-                                         EXT4_FEATURE_INCOMPAT_ENCRYPT)))
+                                         EXT4_FEATURE_INCOMPAT_ENCRYPT | EXT4_FEATURE_INCOMPAT_LARGEDIR)))
         return FSW_UNSUPPORTED;
 
     if (vol->sb->s_rev_level == EXT4_DYNAMIC_REV &&
@@ -394,13 +396,19 @@ static fsw_status_t fsw_ext4_get_extent(struct fsw_ext4_volume *vol, struct fsw_
 
 /**
  * New ext4 extents...
+ *
+ * Each tree node is binary searched for the last entry starting at or before the
+ * requested block. The leaf block found last is remembered in the dnode together
+ * with the range of logical blocks it covers, so that sequential reads start at
+ * that leaf instead of walking down from the inode again.
  */
 static fsw_status_t fsw_ext4_get_by_extent(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
                                         struct fsw_extent *extent)
 {
     fsw_status_t  status;
-    fsw_u32       bno, buf_offset;
-    int           ext_cnt;
+    fsw_u32       bno, buf_size, range_start, range_end, ee_len;
+    fsw_u64       node_bno, child_bno;
+    int           lo, hi, mid, depth;
     void          *buffer;
 
     struct ext4_extent_header  *ext4_extent_header;
@@ -410,59 +418,114 @@ static fsw_status_t fsw_ext4_get_by_extent(struct fsw_ext4_volume *vol, struct f
     // Logical block requested by core...
     bno = extent->log_start;
 
-    // First buffer is the i_block field from inode...
-    buffer = (void *)dno->raw->i_block;
-    buf_offset = 0;
-    while(1) {
-        ext4_extent_header = (struct ext4_extent_header *)((char *)buffer + buf_offset);
-        buf_offset += sizeof (struct ext4_extent_header);
+    if (dno->ext_leaf_bno != 0 && bno >= dno->ext_leaf_start && bno < dno->ext_leaf_end) {
+        // Resume at the leaf used last time
+        node_bno = dno->ext_leaf_bno;
+        status = fsw_block_get(vol, node_bno, 1, (void **) &buffer);
+        if (status)
+            return status;
+        buf_size = vol->g.log_blocksize;
+        range_start = dno->ext_leaf_start;
+        range_end = dno->ext_leaf_end;
+        depth = 0;
+    } else {
+        // First buffer is the i_block field from inode...
+        node_bno = 0;
+        buffer = (void *)dno->raw->i_block;
+        buf_size = sizeof (dno->raw->i_block);
+        range_start = 0;
+        range_end = 0xffffffff;
+        depth = -1;
+    }
+
+    while (1) {
+        ext4_extent_header = (struct ext4_extent_header *)buffer;
         FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: extent header with %d entries\n"),
                       ext4_extent_header->eh_entries));
-        if(ext4_extent_header->eh_magic != EXT4_EXT_MAGIC)
-            return FSW_VOLUME_CORRUPTED;
+        if (ext4_extent_header->eh_magic != EXT4_EXT_MAGIC ||
+            ext4_extent_header->eh_depth > EXT4_MAX_EXTENT_DEPTH ||
+            (depth >= 0 && ext4_extent_header->eh_depth != depth) ||
+            sizeof (struct ext4_extent_header) +
+            ext4_extent_header->eh_entries * sizeof (struct ext4_extent) > buf_size) {
+            status = FSW_VOLUME_CORRUPTED;
+            break;
+        }
+        depth = ext4_extent_header->eh_depth;
+
+        // Find the last entry starting at or before the requested block
+        ext4_extent = (struct ext4_extent *)(ext4_extent_header + 1);
+        ext4_extent_idx = (struct ext4_extent_idx *)(ext4_extent_header + 1);
+        lo = 0;
+        hi = ext4_extent_header->eh_entries;
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+            if ((depth == 0 ? ext4_extent[mid].ee_block : ext4_extent_idx[mid].ei_block) <= bno)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        lo--;
 
-        for(ext_cnt = 0;ext_cnt < ext4_extent_header->eh_entries;ext_cnt++)
-        {
-            if(ext4_extent_header->eh_depth == 0)
-            {
-                // Leaf node, the header follows actual extents
-                ext4_extent = (struct ext4_extent *)((char *)buffer + buf_offset);
-                buf_offset += sizeof (struct ext4_extent);
+        if (depth == 0) {
+            // Leaf node, is the requested block in the extent we found?
+            status = FSW_SUCCESS;
+            extent->type = FSW_EXTENT_TYPE_SPARSE;
+            if (lo >= 0) {
+                ext4_extent += lo;
                 FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: extent node cover %d...\n"), ext4_extent->ee_block));
-
-                // Is the requested block in this extent?
-                if(bno >= ext4_extent->ee_block && bno < ext4_extent->ee_block + ext4_extent->ee_len)
-                {
-                    extent->phys_start = ((fsw_u64)ext4_extent->ee_start_hi << 32) | ext4_extent->ee_start_lo;
-                    extent->phys_start += (bno - ext4_extent->ee_block);
-                    extent->log_count = ext4_extent->ee_len - (bno - ext4_extent->ee_block);
-                    return FSW_SUCCESS;
+                ee_len = ext4_extent->ee_len;
+                if (ee_len > EXT_INIT_MAX_LEN)
+                    ee_len -= EXT_INIT_MAX_LEN;
+                if (bno - ext4_extent->ee_block < ee_len) {
+                    extent->log_count = ee_len - (bno - ext4_extent->ee_block);
+                    if (ext4_extent->ee_len <= EXT_INIT_MAX_LEN) {
+                        // uninitialized extents stay sparse
+                        extent->type = FSW_EXTENT_TYPE_PHYSBLOCK;
+                        extent->phys_start = ((fsw_u64)ext4_extent->ee_start_hi << 32) | ext4_extent->ee_start_lo;
+                        extent->phys_start += (bno - ext4_extent->ee_block);
+                    }
                 }
             }
-            else
-            {
-                FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: index extents, depth %d\n"),
-                          ext4_extent_header->eh_depth));
-                ext4_extent_idx = (struct ext4_extent_idx *)((char *)buffer + buf_offset);
-                buf_offset += sizeof (struct ext4_extent_idx);
-
-                FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: index node covers block %d...\n"),
-                          ext4_extent_idx->ei_block));
-                if(bno >= ext4_extent_idx->ei_block)
-                {
-                    // Follow extent tree...
-                    fsw_u64 phys_bno = ((fsw_u64)ext4_extent_idx->ei_leaf_hi << 32) | ext4_extent_idx->ei_leaf_lo;
-                    status = fsw_block_get(vol, phys_bno, 1, (void **) &buffer);
-                    if (status)
-                        return status;
-                    buf_offset = 0;
-                    break;
-                }
+
+            if (node_bno != 0) {
+                dno->ext_leaf_bno = node_bno;
+                dno->ext_leaf_start = range_start;
+                dno->ext_leaf_end = range_end;
             }
+            break;
+        }
+
+        // Index node, the first entry also covers everything before it
+        FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: index extents, depth %d\n"), depth));
+        if (ext4_extent_header->eh_entries == 0) {
+            status = FSW_VOLUME_CORRUPTED;
+            break;
         }
+        if (lo < 0)
+            lo = 0;
+        else if (ext4_extent_idx[lo].ei_block > range_start)
+            range_start = ext4_extent_idx[lo].ei_block;
+        if (lo + 1 < ext4_extent_header->eh_entries && ext4_extent_idx[lo + 1].ei_block < range_end)
+            range_end = ext4_extent_idx[lo + 1].ei_block;
+        ext4_extent_idx += lo;
+        FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_get_by_extent: index node covers block %d...\n"),
+                      ext4_extent_idx->ei_block));
+
+        // Follow extent tree...
+        child_bno = ((fsw_u64)ext4_extent_idx->ei_leaf_hi << 32) | ext4_extent_idx->ei_leaf_lo;
+        if (node_bno != 0)
+            fsw_block_release(vol, node_bno, buffer);
+        node_bno = child_bno;
+        status = fsw_block_get(vol, node_bno, 1, (void **) &buffer);
+        if (status)
+            return status;
+        buf_size = vol->g.log_blocksize;
+        depth--;
     }
 
-    return FSW_NOT_FOUND;
+    if (node_bno != 0)
+        fsw_block_release(vol, node_bno, buffer);
+    return status;
 }
 
 /**
@@ -559,6 +622,9 @@ static fsw_status_t fsw_ext4_get_by_blkaddr(struct fsw_ext4_volume *vol, struct
  * to retrieve the directory entry with the given name. A dnode is constructed for
  * this entry and returned. The core makes sure that fsw_ext4_dnode_fill has been called
  * and the dnode is actually a directory.
+ *
+ * Hash-indexed directories are searched through their htree first. The linear scan
+ * is used for unindexed directories and whenever the index cannot be used.
  */
 
 static fsw_status_t fsw_ext4_dir_lookup(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
@@ -572,6 +638,18 @@ static fsw_status_t fsw_ext4_dir_lookup(struct fsw_ext4_volume *vol, struct fsw_
 
     // Preconditions: The caller has checked that dno is a directory node.
 
+    // go straight to the leaf block of hash-indexed directories
+    if ((dno->raw->i_flags & EXT4_INDEX_FL) &&
+        !fsw_streq_cstr(lookup_name, ".") && !fsw_streq_cstr(lookup_name, "..")) {
+        child_ino = 0;
+        status = fsw_ext4_dx_lookup(vol, dno, lookup_name, &child_ino);
+        if (status == FSW_SUCCESS)
+            return fsw_dnode_create(dno, child_ino, FSW_DNODE_TYPE_UNKNOWN, lookup_name, child_dno_out);
+        if (status != FSW_UNSUPPORTED && status != FSW_VOLUME_CORRUPTED)
+            return status;
+        FSW_MSG_DEBUG((FSW_MSGSTR("fsw_ext4_dir_lookup: htree unusable (%d), scanning directory\n"), status));
+    }
+
     entry_name.type = FSW_STRING_TYPE_ISO88591;
 
     // setup handle to read the directory
@@ -609,6 +687,452 @@ errorexit:
     return status;
 }
 
+/**
+ * The legacy htree hash ("dx_hack_hash").
+ */
+
+static fsw_u32 fsw_ext4_dx_hack_hash(const fsw_u8 *name, int len, int is_unsigned)
+{
+    fsw_u32 hash, hash0 = 0x12a3fe2d, hash1 = 0x37abe8f9, c;
+
+    while (len--) {
+        c = is_unsigned ? (fsw_u32)*name : (fsw_u32)(fsw_s32)(fsw_s8)*name;
+        name++;
+        hash = hash1 + (hash0 ^ (c * 7152373));
+        if (hash & 0x80000000)
+            hash -= 0x7fffffff;
+        hash1 = hash0;
+        hash0 = hash;
+    }
+    return hash0 << 1;
+}
+
+/**
+ * Pack a name into the input words of the TEA and half MD4 hashes, padding
+ * it with its length.
+ */
+
+static void fsw_ext4_str2hashbuf(const fsw_u8 *msg, int len, fsw_u32 *buf, int num, int is_unsigned)
+{
+    fsw_u32 pad, val, c;
+    int     i;
+
+    pad = (fsw_u32)len | ((fsw_u32)len << 8);
+    pad |= pad << 16;
+
+    val = pad;
+    if (len > num * 4)
+        len = num * 4;
+    for (i = 0; i < len; i++) {
+        c = is_unsigned ? (fsw_u32)msg[i] : (fsw_u32)(fsw_s32)(fsw_s8)msg[i];
+        val = c + (val << 8);
+        if ((i % 4) == 3) {
+            *buf++ = val;
+            val = pad;
+            num--;
+        }
+    }
+    if (--num >= 0)
+        *buf++ = val;
+    while (--num >= 0)
+        *buf++ = pad;
+}
+
+#define EXT4_ROL32(x, s) (((x) << (s)) | ((x) >> (32 - (s))))
+#define EXT4_MD4_F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define EXT4_MD4_G(x, y, z) (((x) & (y)) + (((x) ^ (y)) & (z)))
+#define EXT4_MD4_H(x, y, z) ((x) ^ (y) ^ (z))
+#define EXT4_MD4_ROUND(f, a, b, c, d, x, s) (a += f(b, c, d) + (x), a = EXT4_ROL32(a, s))
+#define EXT4_MD4_K2 0x5A827999
+#define EXT4_MD4_K3 0x6ED9EBA1
+
+/**
+ * The half MD4 transform used by the htree hash. It runs the three MD4 rounds
+ * on eight input words.
+ */
+
+static void fsw_ext4_half_md4_transform(fsw_u32 buf[4], const fsw_u32 in[8])
+{
+    fsw_u32 a = buf[0], b = buf[1], c = buf[2], d = buf[3];
+
+    // Round 1
+    EXT4_MD4_ROUND(EXT4_MD4_F, a, b, c, d, in[0],  3);
+    EXT4_MD4_ROUND(EXT4_MD4_F, d, a, b, c, in[1],  7);
+    EXT4_MD4_ROUND(EXT4_MD4_F, c, d, a, b, in[2], 11);
+    EXT4_MD4_ROUND(EXT4_MD4_F, b, c, d, a, in[3], 19);
+    EXT4_MD4_ROUND(EXT4_MD4_F, a, b, c, d, in[4],  3);
+    EXT4_MD4_ROUND(EXT4_MD4_F, d, a, b, c, in[5],  7);
+    EXT4_MD4_ROUND(EXT4_MD4_F, c, d, a, b, in[6], 11);
+    EXT4_MD4_ROUND(EXT4_MD4_F, b, c, d, a, in[7], 19);
+
+    // Round 2
+    EXT4_MD4_ROUND(EXT4_MD4_G, a, b, c, d, in[1] + EXT4_MD4_K2,  3);
+    EXT4_MD4_ROUND(EXT4_MD4_G, d, a, b, c, in[3] + EXT4_MD4_K2,  5);
+    EXT4_MD4_ROUND(EXT4_MD4_G, c, d, a, b, in[5] + EXT4_MD4_K2,  9);
+    EXT4_MD4_ROUND(EXT4_MD4_G, b, c, d, a, in[7] + EXT4_MD4_K2, 13);
+    EXT4_MD4_ROUND(EXT4_MD4_G, a, b, c, d, in[0] + EXT4_MD4_K2,  3);
+    EXT4_MD4_ROUND(EXT4_MD4_G, d, a, b, c, in[2] + EXT4_MD4_K2,  5);
+    EXT4_MD4_ROUND(EXT4_MD4_G, c, d, a, b, in[4] + EXT4_MD4_K2,  9);
+    EXT4_MD4_ROUND(EXT4_MD4_G, b, c, d, a, in[6] + EXT4_MD4_K2, 13);
+
+    // Round 3
+    EXT4_MD4_ROUND(EXT4_MD4_H, a, b, c, d, in[3] + EXT4_MD4_K3,  3);
+    EXT4_MD4_ROUND(EXT4_MD4_H, d, a, b, c, in[7] + EXT4_MD4_K3,  9);
+    EXT4_MD4_ROUND(EXT4_MD4_H, c, d, a, b, in[2] + EXT4_MD4_K3, 11);
+    EXT4_MD4_ROUND(EXT4_MD4_H, b, c, d, a, in[6] + EXT4_MD4_K3, 15);
+    EXT4_MD4_ROUND(EXT4_MD4_H, a, b, c, d, in[1] + EXT4_MD4_K3,  3);
+    EXT4_MD4_ROUND(EXT4_MD4_H, d, a, b, c, in[5] + EXT4_MD4_K3,  9);
+    EXT4_MD4_ROUND(EXT4_MD4_H, c, d, a, b, in[0] + EXT4_MD4_K3, 11);
+    EXT4_MD4_ROUND(EXT4_MD4_H, b, c, d, a, in[4] + EXT4_MD4_K3, 15);
+
+    buf[0] += a;
+    buf[1] += b;
+    buf[2] += c;
+    buf[3] += d;
+}
+
+/**
+ * The TEA transform used by the htree hash.
+ */
+
+static void fsw_ext4_tea_transform(fsw_u32 buf[4], const fsw_u32 in[4])
+{
+    fsw_u32 sum = 0;
+    fsw_u32 b0 = buf[0], b1 = buf[1];
+    fsw_u32 a = in[0], b = in[1], c = in[2], d = in[3];
+    int     n = 16;
+
+    do {
+        sum += 0x9E3779B9;
+        b0 += ((b1 << 4) + a) ^ (b1 + sum) ^ ((b1 >> 5) + b);
+        b1 += ((b0 << 4) + c) ^ (b0 + sum) ^ ((b0 >> 5) + d);
+    } while (--n);
+
+    buf[0] += b0;
+    buf[1] += b1;
+}
+
+/**
+ * Compute the htree hash of a file name, the same way the Linux kernel does.
+ * Returns FSW_UNSUPPORTED for hash versions we do not implement.
+ */
+
+static fsw_status_t fsw_ext4_dirhash(struct fsw_ext4_volume *vol, int hash_version,
+                                     const fsw_u8 *name, int len, fsw_u32 *hash_out)
+{
+    fsw_u32         hash, buf[4], in[8];
+    int             i, is_unsigned = 0;
+
+    // use the superblock's seed unless it is all zeros
+    buf[0] = 0x67452301;
+    buf[1] = 0xefcdab89;
+    buf[2] = 0x98badcfe;
+    buf[3] = 0x10325476;
+    for (i = 0; i < 4; i++) {
+        if (vol->sb->s_hash_seed[i]) {
+            fsw_memcpy(buf, vol->sb->s_hash_seed, sizeof (buf));
+            break;
+        }
+    }
+
+    switch (hash_version) {
+        case DX_HASH_LEGACY_UNSIGNED:
+            is_unsigned = 1;
+            // fall through
+        case DX_HASH_LEGACY:
+            hash = fsw_ext4_dx_hack_hash(name, len, is_unsigned);
+            break;
+
+        case DX_HASH_HALF_MD4_UNSIGNED:
+            is_unsigned = 1;
+            // fall through
+        case DX_HASH_HALF_MD4:
+            for (; len > 0; len -= 32, name += 32) {
+                fsw_ext4_str2hashbuf(name, len, in, 8, is_unsigned);
+                fsw_ext4_half_md4_transform(buf, in);
+            }
+            hash = buf[1];
+            break;
+
+        case DX_HASH_TEA_UNSIGNED:
+            is_unsigned = 1;
+            // fall through
+        case DX_HASH_TEA:
+            for (; len > 0; len -= 16, name += 16) {
+                fsw_ext4_str2hashbuf(name, len, in, 4, is_unsigned);
+                fsw_ext4_tea_transform(buf, in);
+            }
+            hash = buf[0];
+            break;
+
+        default:
+            return FSW_UNSUPPORTED;
+    }
+
+    hash &= ~1;
+    if (hash == ((fsw_u32)EXT4_HTREE_EOF_32BIT << 1))
+        hash = ((fsw_u32)EXT4_HTREE_EOF_32BIT - 1) << 1;
+
+    *hash_out = hash;
+    return FSW_SUCCESS;
+}
+
+/**
+ * Get a logical block of a directory from the block cache. The caller must release
+ * it with fsw_block_release on the returned physical block number.
+ */
+
+static fsw_status_t fsw_ext4_dir_block_get(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                           fsw_u32 log_bno, fsw_u64 *phys_bno_out, fsw_u8 **buffer_out)
+{
+    fsw_status_t    status;
+    struct fsw_extent extent;
+
+    if ((fsw_u64)log_bno * vol->g.log_blocksize >= dno->g.size)
+        return FSW_VOLUME_CORRUPTED;
+
+    extent.log_start = log_bno;
+    status = fsw_ext4_get_extent(vol, dno, &extent);
+    if (status)
+        return status;
+    if (extent.type != FSW_EXTENT_TYPE_PHYSBLOCK)
+        return FSW_VOLUME_CORRUPTED;
+
+    *phys_bno_out = extent.phys_start;
+    return fsw_block_get(vol, extent.phys_start, 1, (void **) buffer_out);
+}
+
+/**
+ * Scan one leaf block of a hash-indexed directory for a name.
+ */
+
+static fsw_status_t fsw_ext4_dx_scan_leaf(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                          fsw_u32 log_bno, struct fsw_string *name, fsw_u32 *child_ino_out)
+{
+    fsw_status_t    status;
+    fsw_u64         phys_bno;
+    fsw_u8          *buffer;
+    fsw_u32         offset;
+    struct ext4_dir_entry *entry;
+
+    status = fsw_ext4_dir_block_get(vol, dno, log_bno, &phys_bno, &buffer);
+    if (status)
+        return status;
+
+    status = FSW_NOT_FOUND;
+    for (offset = 0; offset + 8 <= vol->g.log_blocksize; offset += entry->rec_len) {
+        entry = (struct ext4_dir_entry *)(buffer + offset);
+        if (entry->rec_len < 8 || offset + entry->rec_len > vol->g.log_blocksize ||
+            8 + entry->name_len > entry->rec_len) {
+            status = FSW_VOLUME_CORRUPTED;
+            break;
+        }
+        if (entry->inode != 0 && entry->name_len == name->len &&
+            fsw_memeq(entry->name, name->data, name->len)) {
+            *child_ino_out = entry->inode;
+            status = FSW_SUCCESS;
+            break;
+        }
+    }
+
+    fsw_block_release(vol, phys_bno, buffer);
+    return status;
+}
+
+/**
+ * Get an index node of a hash-indexed directory and check its count and limit. The
+ * entries start at the given offset in the block. The caller must release the block
+ * with fsw_block_release on the returned physical block number.
+ */
+
+static fsw_status_t fsw_ext4_dx_node_get(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                         fsw_u32 log_bno, fsw_u32 offset, fsw_u64 *phys_bno_out,
+                                         fsw_u8 **buffer_out, struct dx_entry **entries_out,
+                                         fsw_u32 *count_out)
+{
+    fsw_status_t    status;
+    struct dx_countlimit *countlimit;
+    struct dx_entry *entries;
+
+    if (offset + sizeof (struct dx_entry) > vol->g.log_blocksize)
+        return FSW_VOLUME_CORRUPTED;
+
+    status = fsw_ext4_dir_block_get(vol, dno, log_bno, phys_bno_out, buffer_out);
+    if (status)
+        return status;
+
+    entries = (struct dx_entry *)(*buffer_out + offset);
+    countlimit = (struct dx_countlimit *)entries;
+    if (countlimit->count == 0 || countlimit->count > countlimit->limit ||
+        (fsw_u8 *)(entries + countlimit->limit) > *buffer_out + vol->g.log_blocksize) {
+        fsw_block_release(vol, *phys_bno_out, *buffer_out);
+        return FSW_VOLUME_CORRUPTED;
+    }
+
+    *entries_out = entries;
+    *count_out = countlimit->count;
+    return FSW_SUCCESS;
+}
+
+/**
+ * Step from the current leaf block of a hash-indexed directory to the next one, the
+ * way the kernel's ext4_htree_next_block does. The path of index nodes leading to the
+ * current leaf is kept in the frame arrays. The deepest node with an entry after ours
+ * gives the next leaf's starting hash; if that is not a collision continuation of our
+ * hash, the name is not in the directory and FSW_NOT_FOUND is returned. Otherwise the
+ * frames are moved to the next leaf, which is the first one below that entry.
+ */
+
+static fsw_status_t fsw_ext4_dx_next_leaf(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                          fsw_u32 hash, int depth, fsw_u32 *frame_bno,
+                                          fsw_u32 *frame_offset, fsw_u32 *frame_at, fsw_u32 *log_bno_out)
+{
+    fsw_status_t    status;
+    fsw_u64         phys_bno;
+    fsw_u8          *buffer;
+    struct dx_entry *entries;
+    fsw_u32         count, next_hash, log_bno;
+    int             level;
+
+    // find the deepest index node with an entry after ours
+    for (level = depth - 1; ; level--) {
+        status = fsw_ext4_dx_node_get(vol, dno, frame_bno[level], frame_offset[level],
+                                      &phys_bno, &buffer, &entries, &count);
+        if (status)
+            return status;
+        if (frame_at[level] + 1 < count)
+            break;
+        fsw_block_release(vol, phys_bno, buffer);
+        if (level == 0)
+            return FSW_NOT_FOUND;
+    }
+
+    frame_at[level]++;
+    next_hash = entries[frame_at[level]].hash;
+    log_bno = entries[frame_at[level]].block & 0x0fffffff;
+    fsw_block_release(vol, phys_bno, buffer);
+
+    // only a set collision bit means that our hash goes on in the next block
+    if (!(next_hash & 1) || (next_hash & ~1) != hash)
+        return FSW_NOT_FOUND;
+
+    // descend along the first entries to the leaf
+    for (level++; level < depth; level++) {
+        frame_bno[level] = log_bno;
+        frame_offset[level] = 8;
+        frame_at[level] = 0;
+
+        status = fsw_ext4_dx_node_get(vol, dno, log_bno, 8, &phys_bno, &buffer, &entries, &count);
+        if (status)
+            return status;
+        log_bno = entries[0].block & 0x0fffffff;
+        fsw_block_release(vol, phys_bno, buffer);
+    }
+
+    *log_bno_out = log_bno;
+    return FSW_SUCCESS;
+}
+
+/**
+ * Look up a name in a hash-indexed directory. The name's hash is searched for in
+ * the root and interior index blocks, which leads to the leaf block that can hold
+ * the name. If a hash collision continues in the following leaf blocks, those are
+ * searched too. Returns FSW_NOT_FOUND if the name is not in the directory, or
+ * FSW_UNSUPPORTED / FSW_VOLUME_CORRUPTED if the caller should fall back to a
+ * linear scan.
+ */
+
+static fsw_status_t fsw_ext4_dx_lookup(struct fsw_ext4_volume *vol, struct fsw_ext4_dnode *dno,
+                                       struct fsw_string *lookup_name, fsw_u32 *child_ino_out)
+{
+    fsw_status_t    status;
+    struct fsw_string name;
+    fsw_u64         phys_bno;
+    fsw_u8          *buffer;
+    struct dx_root_info *info;
+    struct dx_entry *entries;
+    fsw_u32         hash, count, lo, hi, mid, at, log_bno;
+    fsw_u32         frame_bno[EXT4_HTREE_LEVEL], frame_offset[EXT4_HTREE_LEVEL], frame_at[EXT4_HTREE_LEVEL];
+    int             level, depth, max_levels, hash_version;
+
+    // names are hashed and compared as the raw bytes stored on disk
+    status = fsw_strdup_coerce(&name, FSW_STRING_TYPE_ISO88591, lookup_name);
+    if (status)
+        return status;
+    if (name.len == 0 || name.len > EXT4_NAME_LEN || !fsw_streq(&name, lookup_name)) {
+        status = FSW_UNSUPPORTED;
+        goto errorexit;
+    }
+
+    // read the root block and check its dx_root_info
+    status = fsw_ext4_dir_block_get(vol, dno, 0, &phys_bno, &buffer);
+    if (status)
+        goto errorexit;
+
+    info = (struct dx_root_info *)(buffer + 24);
+    max_levels = (vol->sb->s_feature_incompat & EXT4_FEATURE_INCOMPAT_LARGEDIR) ?
+                 EXT4_HTREE_LEVEL : EXT4_HTREE_LEVEL_COMPAT;
+    hash_version = info->hash_version;
+    if (hash_version <= DX_HASH_TEA && (vol->sb->s_flags & EXT4_FLAGS_UNSIGNED_HASH))
+        hash_version += DX_HASH_LEGACY_UNSIGNED;
+    if (info->reserved_zero != 0 || info->info_length < 8 ||
+        info->indirect_levels >= max_levels) {
+        status = FSW_UNSUPPORTED;
+    } else {
+        status = fsw_ext4_dirhash(vol, hash_version, name.data, name.len, &hash);
+    }
+    depth = info->indirect_levels + 1;
+    frame_bno[0] = 0;
+    frame_offset[0] = 24 + info->info_length;
+    fsw_block_release(vol, phys_bno, buffer);
+    if (status)
+        goto errorexit;
+
+    // descend through the index nodes, remembering the path for fsw_ext4_dx_next_leaf
+    for (level = 0; level < depth; level++) {
+        status = fsw_ext4_dx_node_get(vol, dno, frame_bno[level], frame_offset[level],
+                                      &phys_bno, &buffer, &entries, &count);
+        if (status)
+            goto errorexit;
+
+        // find the last entry with a hash not above ours; entry 0 covers all lower hashes
+        at = 0;
+        lo = 1;
+        hi = count - 1;
+        while (lo <= hi) {
+            mid = lo + (hi - lo) / 2;
+            if (entries[mid].hash > hash) {
+                hi = mid - 1;
+            } else {
+                at = mid;
+                lo = mid + 1;
+            }
+        }
+        frame_at[level] = at;
+        log_bno = entries[at].block & 0x0fffffff;
+        fsw_block_release(vol, phys_bno, buffer);
+
+        if (level + 1 < depth) {
+            frame_bno[level + 1] = log_bno;
+            frame_offset[level + 1] = 8;
+        }
+    }
+
+    // search the leaf, then any following leaves our hash continues into
+    while (1) {
+        status = fsw_ext4_dx_scan_leaf(vol, dno, log_bno, &name, child_ino_out);
+        if (status != FSW_NOT_FOUND)
+            break;
+        status = fsw_ext4_dx_next_leaf(vol, dno, hash, depth, frame_bno, frame_offset, frame_at, &log_bno);
+        if (status)
+            break;
+    }
+
+errorexit:
+    fsw_strfree(&name);
+    return status;
+}
+
 /**
  * Get the next directory entry when reading a directory. This function is called during
  * directory iteration to retrieve the next directory entry. A dnode is constructed for
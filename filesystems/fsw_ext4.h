@@ -60,6 +60,9 @@ struct fsw_ext4_dnode {
     struct fsw_dnode g;             //!< Generic dnode structure
     
     struct ext4_inode *raw;         //!< Full raw inode structure
+    fsw_u64     ext_leaf_bno;       //!< Physical block of the last extent tree leaf visited, 0 if none
+    fsw_u32     ext_leaf_start;     //!< First logical block covered by that leaf
+    fsw_u32     ext_leaf_end;       //!< First logical block past the range of that leaf
 };
 
 
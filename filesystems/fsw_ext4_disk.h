@@ -425,6 +425,45 @@ struct ext4_dir_entry {
 // NOTE: The original Linux kernel header defines ext4_dir_entry with the original
 //  layout and ext4_dir_entry_2 with the revised layout. We simply use the revised one.
 
+/*
+ * Hash-indexed (htree) directories. Block 0 of an indexed directory holds the
+ * fake "." and ".." entries followed by dx_root_info and the root dx_entry array.
+ * Interior index blocks start with a fake empty entry spanning the whole block.
+ * In both cases the first dx_entry's hash field holds a dx_countlimit.
+ */
+#define DX_HASH_LEGACY              0
+#define DX_HASH_HALF_MD4            1
+#define DX_HASH_TEA                 2
+#define DX_HASH_LEGACY_UNSIGNED     3
+#define DX_HASH_HALF_MD4_UNSIGNED   4
+#define DX_HASH_TEA_UNSIGNED        5
+
+#define EXT4_HTREE_LEVEL_COMPAT     2   /* Index levels without LARGEDIR */
+#define EXT4_HTREE_LEVEL            3   /* Index levels with LARGEDIR */
+#define EXT4_HTREE_EOF_32BIT        0x7fffffff
+
+/* s_flags */
+#define EXT4_FLAGS_SIGNED_HASH      0x0001  /* Signed dirhash in use */
+#define EXT4_FLAGS_UNSIGNED_HASH    0x0002  /* Unsigned dirhash in use */
+
+struct dx_root_info {
+    __le32  reserved_zero;
+    __u8    hash_version;
+    __u8    info_length;            /* 8 */
+    __u8    indirect_levels;
+    __u8    unused_flags;
+};
+
+struct dx_countlimit {
+    __le16  limit;
+    __le16  count;
+};
+
+struct dx_entry {
+    __le32  hash;
+    __le32  block;
+};
+
 /*
  * Ext2 directory file types.  Only the low 3 bits are used.  The
  * other bits are reserved for now.
@@ -497,5 +536,13 @@ struct ext4_extent_header {
 
 #define EXT4_EXT_MAGIC		(0xf30a)
 
+/*
+ * ee_len values above EXT_INIT_MAX_LEN mark uninitialized (preallocated)
+ * extents, which read back as zeros.
+ */
+#define EXT_INIT_MAX_LEN	(1UL << 15)
+
+#define EXT4_MAX_EXTENT_DEPTH	5
+
 
 #endif
@@ -78,6 +78,8 @@ static fsw_status_t fsw_hfs_read_dirrec(struct fsw_shandle *shand, struct hfs_di
 static fsw_status_t fsw_hfs_readlink(struct fsw_hfs_volume *vol, struct fsw_hfs_dnode *dno,
                                          struct fsw_string *link);
 
+static void         fsw_hfs_btree_free_cache(struct fsw_hfs_btree *btree);
+
 //
 // Dispatch Table
 //
@@ -480,6 +482,9 @@ str[strMaxLen] = '\0';
 
 static void fsw_hfs_volume_free(struct fsw_hfs_volume *vol)
 {
+    fsw_hfs_btree_free_cache(&vol->catalog_tree);
+    fsw_hfs_btree_free_cache(&vol->extents_tree);
+
     if (vol->primary_voldesc)
     {
         fsw_free(vol->primary_voldesc);
@@ -597,6 +602,112 @@ fsw_hfs_btree_rec (struct fsw_hfs_btree   * btree,
 }
 
 
+/*
+ * Get a node through the tree's node cache. The root and index nodes are moved
+ * to pinned slots while there are some left, leaves share the other slots in
+ * LRU order. The node stays valid until the next call on the same tree.
+ */
+static fsw_status_t
+fsw_hfs_btree_get_node (struct fsw_hfs_btree * btree,
+                        fsw_u32                node_no,
+                        BTNodeDescriptor    ** node_out)
+{
+    struct fsw_hfs_btree_cnode ** bucket;
+    struct fsw_hfs_btree_cnode ** link;
+    struct fsw_hfs_btree_cnode  * cn;
+    struct fsw_hfs_btree_cnode  * victim = NULL;
+    BTNodeDescriptor            * node;
+    fsw_status_t                  status;
+    fsw_u32                       i;
+
+    bucket = &btree->cache_hash[node_no & (HFS_BTREE_HASH_SIZE - 1)];
+    for (cn = *bucket; cn != NULL; cn = cn->hash_next)
+    {
+        if (cn->node_no == node_no)
+        {
+            cn->last_use = ++btree->cache_clock;
+            *node_out = (BTNodeDescriptor *) cn->data;
+            return FSW_SUCCESS;
+        }
+    }
+
+    for (i = HFS_BTREE_CACHE_PINNED; i < HFS_BTREE_CACHE_SIZE; i++)
+    {
+        cn = &btree->cache[i];
+        if (victim == NULL || (victim->valid && (!cn->valid || cn->last_use < victim->last_use)))
+            victim = cn;
+    }
+
+    if (victim->valid)
+    {
+        for (link = &btree->cache_hash[victim->node_no & (HFS_BTREE_HASH_SIZE - 1)]; *link != NULL; link = &(*link)->hash_next)
+        {
+            if (*link == victim)
+            {
+                *link = victim->hash_next;
+                break;
+            }
+        }
+        victim->valid = 0;
+    }
+
+    if (victim->data == NULL)
+    {
+        status = fsw_alloc(btree->node_size, &victim->data);
+        if (status)
+            return status;
+    }
+
+    if (fsw_hfs_read_file (btree->file,
+                           (fsw_u64)node_no * btree->node_size,
+                           btree->node_size, victim->data) <= 0)
+        return FSW_VOLUME_CORRUPTED;
+
+    /* the record offsets, plus the free space offset, must fit behind the descriptor */
+    node = (BTNodeDescriptor *) victim->data;
+    if (sizeof (BTNodeDescriptor) + 2 * ((fsw_u32)be16_to_cpu (node->numRecords) + 1) > btree->node_size)
+        return FSW_VOLUME_CORRUPTED;
+
+    cn = victim;
+    if ((node->kind == kBTIndexNode || node_no == btree->root_node)
+        && btree->cache_pinned < HFS_BTREE_CACHE_PINNED)
+    {
+        /* hand the buffer over to the next pinned slot */
+        cn = &btree->cache[btree->cache_pinned++];
+        cn->data = victim->data;
+        victim->data = NULL;
+    }
+
+    cn->node_no = node_no;
+    cn->valid = 1;
+    cn->last_use = ++btree->cache_clock;
+    cn->hash_next = *bucket;
+    *bucket = cn;
+
+    *node_out = node;
+    return FSW_SUCCESS;
+}
+
+static void
+fsw_hfs_btree_free_cache (struct fsw_hfs_btree * btree)
+{
+    fsw_u32 i;
+
+    for (i = 0; i < HFS_BTREE_CACHE_SIZE; i++)
+    {
+        if (btree->cache[i].data != NULL)
+            fsw_free(btree->cache[i].data);
+    }
+    fsw_memzero(btree->cache, sizeof (btree->cache));
+    fsw_memzero(btree->cache_hash, sizeof (btree->cache_hash));
+    btree->cache_pinned = 0;
+}
+
+/*
+ * Find the record with the given key. On success *result points to the cached
+ * leaf node holding it, valid until the next search on the same tree, and
+ * *key_offset is the record index in that node.
+ */
 static fsw_status_t
 fsw_hfs_btree_search (struct fsw_hfs_btree * btree,
                       BTreeKey             * key,
@@ -608,144 +719,91 @@ fsw_hfs_btree_search (struct fsw_hfs_btree * btree,
     fsw_u32 currnode;
     fsw_u32 rec;
     fsw_status_t status;
-    fsw_u8* buffer = NULL;
+    fsw_u32 depth = 0;
 
     currnode = btree->root_node;
-    status = fsw_alloc(btree->node_size, &buffer);
-    if (status)
-        return status;
-    node = (BTNodeDescriptor*)buffer;
 
     while (1)
     {
-        int cmp = 0;
-        int match;
         fsw_u32 count;
+        fsw_u32 lower, upper, index;
+        int cmp;
 
-    readnode:
-        match = 0;
-        /* Read a node.  */
-        if (fsw_hfs_read_file (btree->file,
-                               (fsw_u64)currnode * btree->node_size,
-                               btree->node_size, buffer) <= 0)
-        {
-            status = FSW_VOLUME_CORRUPTED;
-            break;
-        }
-
-        if (be16_to_cpu(*(fsw_u16*)(buffer + btree->node_size - 2)) != sizeof (BTNodeDescriptor))
-            BP("corrupted node\n");
+        status = fsw_hfs_btree_get_node (btree, currnode, &node);
+        if (status)
+            return status;
 
         count = be16_to_cpu (node->numRecords);
 
-#if 1
+        /* Binary search: lower ends up as the number of records not above the key */
+        lower = 0;
+        upper = count;
         /* coverity[tainted_data: SUPPRESS] */
-        for (rec = 0; rec < count; rec++)
+        while (lower < upper)
         {
-             BTreeKey *currkey;
-
-             currkey = fsw_hfs_btree_rec (btree, node, rec);
-             cmp = compare_keys (currkey, key);
-             //fprintf(stderr, "rec=%d cmp=%d kind=%d \n", rec, cmp, node->kind);
-
-             /* Leaf node. */
-             if (node->kind == kBTLeafNode)
-             {
-               if (cmp == 0)
-               {
-                 /* Found!  */
-                 *result = node;
-                 *key_offset = rec;
-
-                 status = FSW_SUCCESS;
-                 goto done;
-               }
-             }
-             else if (node->kind == kBTIndexNode)
-             {
-                 fsw_u32 *pointer;
-
-                 if (cmp > 0)
-                     break;
-
-                 pointer = (fsw_u32 *) ((char *) currkey
-                                        + be16_to_cpu (currkey->length16)
-                                        + 2);
-                 currnode = be32_to_cpu (*pointer);
-                 match = 1;
-             }
+            index = lower + (upper - lower) / 2;
+            cmp = compare_keys (fsw_hfs_btree_rec (btree, node, index), key);
+            if (cmp == 0 && node->kind == kBTLeafNode)
+            {
+                /* Found!  */
+                *result = node;
+                *key_offset = index;
+                return FSW_SUCCESS;
+            }
+            if (cmp <= 0)
+                lower = index + 1;
+            else
+                upper = index;
         }
 
-        if (node->kind == kBTLeafNode && cmp < 0 && node->fLink)
+        if (node->kind == kBTLeafNode)
         {
-            currnode = be32_to_cpu(node->fLink);
-            goto readnode;
+            /*
+             * Case folding here only covers Latin-1, so names ordered by the
+             * full HFS+ rules may look unsorted to us. Check the whole leaf
+             * before giving up on it.
+             */
+            for (rec = 0; rec < count; rec++)
+            {
+                if (compare_keys (fsw_hfs_btree_rec (btree, node, rec), key) == 0)
+                {
+                    *result = node;
+                    *key_offset = rec;
+                    return FSW_SUCCESS;
+                }
+            }
+
+            /* The key sorts after this whole leaf, try the next one */
+            if (count > 0 && lower == count && node->fLink)
+            {
+                currnode = be32_to_cpu(node->fLink);
+                continue;
+            }
+            return FSW_NOT_FOUND;
         }
-        else if (!match)
+        else if (node->kind == kBTIndexNode)
         {
-            status = FSW_NOT_FOUND;
-            break;
+            BTreeKey *currkey;
+            fsw_u32 *pointer;
+
+            if (lower == 0)
+                return FSW_NOT_FOUND;
+            if (++depth > HFS_BTREE_MAX_DEPTH)
+                return FSW_VOLUME_CORRUPTED;
+
+            currkey = fsw_hfs_btree_rec (btree, node, lower - 1);
+            pointer = (fsw_u32 *) ((char *) currkey
+                                   + be16_to_cpu (currkey->length16)
+                                   + 2);
+            currnode = be32_to_cpu (*pointer);
+        }
+        else
+        {
+            return FSW_NOT_FOUND;
         }
-#else
-         /* Perform binary search */
-         fsw_u32 lower = 0;
-         fsw_u32 upper = count - 1;
-         fsw_s32 cmp = -1;
-         BTreeKey *currkey = NULL;
-
-         if (count == 0)
-         {
-             status = FSW_NOT_FOUND;
-             goto done;
-         }
-
-         while (lower <= upper)
-         {
-             fsw_u32 index = (lower + upper) / 2;
-
-             currkey = fsw_hfs_btree_rec (btree, node, index);
-
-             cmp = compare_keys (currkey, key);
-             if (cmp < 0)  upper = index - 1;
-             if (cmp > 0)  lower = index + 1;
-             if (cmp == 0)
-             {
-                 /* Found!  */
-                 *result = node;
-                 *key_offset = rec;
-
-                 status = FSW_SUCCESS;
-                 goto done;
-             }
-         }
-
-         if (cmp < 0)
-             currkey = fsw_hfs_btree_rec (btree, node, upper);
-
-         if (node->kind == kBTIndexNode && currkey)
-         {
-             fsw_u32 *pointer;
-
-             pointer = (fsw_u32 *) ((char *) currkey
-                                    + be16_to_cpu (currkey->length16)
-                                    + 2);
-             currnode = be32_to_cpu (*pointer);
-         }
-         else
-         {
-             status = FSW_NOT_FOUND;
-             break;
-         }
-#endif
     }
-
-
-  done:
-    if (buffer != NULL && status != FSW_SUCCESS)
-        fsw_free(buffer);
-
-    return status;
 }
+
 typedef struct
 {
     fsw_u32                 id;
@@ -854,13 +912,7 @@ fsw_hfs_btree_iterate_node (struct fsw_hfs_btree * btree,
                             void                  * param)
 {
   fsw_status_t status;
-  /* We modify node, so make a copy */
   BTNodeDescriptor * node   = first_node;
-  fsw_u8           * buffer = NULL;
-
-  status = fsw_alloc(btree->node_size, &buffer);
-  if (status)
-      return status;
 
   while (1)
   {
@@ -892,21 +944,13 @@ fsw_hfs_btree_iterate_node (struct fsw_hfs_btree * btree,
           break;
       }
 
-      if (fsw_hfs_read_file (btree->file,
-                             (fsw_u64) (next_node) * btree->node_size,
-                             btree->node_size, buffer) <= 0)
-      {
-          status = FSW_VOLUME_CORRUPTED;
+      status = fsw_hfs_btree_get_node (btree, next_node, &node);
+      if (status)
           goto done;
-      }
 
-      node = (BTNodeDescriptor*)buffer;
       first_rec = 0;
   }
  done:
-  if (buffer)
-      fsw_free(buffer);
-
   return status;
 }
 
@@ -1082,14 +1126,9 @@ static fsw_status_t fsw_hfs_get_extent(struct fsw_hfs_volume * vol,
 
         /* Find appropriate overflow record */
         overflowkey.fileID = dno->g.dnode_id;
+        overflowkey.forkType = 0;
         overflowkey.startBlock = extent->log_start - lbno;
 
-        if (node != NULL)
-        {
-            fsw_free(node);
-            node = NULL;
-        }
-
         status = fsw_hfs_btree_search (&vol->extents_tree,
                                        (BTreeKey*) &overflowkey,
                                        fsw_hfs_cmp_extkey,
@@ -1102,9 +1141,6 @@ static fsw_status_t fsw_hfs_get_extent(struct fsw_hfs_volume * vol,
         exts = (HFSPlusExtentRecord*) (key + 1);
     }
 
-    if (node != NULL)
-        fsw_free(node);
-
     return status;
 }
 
@@ -1294,9 +1330,6 @@ create:
 
 done:
 
-    if (node != NULL)
-        fsw_free(node);
-
     if (free_data)
         fsw_strfree(&rec_name);
 
@@ -110,6 +110,27 @@ struct fsw_hfs_dnode
   fsw_u64                   used_bytes;
 };
 
+//! Number of B-tree nodes cached per tree
+#define HFS_BTREE_CACHE_SIZE     40
+//! Of those, how many are set aside for pinning the root and index nodes
+#define HFS_BTREE_CACHE_PINNED   32
+//! Number of hash buckets for the node cache. Must be a power of 2.
+#define HFS_BTREE_HASH_SIZE      64
+//! Deepest B-tree we descend before calling it corrupted
+#define HFS_BTREE_MAX_DEPTH      16
+
+/**
+ * HFS: Cached B-tree node.
+ */
+struct fsw_hfs_btree_cnode
+{
+    fsw_u32                  node_no;
+    fsw_u32                  last_use;
+    int                      valid;
+    fsw_u8*                  data;
+    struct fsw_hfs_btree_cnode* hash_next;
+};
+
 /**
  * HFS: In-memory B-tree structure.
  */
@@ -118,6 +139,10 @@ struct fsw_hfs_btree
     fsw_u32                  root_node;
     fsw_u32                  node_size;
     struct fsw_hfs_dnode*    file;
+    struct fsw_hfs_btree_cnode  cache[HFS_BTREE_CACHE_SIZE];   // pinned slots first, then LRU slots
+    struct fsw_hfs_btree_cnode* cache_hash[HFS_BTREE_HASH_SIZE];
+    fsw_u32                  cache_clock;
+    fsw_u32                  cache_pinned;
 };
 
 
@@ -0,0 +1,246 @@
+/**
+ * \file fsw_bench.c
+ * Benchmark program for the POSIX user space environment.
+ *
+ * Mounts an image file with the driver selected by FSTYPE and runs a fixed
+ * set of workloads on it: a cold mount, a recursive listing, a series of path
+ * lookups and a sequential read of the largest file found. For each workload
+ * it reports the wall time, the reads issued on the image, the block cache
+ * hit rate, the directory entry cache hits and misses and the bytes copied
+ * to the caller.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fsw_posix.h"
+
+#include <time.h>
+
+
+#define STRINGIFY2(x) #x
+#define STRINGIFY(x) STRINGIFY2(x)
+
+//! Default number of path lookups
+#define BENCH_LOOKUPS       (1000)
+//! Maximum number of paths remembered from the listing
+#define BENCH_MAX_PATHS     (65536)
+//! Size of the reads issued by the sequential read workload
+#define BENCH_READ_SIZE     (64 * 1024)
+
+extern struct fsw_fstype_table FSW_FSTYPE_TABLE_NAME(FSTYPE);
+
+/**
+ * Counters sampled before and after each workload.
+ */
+
+struct bench_counters {
+    double      time_ms;            //!< Monotonic clock, in milliseconds
+    fsw_u64     read_calls;         //!< Reads issued on the image
+    fsw_u64     read_bytes;         //!< Bytes read from the image
+    fsw_u64     bcache_hits;        //!< Block cache hits
+    fsw_u64     bcache_misses;      //!< Block cache misses
+    fsw_u64     dcache_hits;        //!< Directory entry cache hits
+    fsw_u64     dcache_misses;      //!< Directory entry cache misses
+};
+
+static char     *paths[BENCH_MAX_PATHS];
+static int      path_count;
+static char     largest_path[4096];
+static fsw_u64  largest_size;
+
+static void sample(struct fsw_posix_volume *pvol, struct bench_counters *c)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    c->time_ms = ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+    c->read_calls = pvol ? pvol->read_calls : 0;
+    c->read_bytes = pvol ? pvol->read_bytes : 0;
+    c->bcache_hits = pvol ? pvol->vol->bcache_hits : 0;
+    c->bcache_misses = pvol ? pvol->vol->bcache_misses : 0;
+    c->dcache_hits = pvol ? pvol->vol->dcache_hits : 0;
+    c->dcache_misses = pvol ? pvol->vol->dcache_misses : 0;
+}
+
+static void report(const char *workload, struct bench_counters *before, struct bench_counters *after,
+                   fsw_u64 copied, int items)
+{
+    fsw_u64     hits = after->bcache_hits - before->bcache_hits;
+    fsw_u64     misses = after->bcache_misses - before->bcache_misses;
+    fsw_u64     dhits = after->dcache_hits - before->dcache_hits;
+    fsw_u64     dmisses = after->dcache_misses - before->dcache_misses;
+
+    printf("%-16s %10.2f %10llu %12llu %10llu %10llu %7.1f%% %10llu %10llu %14llu %8d\n",
+           workload, after->time_ms - before->time_ms,
+           (unsigned long long)(after->read_calls - before->read_calls),
+           (unsigned long long)(after->read_bytes - before->read_bytes),
+           (unsigned long long)hits, (unsigned long long)misses,
+           (hits + misses) ? 100.0 * hits / (hits + misses) : 0.0,
+           (unsigned long long)dhits, (unsigned long long)dmisses,
+           (unsigned long long)copied, items);
+}
+
+/**
+ * Recursively list a directory, remembering file paths and the largest file.
+ */
+
+static int listdir(struct fsw_posix_volume *pvol, const char *path)
+{
+    struct fsw_posix_dir *dir;
+    struct fsw_posix_file *file;
+    struct dirent *dent;
+    char        subpath[4096];
+    int         count = 0;
+
+    dir = fsw_posix_opendir(pvol, path);
+    if (dir == NULL)
+        return 0;
+    while ((dent = fsw_posix_readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0)
+            continue;
+        count++;
+        snprintf(subpath, sizeof (subpath), "%s%s", path, dent->d_name);
+
+        if (dent->d_type == DT_DIR) {
+            strncat(subpath, "/", sizeof (subpath) - strlen(subpath) - 1);
+            count += listdir(pvol, subpath);
+
+        } else if (dent->d_type == DT_REG) {
+            if (path_count < BENCH_MAX_PATHS)
+                paths[path_count++] = strdup(subpath);
+
+            file = fsw_posix_open(pvol, subpath, 0, 0);
+            if (file != NULL) {
+                if (file->shand.dnode->size > largest_size) {
+                    largest_size = file->shand.dnode->size;
+                    snprintf(largest_path, sizeof (largest_path), "%s", subpath);
+                }
+                fsw_posix_close(file);
+            }
+        }
+    }
+    fsw_posix_closedir(dir);
+
+    return count;
+}
+
+/**
+ * Open and close a series of paths picked from the listing with a fixed stride.
+ */
+
+static int lookup_paths(struct fsw_posix_volume *pvol, int lookups)
+{
+    struct fsw_posix_file *file;
+    int         i, found = 0;
+
+    for (i = 0; i < lookups && path_count > 0; i++) {
+        file = fsw_posix_open(pvol, paths[((fsw_u64)i * 7919) % path_count], 0, 0);
+        if (file != NULL) {
+            found++;
+            fsw_posix_close(file);
+        }
+    }
+    return found;
+}
+
+/**
+ * Read a file from start to end. Returns the number of bytes copied.
+ */
+
+static fsw_u64 read_file(struct fsw_posix_volume *pvol, const char *path)
+{
+    struct fsw_posix_file *file;
+    static char buf[BENCH_READ_SIZE];
+    fsw_u64     total = 0;
+    ssize_t     r;
+
+    file = fsw_posix_open(pvol, path, 0, 0);
+    if (file == NULL)
+        return 0;
+    while ((r = fsw_posix_read(file, buf, sizeof (buf))) > 0)
+        total += r;
+    fsw_posix_close(file);
+    return total;
+}
+
+int main(int argc, char **argv)
+{
+    struct fsw_posix_volume *pvol;
+    struct bench_counters before, after;
+    const char  *read_path = NULL;
+    fsw_u64     copied;
+    int         i, lookups = BENCH_LOOKUPS, items;
+
+    for (i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc - 1)
+            lookups = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc - 1)
+            read_path = argv[++i];
+        else
+            break;
+    }
+    if (i != argc - 1) {
+        fprintf(stderr, "Usage: fsw_bench_%s [-n lookups] [-f file] <image>\n", STRINGIFY(FSTYPE));
+        return 1;
+    }
+
+    printf("fsw_bench: %s driver on %s\n", STRINGIFY(FSTYPE), argv[i]);
+    printf("%-16s %10s %10s %12s %10s %10s %8s %10s %10s %14s %8s\n", "workload", "wall_ms", "disk_reads",
+           "disk_bytes", "bc_hits", "bc_misses", "hit_rate", "dc_hits", "dc_misses", "copied_bytes", "items");
+
+    // cold mount
+    sample(NULL, &before);
+    pvol = fsw_posix_mount(argv[i], &FSW_FSTYPE_TABLE_NAME(FSTYPE));
+    if (pvol == NULL) {
+        fprintf(stderr, "Mounting failed.\n");
+        return 1;
+    }
+    sample(pvol, &after);
+    report("mount", &before, &after, 0, 1);
+
+    // recursive listing, also collects the paths for the other workloads
+    sample(pvol, &before);
+    items = listdir(pvol, "/");
+    sample(pvol, &after);
+    report("list", &before, &after, 0, items);
+
+    // path lookups, first with the caches as the listing left them, then again
+    sample(pvol, &before);
+    items = lookup_paths(pvol, lookups);
+    sample(pvol, &after);
+    report("lookup", &before, &after, 0, items);
+
+    sample(pvol, &before);
+    items = lookup_paths(pvol, lookups);
+    sample(pvol, &after);
+    report("lookup (warm)", &before, &after, 0, items);
+
+    // sequential read
+    if (read_path == NULL)
+        read_path = largest_path;
+    if (read_path[0] != 0) {
+        sample(pvol, &before);
+        copied = read_file(pvol, read_path);
+        sample(pvol, &after);
+        report("read", &before, &after, copied, 1);
+
+        sample(pvol, &before);
+        copied = read_file(pvol, read_path);
+        sample(pvol, &after);
+        report("read (warm)", &before, &after, copied, 1);
+        printf("read file: %s\n", read_path);
+    }
+
+    fsw_posix_unmount(pvol);
+    for (i = 0; i < path_count; i++)
+        free(paths[i]);
+
+    return 0;
+}
+
+// EOF
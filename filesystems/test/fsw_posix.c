@@ -52,7 +52,8 @@ fsw_status_t fsw_posix_open_dno(struct fsw_posix_volume *pvol, const char *path,
 void fsw_posix_change_blocksize(struct fsw_volume *vol,
                               fsw_u32 old_phys_blocksize, fsw_u32 old_log_blocksize,
                               fsw_u32 new_phys_blocksize, fsw_u32 new_log_blocksize);
-fsw_status_t fsw_posix_read_block(struct fsw_volume *vol, fsw_u32 phys_bno, void *buffer);
+fsw_status_t fsw_posix_read_block(struct fsw_volume *vol, fsw_u64 phys_bno, void *buffer);
+fsw_status_t fsw_posix_read_blocks(struct fsw_volume *vol, fsw_u64 phys_bno, fsw_u32 count, void *buffer);
 
 /**
  * Dispatch table for our FSW host driver.
@@ -62,7 +63,8 @@ struct fsw_host_table   fsw_posix_host_table = {
     FSW_STRING_TYPE_ISO88591,
 
     fsw_posix_change_blocksize,
-    fsw_posix_read_block
+    fsw_posix_read_block,
+    fsw_posix_read_blocks
 };
 
 extern struct fsw_fstype_table   FSW_FSTYPE_TABLE_NAME(FSTYPE);
@@ -267,6 +269,7 @@ struct dirent * fsw_posix_readdir(struct fsw_posix_dir *dir)
 #endif
     memcpy(dent.d_name, dno->name.data, dno->name.size);
     dent.d_name[dno->name.size] = 0;
+    fsw_dnode_release(dno);
 
     return &dent;
 }
@@ -362,13 +365,13 @@ void fsw_posix_change_blocksize(struct fsw_volume *vol,
  * to read a block of data from the device. The buffer is allocated by the core code.
  */
 
-fsw_status_t fsw_posix_read_block(struct fsw_volume *vol, fsw_u32 phys_bno, void *buffer)
+fsw_status_t fsw_posix_read_block(struct fsw_volume *vol, fsw_u64 phys_bno, void *buffer)
 {
     struct fsw_posix_volume *pvol = (struct fsw_posix_volume *)vol->host_data;
     off_t           block_offset, seek_result;
     ssize_t         read_result;
 
-    FSW_MSG_DEBUGV((FSW_MSGSTR("fsw_posix_read_block: %d  (%d)\n"), phys_bno, vol->phys_blocksize));
+    FSW_MSG_DEBUGV((FSW_MSGSTR("fsw_posix_read_block: %d  (%d)\n"), (int)phys_bno, vol->phys_blocksize));
 
     // read from disk
     block_offset = (off_t)phys_bno * vol->phys_blocksize;
@@ -378,10 +381,81 @@ fsw_status_t fsw_posix_read_block(struct fsw_volume *vol, fsw_u32 phys_bno, void
     read_result = read(pvol->fd, buffer, vol->phys_blocksize);
     if (read_result != vol->phys_blocksize)
         return FSW_IO_ERROR;
+    pvol->read_calls++;
+    pvol->read_bytes += read_result;
+
+    return FSW_SUCCESS;
+}
+
+/**
+ * FSW interface function to read a run of data blocks straight into the caller's buffer.
+ * This function is called by the FSW core for large file reads.
+ */
+
+fsw_status_t fsw_posix_read_blocks(struct fsw_volume *vol, fsw_u64 phys_bno, fsw_u32 count, void *buffer)
+{
+    struct fsw_posix_volume *pvol = (struct fsw_posix_volume *)vol->host_data;
+    off_t           block_offset, seek_result;
+    ssize_t         read_result;
+    size_t          read_size;
+
+    FSW_MSG_DEBUGV((FSW_MSGSTR("fsw_posix_read_blocks: %d+%d  (%d)\n"), (int)phys_bno, count, vol->phys_blocksize));
+
+    // read from disk
+    block_offset = (off_t)phys_bno * vol->phys_blocksize;
+    read_size = (size_t)count * vol->phys_blocksize;
+    seek_result = lseek(pvol->fd, block_offset, SEEK_SET);
+    if (seek_result != block_offset)
+        return FSW_IO_ERROR;
+    read_result = read(pvol->fd, buffer, read_size);
+    if (read_result != (ssize_t)read_size)
+        return FSW_IO_ERROR;
+    pvol->read_calls++;
+    pvol->read_bytes += read_result;
 
     return FSW_SUCCESS;
 }
 
+/**
+ * Time mapping callback for the fsw_dnode_stat call. If the caller passed a
+ * struct stat as host data, the timestamp is stored there.
+ */
+
+void fsw_store_time_posix(struct fsw_dnode_stat *sb, int which, fsw_u32 posix_time)
+{
+    struct stat         *st = (struct stat *)sb->host_data;
+
+    if (st == NULL)
+        return;
+    if (which == FSW_DNODE_STAT_CTIME)
+        st->st_ctime = posix_time;
+    else if (which == FSW_DNODE_STAT_MTIME)
+        st->st_mtime = posix_time;
+    else if (which == FSW_DNODE_STAT_ATIME)
+        st->st_atime = posix_time;
+}
+
+/**
+ * Mode mapping callback for the fsw_dnode_stat call.
+ */
+
+void fsw_store_attr_posix(struct fsw_dnode_stat *sb, fsw_u16 posix_mode)
+{
+    struct stat         *st = (struct stat *)sb->host_data;
+
+    if (st != NULL)
+        st->st_mode = posix_mode;
+}
+
+/**
+ * EFI attribute callback for the fsw_dnode_stat call. There is nothing to map
+ * on a POSIX host.
+ */
+
+void fsw_store_attr_efi(struct fsw_dnode_stat *sb, fsw_u16 attr)
+{
+}
+
 
 /**
  * Time mapping callback for the fsw_dnode_stat call. This function converts
@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/dir.h>
+#include <sys/stat.h>
 
 
 /**
@@ -53,6 +54,8 @@ struct fsw_posix_volume {
     struct fsw_volume           *vol;           //!< FSW volume structure
 
     int                         fd;             //!< System file descriptor for data access
+    fsw_u64                     read_calls;     //!< Number of reads issued on fd
+    fsw_u64                     read_bytes;     //!< Number of bytes read from fd
 
 };
 
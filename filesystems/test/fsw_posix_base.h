@@ -87,4 +87,27 @@ typedef uint64_t            fsw_u64;
 #define RShiftU64(val, shift) ((val) >> (shift))
 #define LShiftU64(val, shift) ((val) << (shift))
 
+// EFI names used directly by some drivers
+
+#ifndef EFIAPI
+#define EFIAPI
+#endif
+
+typedef uintptr_t           UINTN;
+typedef uint32_t            UINT32;
+typedef unsigned char       BOOLEAN;
+
+#define TRUE  ((BOOLEAN)1)
+#define FALSE ((BOOLEAN)0)
+
+#define AllocatePool(size) malloc(size)
+#define FreePool(ptr) free(ptr)
+
+static inline uint64_t DivU64x32Remainder(uint64_t val, uint32_t divisor, uint32_t *remainder)
+{
+    if (remainder != NULL)
+        *remainder = (uint32_t)(val % divisor);
+    return val / divisor;
+}
+
 #endif
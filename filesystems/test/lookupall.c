@@ -0,0 +1,71 @@
+/**
+ * \file lookupall.c
+ * Lookup test program for the POSIX user space environment.
+ *
+ * Lists a directory of an image file and then looks up every entry in it by
+ * path. Each lookup goes through the driver's dir_lookup function, so this
+ * checks that a driver's indexed lookup finds everything that its directory
+ * iteration returns. Exits with 1 if any lookup fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fsw_posix.h"
+
+
+#define STRINGIFY2(x) #x
+#define STRINGIFY(x) STRINGIFY2(x)
+
+extern struct fsw_fstype_table FSW_FSTYPE_TABLE_NAME(FSTYPE);
+
+int main(int argc, char **argv)
+{
+    struct fsw_posix_volume *pvol;
+    struct fsw_posix_dir *dir;
+    struct fsw_posix_file *file;
+    struct dirent *dent;
+    char        path[4096];
+    int         listed = 0, failed = 0;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: lookupall_%s <image> <directory/>\n", STRINGIFY(FSTYPE));
+        return 1;
+    }
+
+    pvol = fsw_posix_mount(argv[1], &FSW_FSTYPE_TABLE_NAME(FSTYPE));
+    if (pvol == NULL) {
+        fprintf(stderr, "Mounting failed.\n");
+        return 1;
+    }
+    dir = fsw_posix_opendir(pvol, argv[2]);
+    if (dir == NULL) {
+        fprintf(stderr, "opendir call failed.\n");
+        return 1;
+    }
+    while ((dent = fsw_posix_readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0)
+            continue;
+        listed++;
+        snprintf(path, sizeof (path), "%s%s", argv[2], dent->d_name);
+
+        file = fsw_posix_open(pvol, path, 0, 0);
+        if (file == NULL) {
+            fprintf(stderr, "lookup failed: %s\n", path);
+            failed++;
+            continue;
+        }
+        fsw_posix_close(file);
+    }
+    fsw_posix_closedir(dir);
+    fsw_posix_unmount(pvol);
+
+    printf("lookupall: %d entries listed, %d lookups failed\n", listed, failed);
+    return failed ? 1 : 0;
+}
+
+// EOF
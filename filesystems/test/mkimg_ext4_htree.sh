@@ -0,0 +1,53 @@
+#!/bin/sh
+#
+# Builds an ext4 test image for the htree lookup in fsw_ext4_dx_lookup.
+#
+# /big gets 4000 files, which on 1KiB blocks gives a two level htree with two
+# interior index nodes. The first hash of the second interior node is then
+# marked as a hash collision continuation. The name with that hash is routed
+# to the last leaf of the first interior node and can only be found by
+# stepping from there to the next leaf through the root, as the kernel's
+# ext4_htree_next_block does. "make htree-test" checks that every file in
+# /big can be looked up.
+#
+# Needs mkfs.ext4, e2fsck and debugfs from e2fsprogs; assumes a little
+# endian host.
+#
+
+set -e
+
+IMG=${1:-ext4_htree.img}
+SRC=$(mktemp -d)
+trap 'rm -rf "$SRC"' EXIT
+
+mkdir "$SRC/big"
+i=1
+while [ $i -le 4000 ]; do
+    : > "$SRC/big/$(printf 'file_%05d_abcdefghijklmnopqrstuvwxyz' $i)"
+    i=$((i + 1))
+done
+
+rm -f "$IMG"
+mkfs.ext4 -q -F -b 1024 -N 8192 -O ^metadata_csum,^has_journal -d "$SRC" "$IMG" 16M
+debugfs -w -R "ssv hash_seed 6d3f8a40-3b5c-4c3e-9b7a-2f1e0d4c5b6a" "$IMG" 2>/dev/null
+debugfs -w -R "ssv def_hash_version half_md4" "$IMG" 2>/dev/null
+
+# e2fsck exits with 1 after optimising the directories into htrees
+e2fsck -fyD "$IMG" >/dev/null 2>&1 || [ $? -eq 1 ]
+
+# Root index block: dx_root_info at 24, count at 34, entry #1 hash at 40
+ROOT=$(debugfs -R "bmap /big 0" "$IMG" 2>/dev/null)
+LEVELS=$(od -An -tu1 -j $((ROOT * 1024 + 30)) -N1 "$IMG" | tr -d ' ')
+COUNT=$(od -An -tu2 -j $((ROOT * 1024 + 34)) -N2 "$IMG" | tr -d ' ')
+if [ "$LEVELS" != 1 ] || [ "$COUNT" -lt 2 ]; then
+    echo "mkimg_ext4_htree: /big is not a two level htree" >&2
+    exit 1
+fi
+
+HASH=$(od -An -tu4 -j $((ROOT * 1024 + 40)) -N4 "$IMG" | tr -d ' ')
+HASH=$((HASH | 1))
+printf "$(printf '\\%03o\\%03o\\%03o\\%03o' \
+    $((HASH & 255)) $(((HASH >> 8) & 255)) $(((HASH >> 16) & 255)) $(((HASH >> 24) & 255)))" |
+    dd of="$IMG" bs=1 seek=$((ROOT * 1024 + 40)) conv=notrunc 2>/dev/null
+
+echo "mkimg_ext4_htree: wrote $IMG"
@@ -76,16 +76,6 @@
 
 #define MAX_FILE_SIZE (1024*1024*1024)
 
-// Multiplier for pseudo-floating-point operations in egScaleImage().
-// A value of 4096 should keep us within limits on 32-bit systems, but I've
-// seen some minor artifacts at this level, so give it a bit more precision
-// on 64-bit systems.
-#if defined(EFIX64) | defined(EFIAARCH64)
-#   define FP_MULTIPLIER (UINTN) 65536
-#else
-#   define FP_MULTIPLIER (UINTN) 4096
-#endif
-
 #ifndef __MAKEWITH_GNUEFI
 #   define LibLocateHandle gBS->LocateHandleBuffer
 #   define LibOpenRoot EfiLibOpenRoot
@@ -190,104 +180,6 @@ EG_IMAGE * egCropImage (
     return NewImage;
 } // EG_IMAGE * egCropImage()
 
-// The following function implements a bilinear image scaling algorithm, based on
-// code presented at http://tech-algorithm.com/articles/bilinear-image-scaling/.
-// Resize an image; returns pointer to resized image if successful, NULL otherwise.
-// Calling function is responsible for freeing allocated memory.
-// NOTE: x_ratio, y_ratio, x_diff, and y_diff should really be float values;
-// however, I've found that my 32-bit Mac Mini has a buggy EFI (or buggy CPU?), which
-// causes this function to hang on float-to-UINT8 conversions on some (but not all!)
-// float values. Therefore, this function uses integer arithmetic but multiplies
-// all values by FP_MULTIPLIER to achieve something resembling the sort of precision
-// needed for good results.
-EG_IMAGE * egScaleImage (
-    IN EG_IMAGE  *Image,
-    IN UINTN      NewWidth,
-    IN UINTN      NewHeight
-) {
-    EG_IMAGE  *NewImage;
-    EG_PIXEL   a, b, c, d;
-    UINTN      i, j;
-    UINTN      x, y, Index;
-    UINTN      Offset = 0;
-    UINTN      x_diff, y_diff;
-    UINTN      x_ratio, y_ratio;
-
-
-    if (Image          == NULL ||
-        Image->Height  ==    0 ||
-        Image->Width   ==    0 ||
-        NewHeight      ==    0 ||
-        NewWidth       ==    0
-    ) {
-        return NULL;
-    }
-
-    if ((Image->Width == NewWidth) && (Image->Height == NewHeight)) {
-        return (egCopyImage (Image));
-    }
-
-    #if REFIT_DEBUG > 0
-    ALT_LOG(1, LOG_THREE_STAR_MID, L"Scaling Image to %d x %d", NewWidth, NewHeight);
-    #endif
-
-    NewImage = egCreateImage (NewWidth, NewHeight, Image->HasAlpha);
-    if (NewImage == NULL) {
-        #if REFIT_DEBUG > 0
-        ALT_LOG(1, LOG_THREE_STAR_END, L"In egScaleImage ... Could Not Create New Image!!");
-        #endif
-
-        return NULL;
-    }
-
-    x_ratio = ((Image->Width - 1) * FP_MULTIPLIER) / NewWidth;
-    y_ratio = ((Image->Height - 1) * FP_MULTIPLIER) / NewHeight;
-
-    for (i = 0; i < NewHeight; i++) {
-        for (j = 0; j < NewWidth; j++) {
-            x = (j * (Image->Width - 1)) / NewWidth;
-            y = (i * (Image->Height - 1)) / NewHeight;
-            x_diff = (x_ratio * j) - x * FP_MULTIPLIER;
-            y_diff = (y_ratio * i) - y * FP_MULTIPLIER;
-            Index = ((y * Image->Width) + x);
-            a = Image->PixelData[Index];
-            b = Image->PixelData[Index + 1];
-            c = Image->PixelData[Index + Image->Width];
-            d = Image->PixelData[Index + Image->Width + 1];
-
-            // blue element
-            NewImage->PixelData[Offset].b = ((a.b) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
-                (b.b) * (x_diff) * (FP_MULTIPLIER - y_diff) +
-                (c.b) * (y_diff) * (FP_MULTIPLIER - x_diff) +
-                (d.b) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
-
-            // green element
-            NewImage->PixelData[Offset].g = ((a.g) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
-                (b.g) * (x_diff) * (FP_MULTIPLIER - y_diff) +
-                (c.g) * (y_diff) * (FP_MULTIPLIER - x_diff) +
-                (d.g) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
-
-            // red element
-            NewImage->PixelData[Offset].r = ((a.r) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
-                (b.r) * (x_diff) * (FP_MULTIPLIER - y_diff) +
-                (c.r) * (y_diff) * (FP_MULTIPLIER - x_diff) +
-                (d.r) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
-
-            // alpha element
-            NewImage->PixelData[Offset++].a = ((a.a) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
-                (b.a) * (x_diff) * (FP_MULTIPLIER - y_diff) +
-                (c.a) * (y_diff) * (FP_MULTIPLIER - x_diff) +
-                (d.a) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
-        } // for (j...)
-    } // for (i...)
-
-    #if REFIT_DEBUG > 0
-    ALT_LOG(1, LOG_THREE_STAR_MID, L"Scaling Image Completed");
-    #endif
-
-    return NewImage;
-} // EG_IMAGE * egScaleImage()
-
 /*
 VOID egFreeImage (
     IN EG_IMAGE *Image
@@ -460,8 +352,9 @@ EFI_STATUS egSaveFile (
 // Loading images from files and embedded data
 //
 
-// Decode the specified image data. The IconSize parameter is relevant only
-// for ICNS, for which it selects which ICNS sub-image is decoded.
+// Decode the specified image data. The IconSize parameter selects which ICNS
+// sub-image is decoded and lets JPEG images be decoded at a reduced size that
+// still covers IconSize. Zero requests the image at its full size.
 // Returns a pointer to the resulting EG_IMAGE or NULL if decoding failed.
 static
 EG_IMAGE * egDecodeAny (
@@ -511,9 +404,8 @@ EG_IMAGE * egLoadImage (
         return NULL;
     }
 
-    // Decode it
-    // '128' can be any arbitrary value
-    NewImage = egDecodeAny (FileData, FileDataLength, 128, WantAlpha);
+    // Decode it at full size
+    NewImage = egDecodeAny (FileData, FileDataLength, 0, WantAlpha);
     MY_FREE_POOL(FileData);
 
     return NewImage;
@@ -687,6 +579,237 @@ EG_IMAGE * egLoadIconAnyType (
     return Image;
 } // EG_IMAGE *egLoadIconAnyType()
 
+//
+// Icon directory index
+//
+
+// The icons directories are listed once and probed in memory, so that trying
+// every name in ICON_EXTENSIONS for every boot entry does not cost a failed
+// file open each time. Icons decoded from a directory are kept there by base
+// name and size, and handed out as copies.
+typedef struct EG_ICON_NAME {
+    UINT32                 Hash;
+    CHAR16                *FileName;
+    struct EG_ICON_NAME   *Next;
+} EG_ICON_NAME;
+
+typedef struct EG_ICON_ENTRY {
+    CHAR16                *BaseName;
+    UINTN                  IconSize;
+    EG_IMAGE              *Image;      // NULL if the file could not be decoded
+    struct EG_ICON_ENTRY  *Next;
+} EG_ICON_ENTRY;
+
+typedef struct EG_ICON_DIR {
+    EFI_FILE              *BaseDir;
+    CHAR16                *SubdirName;
+    BOOLEAN                Listed;     // FALSE if the listing failed part way
+    EG_ICON_NAME          *Names;
+    EG_ICON_ENTRY         *Icons;
+    struct EG_ICON_DIR    *Next;
+} EG_ICON_DIR;
+
+static EG_ICON_DIR *IconDirs = NULL;
+
+// FNV-1a over the characters as MyStriCmp() compares them, so names that
+// MyStriCmp() treats as equal always hash alike.
+static
+UINT32 egIconNameHash (
+    IN UINT32  Hash,
+    IN CHAR16 *Name
+) {
+    while (*Name != L'\0') {
+        Hash = (Hash ^ (UINT32) (*Name++ & ~0x20)) * 16777619;
+    }
+
+    return Hash;
+} // static UINT32 egIconNameHash()
+
+// Returns the index for SubdirName in BaseDir, listing the directory on first use.
+static
+EG_ICON_DIR * egGetIconDir (
+    IN EFI_FILE *BaseDir,
+    IN CHAR16   *SubdirName
+) {
+    EFI_STATUS       Status;
+    EG_ICON_DIR     *IconDir;
+    EG_ICON_NAME    *IconName;
+    EFI_FILE_INFO   *DirEntry;
+    REFIT_DIR_ITER   DirIter;
+
+    for (IconDir = IconDirs; IconDir != NULL; IconDir = IconDir->Next) {
+        if (IconDir->BaseDir == BaseDir && MyStriCmp (IconDir->SubdirName, SubdirName)) {
+            // Early Return
+            return IconDir;
+        }
+    }
+
+    IconDir = AllocateZeroPool (sizeof (EG_ICON_DIR));
+    if (IconDir == NULL) {
+        // Early Return
+        return NULL;
+    }
+    IconDir->BaseDir    = BaseDir;
+    IconDir->SubdirName = StrDuplicate (SubdirName);
+
+    DirIterOpen (BaseDir, SubdirName, &DirIter);
+    while (DirIterNext (&DirIter, 2, NULL, &DirEntry)) {
+        IconName = AllocatePool (sizeof (EG_ICON_NAME));
+        if (IconName != NULL) {
+            IconName->FileName = StrDuplicate (DirEntry->FileName);
+            IconName->Hash     = egIconNameHash (2166136261U, DirEntry->FileName);
+            IconName->Next     = IconDir->Names;
+            IconDir->Names     = IconName;
+        }
+        MY_FREE_POOL(DirEntry);
+    } // while
+    Status = DirIterClose (&DirIter);
+
+    // A missing directory is a complete (empty) listing
+    IconDir->Listed = (Status == EFI_SUCCESS || Status == EFI_NOT_FOUND);
+    IconDir->Next   = IconDirs;
+    IconDirs        = IconDir;
+
+    #if REFIT_DEBUG > 0
+    ALT_LOG(1, LOG_THREE_STAR_MID,
+        L"Indexed Icon Directory '%s' ... %r",
+        (StrLen (SubdirName) != 0) ? SubdirName : L"\\",
+        Status
+    );
+    #endif
+
+    return IconDir;
+} // static EG_ICON_DIR * egGetIconDir()
+
+// Returns TRUE if the index holds a file named BaseName.Extension.
+static
+BOOLEAN egIconDirHasFile (
+    IN EG_ICON_DIR *IconDir,
+    IN CHAR16      *BaseName,
+    IN CHAR16      *Extension
+) {
+    UINT32         Hash;
+    CHAR16        *FileName;
+    BOOLEAN        Found;
+    EG_ICON_NAME  *IconName;
+
+    Hash = egIconNameHash (2166136261U, BaseName);
+    Hash = egIconNameHash (Hash, L".");
+    Hash = egIconNameHash (Hash, Extension);
+
+    for (IconName = IconDir->Names; IconName != NULL; IconName = IconName->Next) {
+        if (IconName->Hash != Hash) {
+            continue;
+        }
+
+        FileName = PoolPrint (L"%s.%s", BaseName, Extension);
+        Found    = MyStriCmp (IconName->FileName, FileName);
+        MY_FREE_POOL(FileName);
+
+        if (Found) {
+            // Early Return
+            return TRUE;
+        }
+    } // for
+
+    return FALSE;
+} // static BOOLEAN egIconDirHasFile()
+
+// As egLoadIconAnyType(), but only opens files the directory index lists and
+// decodes each (BaseName, IconSize) once. Returns a copy the caller owns.
+static
+EG_IMAGE * egLoadIconIndexed (
+    IN EFI_FILE  *BaseDir,
+    IN CHAR16    *SubdirName,
+    IN CHAR16    *BaseName,
+    IN UINTN      IconSize
+) {
+    EG_IMAGE       *Image = NULL;
+    CHAR16         *Extension;
+    CHAR16         *FileName;
+    UINTN           i = 0;
+    BOOLEAN         Tried = FALSE;
+    EG_ICON_DIR    *IconDir;
+    EG_ICON_ENTRY  *IconEntry;
+
+    // Names with a path in them are not in the index
+    IconDir = (BaseDir != NULL && MyStrStr (BaseName, L"\\") == NULL)
+        ? egGetIconDir (BaseDir, SubdirName)
+        : NULL;
+    if (IconDir == NULL || !IconDir->Listed) {
+        // Early Return ... Probe by opening files
+        return egLoadIconAnyType (BaseDir, SubdirName, BaseName, IconSize);
+    }
+
+    for (IconEntry = IconDir->Icons; IconEntry != NULL; IconEntry = IconEntry->Next) {
+        if (IconEntry->IconSize == IconSize && MyStriCmp (IconEntry->BaseName, BaseName)) {
+            #if REFIT_DEBUG > 0
+            ALT_LOG(1, LOG_THREE_STAR_MID, L"Using Cached Icon:- '%s'", BaseName);
+            #endif
+
+            // Early Return
+            return (IconEntry->Image) ? egCopyImage (IconEntry->Image) : NULL;
+        }
+    }
+
+    while ((Image == NULL) && ((Extension = FindCommaDelimited (ICON_EXTENSIONS, i++)) != NULL)) {
+        if (egIconDirHasFile (IconDir, BaseName, Extension)) {
+            Tried    = TRUE;
+            FileName = PoolPrint (L"%s\\%s.%s", SubdirName, BaseName, Extension);
+            Image    = egLoadIcon (BaseDir, FileName, IconSize);
+            MY_FREE_POOL(FileName);
+        }
+
+        MY_FREE_POOL(Extension);
+    } // while
+
+    if (!Tried) {
+        // Early Return ... Nothing to decode and nothing worth caching
+        return NULL;
+    }
+
+    IconEntry = AllocatePool (sizeof (EG_ICON_ENTRY));
+    if (IconEntry == NULL) {
+        // Early Return
+        return Image;
+    }
+    IconEntry->BaseName = StrDuplicate (BaseName);
+    IconEntry->IconSize = IconSize;
+    IconEntry->Image    = Image;
+    IconEntry->Next     = IconDir->Icons;
+    IconDir->Icons      = IconEntry;
+
+    return (Image) ? egCopyImage (Image) : NULL;
+} // static EG_IMAGE * egLoadIconIndexed()
+
+// Drops the icon directory index and the icons decoded through it.
+// Needed whenever the directory handles it was built from are closed.
+VOID egFreeIconCache (VOID) {
+    EG_ICON_DIR    *IconDir;
+    EG_ICON_NAME   *IconName;
+    EG_ICON_ENTRY  *IconEntry;
+
+    while ((IconDir = IconDirs) != NULL) {
+        IconDirs = IconDir->Next;
+
+        while ((IconName = IconDir->Names) != NULL) {
+            IconDir->Names = IconName->Next;
+            MY_FREE_POOL(IconName->FileName);
+            MY_FREE_POOL(IconName);
+        }
+
+        while ((IconEntry = IconDir->Icons) != NULL) {
+            IconDir->Icons = IconEntry->Next;
+            MY_FREE_POOL(IconEntry->BaseName);
+            MY_FREE_IMAGE(IconEntry->Image);
+            MY_FREE_POOL(IconEntry);
+        }
+
+        MY_FREE_POOL(IconDir->SubdirName);
+        MY_FREE_POOL(IconDir);
+    } // while
+} // VOID egFreeIconCache()
+
 // Returns an icon with any extension in ICON_EXTENSIONS from either the directory
 // specified by GlobalConfig.IconsDir or DEFAULT_ICONS_DIR. The input BaseName
 // should be the icon name without an extension. For instance, if BaseName is
@@ -694,22 +817,28 @@ EG_IMAGE * egLoadIconAnyType (
 // ICON_EXTENSIONS is "icns,png", this function will return myicons/os_linux.icns,
 // myicons/os_linux.png, icons/os_linux.icns, or icons/os_linux.png, in that
 // order of preference. Returns NULL if no such icon can be found. All file
-// references are relative to SelfDir.
+// references are relative to SelfDir. Both directories are looked up through
+// the icon directory index, and the returned image is a copy the caller owns.
 EG_IMAGE * egFindIcon (
     IN CHAR16 *BaseName,
     IN UINTN   IconSize
 ) {
     EG_IMAGE *Image = NULL;
 
+    if (!AllowGraphicsMode || BaseName == NULL) {
+        // Early Return
+        return NULL;
+    }
+
     if (GlobalConfig.IconsDir != NULL) {
-        Image = egLoadIconAnyType (
+        Image = egLoadIconIndexed (
             SelfDir, GlobalConfig.IconsDir,
             BaseName, IconSize
         );
     }
 
     if (Image == NULL) {
-        Image = egLoadIconAnyType (
+        Image = egLoadIconIndexed (
             SelfDir, DEFAULT_ICONS_DIR,
             BaseName, IconSize
         );
@@ -1024,72 +1153,6 @@ VOID egFillImageArea (
     }
 } // VOID egFillImageArea ()
 
-VOID egRawCopy (
-    IN OUT EG_PIXEL *CompBasePtr,
-    IN EG_PIXEL     *TopBasePtr,
-    IN UINTN         Width,
-    IN UINTN         Height,
-    IN UINTN         CompLineOffset,
-    IN UINTN         TopLineOffset
-) {
-    UINTN       x, y;
-    EG_PIXEL   *TopPtr, *CompPtr;
-
-    if (CompBasePtr && TopBasePtr) {
-        for (y = 0; y < Height; y++) {
-            TopPtr  = TopBasePtr;
-            CompPtr = CompBasePtr;
-
-            for (x = 0; x < Width; x++) {
-                *CompPtr = *TopPtr;
-                TopPtr++, CompPtr++;
-            }
-
-            TopBasePtr  += TopLineOffset;
-            CompBasePtr += CompLineOffset;
-        }
-    }
-} // VOID egRawCopy()
-
-VOID egRawCompose (
-    IN OUT EG_PIXEL *CompBasePtr,
-    IN EG_PIXEL     *TopBasePtr,
-    IN UINTN         Width,
-    IN UINTN         Height,
-    IN UINTN         CompLineOffset,
-    IN UINTN         TopLineOffset
-) {
-    UINTN        x, y;
-    EG_PIXEL    *TopPtr, *CompPtr;
-    UINTN        Alpha;
-    UINTN        RevAlpha;
-    UINTN        Temp;
-
-    if (CompBasePtr && TopBasePtr) {
-        for (y = 0; y < Height; y++) {
-            TopPtr  = TopBasePtr;
-            CompPtr = CompBasePtr;
-
-            for (x = 0; x < Width; x++) {
-                Alpha    = TopPtr->a;
-                RevAlpha = 255 - Alpha;
-
-                Temp       = (UINTN) CompPtr->b * RevAlpha + (UINTN) TopPtr->b * Alpha + 0x80;
-                CompPtr->b = (Temp + (Temp >> 8)) >> 8;
-                Temp       = (UINTN) CompPtr->g * RevAlpha + (UINTN) TopPtr->g * Alpha + 0x80;
-                CompPtr->g = (Temp + (Temp >> 8)) >> 8;
-                Temp       = (UINTN) CompPtr->r * RevAlpha + (UINTN) TopPtr->r * Alpha + 0x80;
-                CompPtr->r = (Temp + (Temp >> 8)) >> 8;
-
-                TopPtr++, CompPtr++;
-            }
-
-            TopBasePtr  += TopLineOffset;
-            CompBasePtr += CompLineOffset;
-        }
-    }
-} // VOID egRawCompose()
-
 VOID egComposeImage (
     IN OUT EG_IMAGE *CompImage,
     IN EG_IMAGE     *TopImage,
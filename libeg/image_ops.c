@@ -0,0 +1,799 @@
+/*
+ * libeg/image_ops.c
+ * Image scaling and compositing functions
+ *
+ * Copyright (c) 2006 Christoph Pfisterer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *  * Neither the name of Christoph Pfisterer nor the names of the
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Modifications copyright (c) 2012-2020 Roderick W. Smith
+ *
+ * Modifications distributed under the terms of the GNU General Public
+ * License (GPL) version 3 (GPLv3), or (at your option) any later version.
+ *
+ */
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+ * Modified for RefindPlus
+ * Copyright (c) 2021-2022 Dayo Akanji (sf.net/u/dakanji/profile)
+ * Portions Copyright (c) 2021 Joe van Tunen (joevt@shaw.ca)
+ *
+ * Modifications distributed under the preceding terms.
+ */
+
+// The pixel loops are kept apart from the rest of libeg/image.c so that they
+// can be built and checked on the host. See libeg/test.
+#ifdef HOST_POSIX
+#include "test/eg_posix_base.h"
+#else
+#include "libegint.h"
+#include "../BootMaster/global.h"
+#include "../BootMaster/lib.h"
+#include "libeg.h"
+#endif
+
+// Fixed-point precision of the filter weights in egScaleImage(). Weights for one
+// output pixel add up to exactly 1 << EG_SCALE_BITS. The horizontal pass keeps
+// eight extra bits per channel, so the vertical sums stay below 2^32.
+#define EG_SCALE_BITS   (14)
+#define EG_SCALE_ONE    (1 << EG_SCALE_BITS)
+
+// Source pixels averaged per axis by the box filter. Longer spans are sampled
+// at this many evenly spaced pixels, so a reduction reads no more than
+// EG_SCALE_BOX_TAPS squared source pixels per output pixel, whatever the ratio.
+// Sums of that many pixels must fit the 16-bit halves used by egScaleSumRows(),
+// so this can be no more than 16.
+#define EG_SCALE_BOX_TAPS   (3)
+
+// egRawCompose() blends four pixels at a time with GCC/Clang vector extensions
+// where the target has 128-bit integer vectors in its baseline: SSE2 on x64 and
+// Advanced SIMD on AArch64 (unless built with -mgeneral-regs-only, which drops
+// __ARM_NEON). Other builds use the scalar loop alone.
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#   define EG_VECTOR_COMPOSE 1
+typedef UINT32 EG_V4U32 __attribute__((vector_size (16), aligned (4), may_alias));
+typedef UINT16 EG_V8U16 __attribute__((vector_size (16), may_alias));
+#endif
+
+// Whole pixels are read as words in egScaleSumRows()
+#ifdef __GNUC__
+typedef UINT32 EG_PIXEL32 __attribute__((may_alias));
+#else
+typedef UINT32 EG_PIXEL32;
+#endif
+
+//
+// Scaling
+//
+
+// Source taps for one output column or row of egScaleImage(): Count source
+// pixels, Step apart from Start on, with weights taken from the weight table
+// at Weights.
+typedef struct {
+    UINTN Start;
+    UINTN Count;
+    UINTN Step;
+    UINTN Weights;
+} EG_SCALE_TAPS;
+
+// Reductions to half size or less on an axis use a box filter
+#define EG_SCALE_BOX(OldSize, NewSize)  ((NewSize) * 2 <= (OldSize))
+
+// Build the taps for scaling one axis from OldSize to NewSize pixels.
+// Reductions to half size or less average the source pixels in the span
+// (box filter), or EG_SCALE_BOX_TAPS of them spread over longer spans, so that
+// large reductions do not alias. Anything else samples bilinearly, at the same
+// source positions the old per-pixel code used.
+// Returns NULL on allocation failure; the caller frees both tables.
+static
+EG_SCALE_TAPS * egScaleTaps (
+    IN  UINTN    OldSize,
+    IN  UINTN    NewSize,
+    OUT UINT32 **WeightsOut
+) {
+    UINTN          i, k;
+    UINTN          End, Frac, Share, Spare;
+    UINTN          Next = 0;
+    UINT32        *Weights;
+    EG_SCALE_TAPS *Taps;
+
+    Taps    = AllocatePool (NewSize * sizeof (EG_SCALE_TAPS));
+    Weights = AllocatePool (NewSize * EG_SCALE_BOX_TAPS * sizeof (UINT32));
+    if (Taps == NULL || Weights == NULL) {
+        MY_FREE_POOL(Taps);
+        MY_FREE_POOL(Weights);
+
+        return NULL;
+    }
+
+    for (i = 0; i < NewSize; i++) {
+        Taps[i].Weights = Next;
+        Taps[i].Step    = 1;
+
+        if (EG_SCALE_BOX (OldSize, NewSize)) {
+            Taps[i].Start = (i * OldSize) / NewSize;
+            End           = ((i + 1) * OldSize) / NewSize;
+            Taps[i].Count = End - Taps[i].Start;
+
+            if (Taps[i].Count > EG_SCALE_BOX_TAPS) {
+                // Spread the taps evenly, with the same margin at both ends
+                Taps[i].Step   = Taps[i].Count / EG_SCALE_BOX_TAPS;
+                Taps[i].Start += (Taps[i].Count - Taps[i].Step * (EG_SCALE_BOX_TAPS - 1)) / 2;
+                Taps[i].Count  = EG_SCALE_BOX_TAPS;
+            }
+
+            // Equal shares, with the rounding remainder spread over the first taps
+            Share = EG_SCALE_ONE / Taps[i].Count;
+            Spare = EG_SCALE_ONE - Share * Taps[i].Count;
+            for (k = 0; k < Taps[i].Count; k++) {
+                Weights[Next++] = (UINT32) (Share + ((k < Spare) ? 1 : 0));
+            }
+        }
+        else {
+            Taps[i].Start = (i * (OldSize - 1)) / NewSize;
+            Frac          = (((i * (OldSize - 1)) % NewSize) << EG_SCALE_BITS) / NewSize;
+
+            Weights[Next++] = (UINT32) (EG_SCALE_ONE - Frac);
+            Taps[i].Count   = 1;
+            if (Frac != 0 && Taps[i].Start + 1 < OldSize) {
+                Weights[Next++] = (UINT32) Frac;
+                Taps[i].Count   = 2;
+            }
+            else {
+                Weights[Next - 1] = EG_SCALE_ONE;
+            }
+        }
+    } // for
+
+    *WeightsOut = Weights;
+
+    return Taps;
+} // static EG_SCALE_TAPS * egScaleTaps()
+
+// Horizontal pass of egScaleImage(): filter one source row into NewWidth
+// pixels of four channels each, keeping eight extra bits of precision.
+static
+VOID egScaleRow (
+    IN  EG_PIXEL      *SrcRow,
+    IN  EG_SCALE_TAPS *Taps,
+    IN  UINT32        *Weights,
+    IN  UINTN          NewWidth,
+    OUT UINT32        *OutRow
+) {
+    UINTN     j, k;
+    UINT32    w;
+    EG_PIXEL *p;
+    #ifdef EG_VECTOR_COMPOSE
+    EG_V4U32  Sum;
+    #else
+    UINT32    Sum[4];
+    #endif
+
+    for (j = 0; j < NewWidth; j++, OutRow += 4) {
+        p = SrcRow + Taps[j].Start;
+
+        // Start from half an output step, to round rather than truncate
+        #ifdef EG_VECTOR_COMPOSE
+        Sum = (EG_V4U32) { 32, 32, 32, 32 };
+
+        for (k = 0; k < Taps[j].Count; k++, p += Taps[j].Step) {
+            w    = Weights[Taps[j].Weights + k];
+            Sum += w * (EG_V4U32) { p->b, p->g, p->r, p->a };
+        }
+        *(EG_V4U32 *) OutRow = Sum >> (EG_SCALE_BITS - 8);
+        #else
+        Sum[0] = Sum[1] = Sum[2] = Sum[3] = 32;
+
+        for (k = 0; k < Taps[j].Count; k++, p += Taps[j].Step) {
+            w       = Weights[Taps[j].Weights + k];
+            Sum[0] += w * p->b;
+            Sum[1] += w * p->g;
+            Sum[2] += w * p->r;
+            Sum[3] += w * p->a;
+        }
+        for (k = 0; k < 4; k++) {
+            OutRow[k] = Sum[k] >> (EG_SCALE_BITS - 8);
+        }
+        #endif
+    }
+} // static VOID egScaleRow()
+
+// Source columns of the horizontal taps for egScaleSumRows(), one per weight
+// in the weight table. Returns NULL on allocation failure.
+static
+UINT32 * egScaleColumns (
+    IN  EG_SCALE_TAPS *Taps,
+    IN  UINTN          NewWidth,
+    OUT UINTN         *Slots
+) {
+    UINTN   j, k;
+    UINT32 *Cols;
+
+    *Slots = Taps[NewWidth - 1].Weights + Taps[NewWidth - 1].Count;
+
+    Cols = AllocatePool (*Slots * sizeof (UINT32));
+    if (Cols == NULL) {
+        return NULL;
+    }
+
+    for (j = 0; j < NewWidth; j++) {
+        for (k = 0; k < Taps[j].Count; k++) {
+            Cols[Taps[j].Weights + k] = (UINT32) (Taps[j].Start + k * Taps[j].Step);
+        }
+    }
+
+    return Cols;
+} // static UINT32 * egScaleColumns()
+
+// Vertical pass of egScaleImage() for box reductions in height: add up the
+// Count source rows of one output row, Step rows apart from SrcRows on, two
+// channels to a word: blue and red in Lo, green and alpha in Hi. Each source
+// pixel costs two masked additions. Only the Slots columns listed in Cols are
+// read, in that order, or the whole row of Width pixels if Cols is NULL.
+static
+VOID egScaleSumRows (
+    IN  EG_PIXEL *SrcRows,
+    IN  UINTN     Width,
+    IN  UINTN     Count,
+    IN  UINTN     Step,
+    IN  UINT32   *Cols,
+    IN  UINTN     Slots,
+    OUT UINT32   *Lo,
+    OUT UINT32   *Hi
+) {
+    UINTN       x, k;
+    UINT32      SumLo, SumHi, Pixel, Pixel2, Pixel3;
+    EG_PIXEL32 *Src = (EG_PIXEL32 *) SrcRows;
+
+    // Each column is summed over the rows at once, so the sums are only
+    // stored once
+    Step *= Width;
+
+    if (Cols != NULL && Count == 3) {
+        // Unrolled for three rows, which every sampled span has with the
+        // default EG_SCALE_BOX_TAPS, as large reductions spend their time here
+        for (x = 0; x < Slots; x++) {
+            Pixel  = Src[Cols[x]];
+            Pixel2 = Src[Step + Cols[x]];
+            Pixel3 = Src[2 * Step + Cols[x]];
+            Lo[x]  = (Pixel & 0x00FF00FF) + (Pixel2 & 0x00FF00FF) + (Pixel3 & 0x00FF00FF);
+            Hi[x]  = ((Pixel >> 8) & 0x00FF00FF) + ((Pixel2 >> 8) & 0x00FF00FF) + ((Pixel3 >> 8) & 0x00FF00FF);
+        }
+
+        return;
+    }
+
+    if (Cols != NULL) {
+        for (x = 0; x < Slots; x++) {
+            SumLo = SumHi = 0;
+            for (k = 0; k < Count; k++) {
+                Pixel  = Src[k * Step + Cols[x]];
+                SumLo += Pixel & 0x00FF00FF;
+                SumHi += (Pixel >> 8) & 0x00FF00FF;
+            }
+            Lo[x] = SumLo;
+            Hi[x] = SumHi;
+        }
+
+        return;
+    }
+
+    x = 0;
+
+    #ifdef EG_VECTOR_COMPOSE
+    for (; x + 4 <= Width; x += 4) {
+        EG_V4U32 Four;
+        EG_V4U32 FourLo = { 0, 0, 0, 0 };
+        EG_V4U32 FourHi = { 0, 0, 0, 0 };
+
+        for (k = 0; k < Count; k++) {
+            Four    = *(EG_V4U32 *) (Src + k * Step + x);
+            FourLo += Four & 0x00FF00FF;
+            FourHi += (Four >> 8) & 0x00FF00FF;
+        }
+        *(EG_V4U32 *) (Lo + x) = FourLo;
+        *(EG_V4U32 *) (Hi + x) = FourHi;
+    }
+    #endif
+
+    for (; x < Width; x++) {
+        SumLo = SumHi = 0;
+        for (k = 0; k < Count; k++) {
+            Pixel  = Src[k * Step + x];
+            SumLo += Pixel & 0x00FF00FF;
+            SumHi += (Pixel >> 8) & 0x00FF00FF;
+        }
+        Lo[x] = SumLo;
+        Hi[x] = SumHi;
+    }
+} // static VOID egScaleSumRows()
+
+// Horizontal pass of egScaleImage() after egScaleSumRows(): filter one row of
+// sums of Rows source rows, one per tap, into NewWidth output pixels. Box taps
+// all weigh the same, so their sums are added up two channels to a word as
+// well, and divided once.
+static
+VOID egScaleSumsRow (
+    IN  UINT32        *Lo,
+    IN  UINT32        *Hi,
+    IN  UINTN          Rows,
+    IN  BOOLEAN        Box,
+    IN  EG_SCALE_TAPS *Taps,
+    IN  UINT32        *Weights,
+    IN  UINTN          NewWidth,
+    OUT EG_PIXEL      *OutRow
+) {
+    UINTN     j, k, x;
+    UINT32    w, SumLo, SumHi;
+    UINT32    Sum[4];
+    UINT32    Recip[EG_SCALE_BOX_TAPS + 1];
+
+    if (Box) {
+        // Sums of n pixels stay below 255 * n, so the products stay below 2^31
+        for (k = 1; k <= EG_SCALE_BOX_TAPS; k++) {
+            Recip[k] = (UINT32) (((1 << (EG_SCALE_BITS + 8)) + k * Rows / 2) / (k * Rows));
+        }
+
+        for (j = 0; j < NewWidth; j++, OutRow++) {
+            x     = Taps[j].Weights;
+            SumLo = SumHi = 0;
+            for (k = 0; k < Taps[j].Count; k++, x++) {
+                SumLo += Lo[x];
+                SumHi += Hi[x];
+            }
+
+            w = Recip[Taps[j].Count];
+            OutRow->b = (UINT8) (((SumLo & 0xFFFF) * w + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+            OutRow->g = (UINT8) (((SumHi & 0xFFFF) * w + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+            OutRow->r = (UINT8) (((SumLo >> 16)    * w + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+            OutRow->a = (UINT8) (((SumHi >> 16)    * w + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+        }
+
+        return;
+    }
+
+    // The filtered sums, cut to eight extra bits, stay below 255 * Rows << 8,
+    // so the products stay below 2^31
+    Recip[1] = (UINT32) ((EG_SCALE_ONE + Rows / 2) / Rows);
+
+    for (j = 0; j < NewWidth; j++, OutRow++) {
+        Sum[0] = Sum[1] = Sum[2] = Sum[3] = 32;
+
+        x = Taps[j].Weights;
+        for (k = 0; k < Taps[j].Count; k++, x++) {
+            w       = Weights[x];
+            Sum[0] += w * (Lo[x] & 0xFFFF);
+            Sum[1] += w * (Hi[x] & 0xFFFF);
+            Sum[2] += w * (Lo[x] >> 16);
+            Sum[3] += w * (Hi[x] >> 16);
+        }
+
+        for (k = 0; k < 4; k++) {
+            Sum[k] = ((Sum[k] >> (EG_SCALE_BITS - 8)) * Recip[1] + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8);
+        }
+        OutRow->b = (UINT8) Sum[0];
+        OutRow->g = (UINT8) Sum[1];
+        OutRow->r = (UINT8) Sum[2];
+        OutRow->a = (UINT8) Sum[3];
+    }
+} // static VOID egScaleSumsRow()
+
+// Vertical pass of egScaleImage() for bilinear reductions: blend two source
+// rows with weights w0 and w1 into Width pixels, kept to eight extra bits, two
+// channels to a word as egScaleSumRows() stores them. The blended channels
+// stay below 2^16, so the halves do not overflow.
+static
+VOID egScaleBlendRows (
+    IN  EG_PIXEL *Row0,
+    IN  EG_PIXEL *Row1,
+    IN  UINT32    w0,
+    IN  UINT32    w1,
+    IN  UINTN     Width,
+    OUT UINT32   *Lo,
+    OUT UINT32   *Hi
+) {
+    UINTN       x;
+    UINT32      P0, P1;
+    EG_PIXEL32 *Src0 = (EG_PIXEL32 *) Row0;
+    EG_PIXEL32 *Src1 = (EG_PIXEL32 *) Row1;
+
+    x = 0;
+
+    #ifdef EG_VECTOR_COMPOSE
+    for (; x + 4 <= Width; x += 4) {
+        EG_V4U32 Four0 = *(EG_V4U32 *) (Src0 + x);
+        EG_V4U32 Four1 = *(EG_V4U32 *) (Src1 + x);
+
+        *(EG_V4U32 *) (Lo + x) =
+            ((( Four0        & 0xFF) * w0 + ( Four1        & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8)) |
+            ((((Four0 >> 16) & 0xFF) * w0 + ((Four1 >> 16) & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8) << 16);
+        *(EG_V4U32 *) (Hi + x) =
+            ((((Four0 >>  8) & 0xFF) * w0 + ((Four1 >>  8) & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8)) |
+            (( (Four0 >> 24)         * w0 + ( Four1 >> 24)         * w1 + 32) >> (EG_SCALE_BITS - 8) << 16);
+    }
+    #endif
+
+    for (; x < Width; x++) {
+        P0 = Src0[x];
+        P1 = Src1[x];
+        Lo[x] = ((( P0        & 0xFF) * w0 + ( P1        & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8)) |
+                ((((P0 >> 16) & 0xFF) * w0 + ((P1 >> 16) & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8) << 16);
+        Hi[x] = ((((P0 >>  8) & 0xFF) * w0 + ((P1 >>  8) & 0xFF) * w1 + 32) >> (EG_SCALE_BITS - 8)) |
+                (( (P0 >> 24)         * w0 + ( P1 >> 24)         * w1 + 32) >> (EG_SCALE_BITS - 8) << 16);
+    }
+} // static VOID egScaleBlendRows()
+
+// Horizontal pass of egScaleImage() after egScaleBlendRows(): filter the row
+// of blended pixels with bilinear taps into NewWidth output pixels.
+static
+VOID egScaleBlendRow (
+    IN  UINT32        *Lo,
+    IN  UINT32        *Hi,
+    IN  EG_SCALE_TAPS *Taps,
+    IN  UINT32        *Weights,
+    IN  UINTN          NewWidth,
+    OUT EG_PIXEL      *OutRow
+) {
+    UINTN     j, x0, x1;
+    UINT32    w0, w1;
+
+    for (j = 0; j < NewWidth; j++, OutRow++) {
+        x0 = x1 = Taps[j].Start;
+        w0 = Weights[Taps[j].Weights];
+        w1 = 0;
+        if (Taps[j].Count > 1) {
+            x1 = x0 + 1;
+            w1 = Weights[Taps[j].Weights + 1];
+        }
+
+        OutRow->b = (UINT8) ((w0 * (Lo[x0] & 0xFFFF) + w1 * (Lo[x1] & 0xFFFF) + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+        OutRow->g = (UINT8) ((w0 * (Hi[x0] & 0xFFFF) + w1 * (Hi[x1] & 0xFFFF) + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+        OutRow->r = (UINT8) ((w0 * (Lo[x0] >> 16)    + w1 * (Lo[x1] >> 16)    + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+        OutRow->a = (UINT8) ((w0 * (Hi[x0] >> 16)    + w1 * (Hi[x1] >> 16)    + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+    }
+} // static VOID egScaleBlendRow()
+
+// Resize an image; returns pointer to resized image if successful, NULL otherwise.
+// Calling function is responsible for freeing allocated memory.
+// The image is filtered in two passes with per-column and per-row weight tables.
+// Reductions to half size or less use a box filter on that axis; everything else
+// is bilinear. When the height is box filtered, the source rows of each output
+// row are added up first, and only those sums are filtered horizontally. Other
+// reductions of the height blend the two source rows of each output row first,
+// unless the width is box filtered. Otherwise each needed source row is filtered
+// horizontally once, and output rows are weighted sums of those filtered rows.
+// Either way, only the source rows the taps name are read.
+// NOTE: This function deliberately uses only integer arithmetic. My 32-bit Mac Mini
+// has a buggy EFI (or buggy CPU?), which causes hangs on float-to-UINT8 conversions
+// on some (but not all!) float values.
+EG_IMAGE * egScaleImage (
+    IN EG_IMAGE  *Image,
+    IN UINTN      NewWidth,
+    IN UINTN      NewHeight
+) {
+    EG_IMAGE      *NewImage = NULL;
+    EG_PIXEL      *OutPtr;
+    EG_SCALE_TAPS *XTaps    = NULL;
+    EG_SCALE_TAPS *YTaps    = NULL;
+    UINT32        *XWeights = NULL;
+    UINT32        *YWeights = NULL;
+    UINT32        *Rows[2]  = { NULL, NULL };
+    UINT32        *Acc      = NULL;
+    UINT32        *Cols     = NULL;
+    UINT32        *Row;
+    UINT32         w;
+    UINTN          RowTag[2];
+    UINTN          NextRow  = 0;
+    UINTN          i, j, k, SrcY;
+    UINTN          Slots    = 0;
+    BOOLEAN        BoxX, BoxY, BlendY;
+
+
+    if (Image          == NULL ||
+        Image->Height  ==    0 ||
+        Image->Width   ==    0 ||
+        NewHeight      ==    0 ||
+        NewWidth       ==    0
+    ) {
+        return NULL;
+    }
+
+    if ((Image->Width == NewWidth) && (Image->Height == NewHeight)) {
+        return (egCopyImage (Image));
+    }
+
+    #if REFIT_DEBUG > 0
+    ALT_LOG(1, LOG_THREE_STAR_MID, L"Scaling Image to %d x %d", NewWidth, NewHeight);
+    #endif
+
+    NewImage = egCreateImage (NewWidth, NewHeight, Image->HasAlpha);
+    if (NewImage == NULL) {
+        #if REFIT_DEBUG > 0
+        ALT_LOG(1, LOG_THREE_STAR_END, L"In egScaleImage ... Could Not Create New Image!!");
+        #endif
+
+        return NULL;
+    }
+
+    BoxX   = EG_SCALE_BOX (Image->Width,  NewWidth);
+    BoxY   = EG_SCALE_BOX (Image->Height, NewHeight);
+    BlendY = (!BoxX && !BoxY && NewHeight < Image->Height);
+    XTaps  = egScaleTaps (Image->Width,  NewWidth,  &XWeights);
+    YTaps  = egScaleTaps (Image->Height, NewHeight, &YWeights);
+    if (BoxY) {
+        // Two-channel sums of source rows for egScaleSumRows() ... Box spans
+        // that are not sampled cover every column once, in order, so only
+        // other taps need a column list
+        Slots = Image->Width;
+        if (XTaps != NULL && !(BoxX && Image->Width <= NewWidth * EG_SCALE_BOX_TAPS)) {
+            Cols = egScaleColumns (XTaps, NewWidth, &Slots);
+        }
+        Rows[0] = AllocatePool (Slots * sizeof (UINT32));
+        Rows[1] = AllocatePool (Slots * sizeof (UINT32));
+    }
+    else if (BlendY) {
+        // Two-channel blends of source rows for egScaleBlendRows()
+        Rows[0] = AllocatePool (Image->Width * sizeof (UINT32));
+        Rows[1] = AllocatePool (Image->Width * sizeof (UINT32));
+    }
+    else {
+        Rows[0] = AllocatePool (NewWidth * 4 * sizeof (UINT32));
+        Rows[1] = AllocatePool (NewWidth * 4 * sizeof (UINT32));
+        Acc     = AllocatePool (NewWidth * 4 * sizeof (UINT32));
+    }
+    if (XTaps   == NULL ||
+        YTaps   == NULL ||
+        Rows[0] == NULL ||
+        Rows[1] == NULL ||
+        (BoxY && Cols == NULL && Slots != Image->Width) ||
+        (!BoxY && !BlendY && Acc == NULL)
+    ) {
+        #if REFIT_DEBUG > 0
+        ALT_LOG(1, LOG_THREE_STAR_END, L"In egScaleImage ... Could Not Allocate Filter Tables!!");
+        #endif
+
+        MY_FREE_IMAGE(NewImage);
+        goto Done;
+    }
+
+    OutPtr = NewImage->PixelData;
+    if (BlendY) {
+        for (i = 0; i < NewHeight; i++, OutPtr += NewWidth) {
+            // A single tap blends its row with itself, at no weight
+            SrcY = YTaps[i].Start;
+            egScaleBlendRows (
+                Image->PixelData + SrcY * Image->Width,
+                Image->PixelData + (SrcY + YTaps[i].Count - 1) * Image->Width,
+                YWeights[YTaps[i].Weights],
+                (YTaps[i].Count > 1) ? YWeights[YTaps[i].Weights + 1] : 0,
+                Image->Width, Rows[0], Rows[1]
+            );
+            egScaleBlendRow (
+                Rows[0], Rows[1], XTaps, XWeights, NewWidth, OutPtr
+            );
+        }
+    }
+    else if (BoxY) {
+        for (i = 0; i < NewHeight; i++, OutPtr += NewWidth) {
+            egScaleSumRows (
+                Image->PixelData + YTaps[i].Start * Image->Width, Image->Width,
+                YTaps[i].Count, YTaps[i].Step, Cols, Slots, Rows[0], Rows[1]
+            );
+            egScaleSumsRow (
+                Rows[0], Rows[1], YTaps[i].Count, BoxX,
+                XTaps, XWeights, NewWidth, OutPtr
+            );
+        }
+    }
+    else {
+        // Bilinear output rows share source rows with their neighbours ...
+        // Keep the last two filtered rows
+        RowTag[0] = RowTag[1] = Image->Height;
+
+        for (i = 0; i < NewHeight; i++) {
+            SetMem (Acc, NewWidth * 4 * sizeof (UINT32), 0);
+
+            for (k = 0; k < YTaps[i].Count; k++) {
+                SrcY = YTaps[i].Start + k;
+                if (RowTag[0] == SrcY) {
+                    Row = Rows[0];
+                }
+                else if (RowTag[1] == SrcY) {
+                    Row = Rows[1];
+                }
+                else {
+                    Row             = Rows[NextRow];
+                    RowTag[NextRow] = SrcY;
+                    NextRow        ^= 1;
+
+                    egScaleRow (
+                        Image->PixelData + SrcY * Image->Width,
+                        XTaps, XWeights, NewWidth, Row
+                    );
+                }
+
+                w = YWeights[YTaps[i].Weights + k];
+
+                #ifdef EG_VECTOR_COMPOSE
+                for (j = 0; j < NewWidth; j++) {
+                    ((EG_V4U32 *) Acc)[j] += w * ((EG_V4U32 *) Row)[j];
+                }
+                #else
+                for (j = 0; j < NewWidth * 4; j++) {
+                    Acc[j] += w * Row[j];
+                }
+                #endif
+            } // for k
+
+            for (j = 0; j < NewWidth; j++, OutPtr++) {
+                OutPtr->b = (UINT8) ((Acc[j * 4 + 0] + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+                OutPtr->g = (UINT8) ((Acc[j * 4 + 1] + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+                OutPtr->r = (UINT8) ((Acc[j * 4 + 2] + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+                OutPtr->a = (UINT8) ((Acc[j * 4 + 3] + (1 << (EG_SCALE_BITS + 7))) >> (EG_SCALE_BITS + 8));
+            }
+        } // for i
+    } // if BoxY
+
+    #if REFIT_DEBUG > 0
+    ALT_LOG(1, LOG_THREE_STAR_MID, L"Scaling Image Completed");
+    #endif
+
+Done:
+    MY_FREE_POOL(XTaps);
+    MY_FREE_POOL(YTaps);
+    MY_FREE_POOL(XWeights);
+    MY_FREE_POOL(YWeights);
+    MY_FREE_POOL(Rows[0]);
+    MY_FREE_POOL(Rows[1]);
+    MY_FREE_POOL(Acc);
+    MY_FREE_POOL(Cols);
+
+    return NewImage;
+} // EG_IMAGE * egScaleImage()
+
+//
+// Copying and compositing
+//
+
+VOID egRawCopy (
+    IN OUT EG_PIXEL *CompBasePtr,
+    IN EG_PIXEL     *TopBasePtr,
+    IN UINTN         Width,
+    IN UINTN         Height,
+    IN UINTN         CompLineOffset,
+    IN UINTN         TopLineOffset
+) {
+    UINTN       y;
+
+    if (CompBasePtr && TopBasePtr && Width > 0) {
+        if (CompLineOffset == Width && TopLineOffset == Width) {
+            // Both areas are contiguous ... Copy in one go
+            CopyMem (CompBasePtr, TopBasePtr, Width * Height * sizeof (EG_PIXEL));
+
+            return;
+        }
+
+        for (y = 0; y < Height; y++) {
+            CopyMem (CompBasePtr, TopBasePtr, Width * sizeof (EG_PIXEL));
+
+            TopBasePtr  += TopLineOffset;
+            CompBasePtr += CompLineOffset;
+        }
+    }
+} // VOID egRawCopy()
+
+VOID egRawCompose (
+    IN OUT EG_PIXEL *CompBasePtr,
+    IN EG_PIXEL     *TopBasePtr,
+    IN UINTN         Width,
+    IN UINTN         Height,
+    IN UINTN         CompLineOffset,
+    IN UINTN         TopLineOffset
+) {
+    UINTN        x, y;
+    EG_PIXEL    *TopPtr, *CompPtr;
+    UINTN        Alpha;
+    UINTN        RevAlpha;
+    UINTN        Temp;
+
+    if (CompBasePtr && TopBasePtr) {
+        for (y = 0; y < Height; y++) {
+            TopPtr  = TopBasePtr;
+            CompPtr = CompBasePtr;
+            x       = 0;
+
+            #ifdef EG_VECTOR_COMPOSE
+            // Four pixels per step: blue/red and green/alpha are split into the
+            // 16-bit halves of each pixel so that every channel gets the same
+            // integer arithmetic as the scalar loop below. Sums stay below 2^16.
+            for (; x + 4 <= Width; x += 4, TopPtr += 4, CompPtr += 4) {
+                EG_V4U32 Top  = *(EG_V4U32 *) TopPtr;
+                EG_V4U32 Comp = *(EG_V4U32 *) CompPtr;
+                EG_V4U32 Alpha4;
+                EG_V8U16 Alpha8, RevAlpha8, Sum;
+                EG_V4U32 BlueRed, GreenAlpha;
+
+                Alpha4 = Top >> 24;
+                if ((Alpha4[0] | Alpha4[1] | Alpha4[2] | Alpha4[3]) == 0) {
+                    // Fully transparent ... Nothing to blend
+                    continue;
+                }
+
+                Alpha8    = (EG_V8U16) (Alpha4 | (Alpha4 << 16));
+                RevAlpha8 = 255 - Alpha8;
+
+                Sum = (EG_V8U16) (Comp & 0x00FF00FF) * RevAlpha8
+                    + (EG_V8U16) (Top  & 0x00FF00FF) * Alpha8 + 0x80;
+                BlueRed = (EG_V4U32) ((Sum + (Sum >> 8)) >> 8);
+
+                Sum = (EG_V8U16) ((Comp >> 8) & 0x00FF00FF) * RevAlpha8
+                    + (EG_V8U16) ((Top  >> 8) & 0x00FF00FF) * Alpha8 + 0x80;
+                GreenAlpha = (EG_V4U32) ((Sum + (Sum >> 8)) >> 8);
+
+                // Keep the destination's own alpha byte, as the scalar loop does
+                *(EG_V4U32 *) CompPtr = BlueRed | ((GreenAlpha & 0xFF) << 8) | (Comp & 0xFF000000);
+            }
+            #endif
+
+            for (; x < Width; x++) {
+                Alpha    = TopPtr->a;
+                RevAlpha = 255 - Alpha;
+
+                Temp       = (UINTN) CompPtr->b * RevAlpha + (UINTN) TopPtr->b * Alpha + 0x80;
+                CompPtr->b = (Temp + (Temp >> 8)) >> 8;
+                Temp       = (UINTN) CompPtr->g * RevAlpha + (UINTN) TopPtr->g * Alpha + 0x80;
+                CompPtr->g = (Temp + (Temp >> 8)) >> 8;
+                Temp       = (UINTN) CompPtr->r * RevAlpha + (UINTN) TopPtr->r * Alpha + 0x80;
+                CompPtr->r = (Temp + (Temp >> 8)) >> 8;
+
+                TopPtr++, CompPtr++;
+            }
+
+            TopBasePtr  += TopLineOffset;
+            CompBasePtr += CompLineOffset;
+        }
+    }
+} // VOID egRawCompose()
+
+/* EOF */
@@ -103,6 +103,9 @@ VOID egInitScreen (VOID);
 VOID egScreenShot (VOID);
 VOID egLoadFont (IN CHAR16 *Filename);
 VOID egClearScreen (IN EG_PIXEL *Color);
+VOID egBeginFrame (VOID);
+VOID egEndFrame (VOID);
+VOID egFreeIconCache (VOID);
 VOID egFillImage (IN OUT EG_IMAGE *CompImage, IN EG_PIXEL *Color);
 VOID egGetScreenSize (OUT UINTN *ScreenWidth, OUT UINTN *ScreenHeight);
 VOID egMeasureText (IN CHAR16 *Text, OUT UINTN *Width, OUT UINTN *Height);
@@ -204,6 +207,11 @@ EG_IMAGE * egDecodePNG (
     IN UINTN    IconSize,
     IN BOOLEAN  WantAlpha
 );
+EFI_STATUS egEncodePNG (
+    IN  EG_IMAGE  *Image,
+    OUT UINT8    **FileData,
+    OUT UINTN     *FileDataLength
+);
 EG_IMAGE * egDecodeJPEG (
     IN UINT8   *FileData,
     IN UINTN    FileDataLength,
@@ -771,6 +771,10 @@ typedef struct LodePNGDecoderSettings {
 
   unsigned color_convert; /*whether to convert the PNG to the color type you want. Default: yes*/
 
+  /*buffer the image is decoded into instead of a new allocation, only used when color_convert is false.
+  It must hold lodepng_get_raw_size of the PNG and is never freed by LodePNG. Default: NULL*/
+  unsigned char* out_buffer;
+
 #ifdef LODEPNG_COMPILE_ANCILLARY_CHUNKS
   unsigned read_text_chunks; /*if false but remember_unknown_chunks is true, they're stored in the unknown chunks*/
 
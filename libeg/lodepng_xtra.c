@@ -29,9 +29,13 @@
  * Modifications distributed under the preceding terms.
  */
 
+#ifdef HOST_POSIX
+#include "test/eg_posix_base.h"
+#else
 #include "global.h"
 #include "../BootMaster/screenmgt.h"
 #include "../BootMaster/rp_funcs.h"
+#endif
 #include "lodepng.h"
 
 // EFI's equivalent of realloc requires the original buffer's size as an
@@ -43,9 +47,115 @@
 // lodepng_refit_malloc() should be freed via lodepng_refit_free(), and myfree() should
 // NOT be used with memory allocated via AllocatePool() or AllocateZeroPool()!
 
+// While egDecodePNG is running, LodePNG's allocations are carved out of a
+// scratch arena instead of the pool. A decode makes a burst of short lived
+// allocations (IDAT concatenation, inflate output, scanlines and palette
+// copies) that are all dead by the time the image has been handed over, so
+// they are dropped together with one reset. The arena is sized from the PNG
+// header up front. Only an icon sized arena is kept for the next decode, as
+// every bundled icon fits in LODE_ARENA_KEEP_SIZE, and larger arenas for
+// banners and backgrounds are freed once the decode is done.
+// The newest block can grow or shrink in place, which covers the inflate
+// output buffer. Anything that does not fit spills over to the pool.
+// Blocks are zeroed like the AllocateZeroPool blocks they replace, so no
+// part of LodePNG can see data left over from an earlier decode.
+#define LODE_ARENA_MIN_SIZE      (256 * 1024)
+#define LODE_ARENA_KEEP_SIZE     (256 * 1024)
+#define LODE_ARENA_MAX_SIZE      (32 * 1024 * 1024)
+#define LODE_ARENA_ALIGN(Size)   (((Size) + 7) & ~((size_t) 7))
+
+typedef struct {
+   UINT8   *Base;
+   size_t   Size;
+   size_t   Used;
+   size_t   Last;      // Offset of the newest block header
+   BOOLEAN  Active;
+} LODE_ARENA;
+
+static LODE_ARENA LodeArena = { NULL, 0, 0, 0, FALSE };
+
+static
+BOOLEAN LodeArenaOwns (
+   void *ptr
+) {
+   return (
+      LodeArena.Base != NULL                          &&
+      (UINT8 *) ptr  >  LodeArena.Base                &&
+      (UINT8 *) ptr  <  LodeArena.Base + LodeArena.Size
+   );
+} // static BOOLEAN LodeArenaOwns()
+
+static
+void * LodeArenaAlloc (
+   size_t size
+) {
+   size_t  Need;
+   size_t *Block;
+
+   if (!LodeArena.Active || size > LODE_ARENA_MAX_SIZE) {
+      // Early Return
+      return NULL;
+   }
+
+   Need = LODE_ARENA_ALIGN(size + sizeof (size_t));
+   if (Need > LodeArena.Size - LodeArena.Used) {
+      // Early Return
+      return NULL;
+   }
+
+   Block  = (size_t *) (LodeArena.Base + LodeArena.Used);
+   *Block = size;
+   ZeroMem (Block + 1, size);
+
+   LodeArena.Last  = LodeArena.Used;
+   LodeArena.Used += Need;
+
+   return Block + 1;
+} // static void * LodeArenaAlloc()
+
+static
+VOID LodeArenaBegin (
+   IN size_t SizeHint
+) {
+   if (SizeHint < LODE_ARENA_MIN_SIZE) {
+      SizeHint = LODE_ARENA_MIN_SIZE;
+   }
+   else if (SizeHint > LODE_ARENA_MAX_SIZE) {
+      SizeHint = LODE_ARENA_MAX_SIZE;
+   }
+
+   if (LodeArena.Size < SizeHint) {
+      MY_FREE_POOL(LodeArena.Base);
+      LodeArena.Base = AllocatePool (SizeHint);
+      LodeArena.Size = (LodeArena.Base != NULL) ? SizeHint : 0;
+   }
+
+   LodeArena.Used   = 0;
+   LodeArena.Last   = 0;
+   LodeArena.Active = (LodeArena.Base != NULL);
+} // static VOID LodeArenaBegin()
+
+static
+VOID LodeArenaEnd (VOID) {
+   LodeArena.Used   = 0;
+   LodeArena.Last   = 0;
+   LodeArena.Active = FALSE;
+
+   // Do not hold on to banner sized arenas
+   if (LodeArena.Size > LODE_ARENA_KEEP_SIZE) {
+      MY_FREE_POOL(LodeArena.Base);
+      LodeArena.Size = 0;
+   }
+} // static VOID LodeArenaEnd()
+
 void* lodepng_refit_malloc(size_t size) {
    void *ptr;
 
+   ptr = LodeArenaAlloc (size);
+   if (ptr) {
+      return ptr;
+   }
+
    ptr = AllocateZeroPool(size + sizeof (size_t));
    if (ptr) {
       *(size_t *) ptr = size;
@@ -57,6 +167,14 @@ void* lodepng_refit_malloc(size_t size) {
 
 void lodepng_refit_free (void *ptr) {
    if (ptr) {
+      if (LodeArenaOwns (ptr)) {
+         // Only the newest block can be handed back before the reset
+         if ((UINT8 *) ptr - sizeof (size_t) == LodeArena.Base + LodeArena.Last) {
+            LodeArena.Used = LodeArena.Last;
+         }
+         return;
+      }
+
       ptr = (void *) (((size_t *) ptr) - 1);
       FreePool(ptr);
    }
@@ -72,11 +190,30 @@ static size_t report_size(void *ptr) {
 void* lodepng_refit_realloc(void *ptr, size_t new_size) {
    size_t *new_pool;
    size_t old_size;
+   size_t Need;
+
+   if (ptr && LodeArenaOwns (ptr) &&
+      (UINT8 *) ptr - sizeof (size_t) == LodeArena.Base + LodeArena.Last
+   ) {
+      Need = LODE_ARENA_ALIGN(new_size + sizeof (size_t));
+      if (new_size <= LODE_ARENA_MAX_SIZE && Need <= LodeArena.Size - LodeArena.Last) {
+         // Newest block ... Resize in place
+         old_size = report_size(ptr);
+         if (new_size > old_size) {
+            ZeroMem ((UINT8 *) ptr + old_size, new_size - old_size);
+         }
+         *(((size_t *) ptr) - 1) = new_size;
+         LodeArena.Used = LodeArena.Last + Need;
+
+         return ptr;
+      }
+   }
 
    new_pool = lodepng_refit_malloc(new_size);
    if (new_pool && ptr) {
       old_size = report_size(ptr);
       CopyMem(new_pool, ptr, (old_size < new_size) ? old_size : new_size);
+      lodepng_refit_free(ptr);
    }
    return new_pool;
 } // lodepng_refit_realloc()
@@ -103,12 +240,89 @@ VOID *MyMemCpy(void *__restrict __dest, const void *__restrict __src, size_t __n
     return __dest;
 }
 
-typedef struct _lode_color {
-   UINT8 red;
-   UINT8 green;
-   UINT8 blue;
-   UINT8 alpha;
-} lode_color;
+// Turns a decoded PNG into the EFI BGRA pixel array of Image.
+// 8-bit palette, RGB and RGBA, which cover nearly all theme icons, are
+// decoded by LodePNG straight into Image, so RawData is the pixel array
+// itself. RGBA then only has red and blue swapped. Palette indices and RGB
+// are widened from the last pixel back, so no pixel is overwritten before
+// it has been read. Other colour types are converted to RGBA into Image by
+// LodePNG, and then have red and blue swapped.
+static
+BOOLEAN LodeToEgPixels (
+    IN OUT EG_IMAGE          *Image,
+    IN     unsigned char     *RawData,
+    IN     LodePNGColorMode  *RawMode,
+    IN     BOOLEAN            WantAlpha
+) {
+   UINTN              i;
+   UINTN              PixelCount;
+   UINT8              Swap;
+   UINT8              Red;
+   UINT8              Green;
+   EG_PIXEL          *Pixel;
+   EG_PIXEL           Palette[256];
+   unsigned char     *Src;
+   LodePNGColorMode   EgMode;
+
+   PixelCount = Image->Width * Image->Height;
+   Pixel      = Image->PixelData;
+
+   if (RawData == (unsigned char *) Pixel && RawMode->colortype == LCT_PALETTE) {
+      // LodePNG always holds 256 entries, with unused ones opaque black
+      for (i = 0; i < 256; i++) {
+         Palette[i].r = RawMode->palette[(i * 4) + 0];
+         Palette[i].g = RawMode->palette[(i * 4) + 1];
+         Palette[i].b = RawMode->palette[(i * 4) + 2];
+         Palette[i].a = (WantAlpha) ? RawMode->palette[(i * 4) + 3] : 0;
+      }
+
+      for (i = PixelCount; i-- > 0; ) {
+         Pixel[i] = Palette[RawData[i]];
+      }
+
+      return TRUE;
+   }
+
+   if (RawData == (unsigned char *) Pixel && RawMode->colortype == LCT_RGB) {
+      Src = RawData + (PixelCount * 3);
+      for (i = PixelCount; i-- > 0; ) {
+         Src       -= 3;
+         Red        = Src[0];
+         Green      = Src[1];
+         Pixel[i].b = Src[2];
+         Pixel[i].g = Green;
+         Pixel[i].r = Red;
+         Pixel[i].a = (WantAlpha) ? 255 : 0;
+      }
+
+      return TRUE;
+   }
+
+   if (RawData != (unsigned char *) Pixel) {
+      EgMode = lodepng_color_mode_make (LCT_RGBA, 8);
+      if (lodepng_convert (
+            (unsigned char *) Pixel, RawData,
+            &EgMode, RawMode,
+            (unsigned) Image->Width, (unsigned) Image->Height
+         )
+      ) {
+         // Early Return
+         return FALSE;
+      }
+   }
+
+   // R, G, B, A sit in the b, g, r, a slots
+   for (i = 0; i < PixelCount; i++) {
+      Swap       = Pixel[i].b;
+      Pixel[i].b = Pixel[i].r;
+      Pixel[i].r = Swap;
+      if (!WantAlpha) {
+         Pixel[i].a = 0;
+      }
+   }
+
+   return TRUE;
+} // static BOOLEAN LodeToEgPixels()
 
 EG_IMAGE * egDecodePNG (
     IN UINT8   *FileData,
@@ -116,48 +330,380 @@ EG_IMAGE * egDecodePNG (
     IN UINTN    IconSize,
     IN BOOLEAN  WantAlpha
 ) {
-   EG_IMAGE *NewImage = NULL;
-   unsigned Error, Width, Height;
-   EG_PIXEL *PixelData;
-   lode_color *LodeData;
-   UINTN i;
-
-   Error = lodepng_decode_memory (
-       (unsigned char **) &PixelData,
-        &Width,
-        &Height,
-        (unsigned char *) FileData,
-        (size_t) FileDataLength,
-        LCT_RGBA, 8
-    );
+   EG_IMAGE          *NewImage;
+   unsigned           Error, Width, Height;
+   unsigned char     *RawData;
+   size_t             RawSize;
+   BOOLEAN            Direct;
+   LodePNGColorMode  *RawMode;
+   LodePNGState       State;
+
+   // Keep the pixels in the file's own format; conversion to BGRA is done
+   // in the EG_IMAGE below.
+   lodepng_state_init (&State);
+   State.decoder.color_convert = 0;
 
+   Error = lodepng_inspect (
+       &Width, &Height, &State,
+       (unsigned char *) FileData, (size_t) FileDataLength
+   );
    if (Error) {
+      lodepng_state_cleanup (&State);
+
+      // Early Return
       return NULL;
    }
 
-   // allocate image structure and buffer
    NewImage = egCreateImage (Width, Height, WantAlpha);
    if (NewImage == NULL) {
-       return NULL;
+      lodepng_state_cleanup (&State);
+
+      // Early Return
+      return NULL;
    }
-   if (NewImage->Width != Width || NewImage->Height != Height) {
-       // Should never happen; just being paranoid.
-       MY_FREE_IMAGE(NewImage);
-       return NULL;
+
+   // 8-bit palette, RGB and RGBA fit in the pixel array, so are decoded into it
+   RawMode = &State.info_png.color;
+   Direct  = (
+      RawMode->bitdepth == 8 &&
+      (
+         RawMode->colortype == LCT_RGBA ||
+         (RawMode->colortype == LCT_RGB && !RawMode->key_defined) ||
+         (RawMode->colortype == LCT_PALETTE && RawMode->palette != NULL)
+      )
+   );
+   if (Direct) {
+      State.decoder.out_buffer = (unsigned char *) NewImage->PixelData;
    }
 
-   LodeData = (lode_color *) PixelData;
+   // Inflate output and scanlines are each about the raw size
+   RawSize = lodepng_get_raw_size (Width, Height, RawMode);
+   LodeArenaBegin (
+      (RawSize < LODE_ARENA_MAX_SIZE)
+         ? (((Direct) ? 1 : 2) * RawSize) + (2 * Height) + FileDataLength + 4096
+         : LODE_ARENA_MAX_SIZE
+   );
 
-   // Annoyingly, EFI and LodePNG use different ordering of RGB values in
-   // their pixel data representations, so we've got to adjust them.
-   for (i = 0; i < (NewImage->Height * NewImage->Width); i++) {
-      NewImage->PixelData[i].r = LodeData[i].red;
-      NewImage->PixelData[i].g = LodeData[i].green;
-      NewImage->PixelData[i].b = LodeData[i].blue;
-      if (WantAlpha)
-         NewImage->PixelData[i].a = LodeData[i].alpha;
+   RawData = NULL;
+   Error   = lodepng_decode (
+       &RawData, &Width, &Height, &State,
+       (unsigned char *) FileData, (size_t) FileDataLength
+   );
+   if (Error ||
+      Width  != NewImage->Width  ||
+      Height != NewImage->Height ||
+      !LodeToEgPixels (NewImage, RawData, RawMode, WantAlpha)
+   ) {
+      MY_FREE_IMAGE(NewImage);
    }
-   lodepng_refit_free (PixelData);
+
+   if (RawData != State.decoder.out_buffer) {
+      lodepng_refit_free (RawData);
+   }
+   lodepng_state_cleanup (&State);
+   LodeArenaEnd();
 
    return NewImage;
 } // EG_IMAGE * egDecodePNG()
+
+// Fast PNG writer for screenshots.
+// LodePNG's encoder runs a full LZ77 search and tries every filter on every
+// row, which takes several seconds on a large screen. Screenshots are mostly
+// flat colour, so each row gets the Sub filter, which turns flat runs into
+// zeros, and the deflate stream only looks for runs of the previous byte
+// (distance 1) and codes them with the fixed Huffman tables. The BGRA to RGB
+// swap is done while each row is fed to the encoder. Output is 8-bit RGB.
+#define LODE_FAST_ADLER_BASE     65521
+#define LODE_FAST_ADLER_NMAX     5552
+#define LODE_FAST_MAX_RUN        258
+
+typedef struct {
+   UINT8   *Out;
+   UINT64   Acc;
+   UINTN    AccBits;
+} LODE_BIT_WRITER;
+
+static BOOLEAN  LodeFastReady = FALSE;
+static UINT16   LodeFastLitCode[256];
+static UINT8    LodeFastLitBits[256];
+static UINT32   LodeFastRunCode[LODE_FAST_MAX_RUN + 1];
+static UINT8    LodeFastRunBits[LODE_FAST_MAX_RUN + 1];
+
+static
+UINT32 LodeReverseBits (
+   IN UINT32 Code,
+   IN UINTN  Bits
+) {
+   UINT32 Result = 0;
+
+   while (Bits-- > 0) {
+      Result = (Result << 1) | (Code & 1);
+      Code >>= 1;
+   }
+
+   return Result;
+} // static UINT32 LodeReverseBits()
+
+// Builds the bit reversed fixed Huffman codes, with each run length
+// combined with its extra bits and the distance 1 code.
+static
+VOID LodeFastInit (VOID) {
+   static const UINT16 LenBase[29] = {
+      3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+   };
+   static const UINT8 LenExtra[29] = {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+   };
+   UINTN   i;
+   UINTN   Len;
+   UINTN   Sym;
+   UINTN   SymBits;
+   UINT32  SymCode;
+
+   if (LodeFastReady) {
+      // Early Return
+      return;
+   }
+
+   for (i = 0; i < 256; i++) {
+      if (i < 144) {
+         LodeFastLitCode[i] = (UINT16) LodeReverseBits (0x30 + (UINT32) i, 8);
+         LodeFastLitBits[i] = 8;
+      }
+      else {
+         LodeFastLitCode[i] = (UINT16) LodeReverseBits (0x190 + (UINT32) (i - 144), 9);
+         LodeFastLitBits[i] = 9;
+      }
+   }
+
+   Sym = 0;
+   for (Len = 3; Len <= LODE_FAST_MAX_RUN; Len++) {
+      while (Sym < 28 && Len >= LenBase[Sym + 1]) {
+         Sym++;
+      }
+
+      // Length symbols 257 to 279 use 7 bits, 280 to 285 use 8 bits
+      if (Sym + 257 < 280) {
+         SymCode = LodeReverseBits ((UINT32) (Sym + 1), 7);
+         SymBits = 7;
+      }
+      else {
+         SymCode = LodeReverseBits (0xC0 + (UINT32) (Sym + 257 - 280), 8);
+         SymBits = 8;
+      }
+
+      // Distance 1 is distance code 0 ... Five zero bits
+      LodeFastRunCode[Len] = SymCode | ((UINT32) (Len - LenBase[Sym]) << SymBits);
+      LodeFastRunBits[Len] = (UINT8) (SymBits + LenExtra[Sym] + 5);
+   }
+
+   LodeFastReady = TRUE;
+} // static VOID LodeFastInit()
+
+static
+VOID LodeBitPut (
+   IN OUT LODE_BIT_WRITER *Writer,
+   IN     UINT32           Code,
+   IN     UINTN            Bits
+) {
+   Writer->Acc     |= (UINT64) Code << Writer->AccBits;
+   Writer->AccBits += Bits;
+
+   if (Writer->AccBits >= 32) {
+      Writer->Out[0]    = (UINT8) (Writer->Acc);
+      Writer->Out[1]    = (UINT8) (Writer->Acc >> 8);
+      Writer->Out[2]    = (UINT8) (Writer->Acc >> 16);
+      Writer->Out[3]    = (UINT8) (Writer->Acc >> 24);
+      Writer->Out      += 4;
+      Writer->Acc     >>= 32;
+      Writer->AccBits  -= 32;
+   }
+} // static VOID LodeBitPut()
+
+static
+VOID LodeBitFlush (
+   IN OUT LODE_BIT_WRITER *Writer
+) {
+   while (Writer->AccBits > 0) {
+      *Writer->Out++ = (UINT8) Writer->Acc;
+      Writer->Acc  >>= 8;
+      Writer->AccBits = (Writer->AccBits > 8) ? Writer->AccBits - 8 : 0;
+   }
+} // static VOID LodeBitFlush()
+
+static
+VOID LodePut32 (
+   IN UINT8  *Out,
+   IN UINT32  Value
+) {
+   Out[0] = (UINT8) (Value >> 24);
+   Out[1] = (UINT8) (Value >> 16);
+   Out[2] = (UINT8) (Value >> 8);
+   Out[3] = (UINT8) (Value);
+} // static VOID LodePut32()
+
+EFI_STATUS egEncodePNG (
+   IN  EG_IMAGE  *Image,
+   OUT UINT8    **FileData,
+   OUT UINTN     *FileDataLength
+) {
+   UINTN             x, y, i, Run;
+   UINTN             RowLen;
+   UINTN             RawSize;
+   UINTN             MaxSize;
+   UINTN             IdatLen;
+   UINTN             Chunk;
+   UINT32            Adler1;
+   UINT32            Adler2;
+   UINT8            *Buffer;
+   UINT8            *Row;
+   UINT8            *Idat;
+   UINT8            *Src;
+   UINT8            *Dst;
+   EG_PIXEL         *Pixel;
+   LODE_BIT_WRITER   Writer;
+
+   *FileData       = NULL;
+   *FileDataLength = 0;
+
+   if (Image == NULL || Image->PixelData == NULL ||
+      Image->Width == 0 || Image->Height == 0
+   ) {
+      // Early Return
+      return EFI_INVALID_PARAMETER;
+   }
+
+   RowLen  = 1 + (Image->Width * 3);
+   RawSize = RowLen * Image->Height;
+
+   // Literals take at most 9 bits per byte and runs take less.
+   // Add the signature, IHDR, IDAT and IEND framing plus zlib wrapper.
+   MaxSize = ((RawSize * 9) / 8) + 16 + 8 + 25 + 12 + 6 + 12;
+   if (MaxSize > 0x7FFFFFFF) {
+      // Early Return
+      return EFI_BAD_BUFFER_SIZE;
+   }
+
+   Buffer = AllocatePool (MaxSize);
+   Row    = AllocatePool (RowLen);
+   if (Buffer == NULL || Row == NULL) {
+      MY_FREE_POOL(Buffer);
+      MY_FREE_POOL(Row);
+
+      // Early Return
+      return EFI_OUT_OF_RESOURCES;
+   }
+
+   LodeFastInit();
+
+   // Signature
+   Dst = Buffer;
+   Dst[0] = 0x89; Dst[1] = 'P';  Dst[2] = 'N';  Dst[3] = 'G';
+   Dst[4] = 0x0D; Dst[5] = 0x0A; Dst[6] = 0x1A; Dst[7] = 0x0A;
+   Dst += 8;
+
+   // IHDR ... 8-bit RGB, no interlace
+   LodePut32 (Dst, 13);
+   Dst[4] = 'I'; Dst[5] = 'H'; Dst[6] = 'D'; Dst[7] = 'R';
+   LodePut32 (Dst + 8,  (UINT32) Image->Width);
+   LodePut32 (Dst + 12, (UINT32) Image->Height);
+   Dst[16] = 8;
+   Dst[17] = 2;
+   Dst[18] = 0;
+   Dst[19] = 0;
+   Dst[20] = 0;
+   LodePut32 (Dst + 21, lodepng_crc32 (Dst + 4, 17));
+   Dst += 25;
+
+   // IDAT ... Length is filled in once known
+   Idat = Dst;
+   Dst[4] = 'I'; Dst[5] = 'D'; Dst[6] = 'A'; Dst[7] = 'T';
+   Dst[8] = 0x78;
+   Dst[9] = 0x01;
+
+   Writer.Out     = Dst + 10;
+   Writer.Acc     = 0;
+   Writer.AccBits = 0;
+
+   // Single final block with fixed Huffman codes
+   LodeBitPut (&Writer, 3, 3);
+
+   Adler1 = 1;
+   Adler2 = 0;
+   Pixel  = Image->PixelData;
+   for (y = 0; y < Image->Height; y++) {
+      // Sub filter with the channel swap folded in
+      Row[0] = 1;
+      Row[1] = Pixel[0].r;
+      Row[2] = Pixel[0].g;
+      Row[3] = Pixel[0].b;
+      for (x = 1; x < Image->Width; x++) {
+         Row[(x * 3) + 1] = (UINT8) (Pixel[x].r - Pixel[x - 1].r);
+         Row[(x * 3) + 2] = (UINT8) (Pixel[x].g - Pixel[x - 1].g);
+         Row[(x * 3) + 3] = (UINT8) (Pixel[x].b - Pixel[x - 1].b);
+      }
+      Pixel += Image->Width;
+
+      Src = Row;
+      i   = RowLen;
+      while (i > 0) {
+         Chunk = (i < LODE_FAST_ADLER_NMAX) ? i : LODE_FAST_ADLER_NMAX;
+         i    -= Chunk;
+         while (Chunk-- > 0) {
+            Adler1 += *Src++;
+            Adler2 += Adler1;
+         }
+         Adler1 %= LODE_FAST_ADLER_BASE;
+         Adler2 %= LODE_FAST_ADLER_BASE;
+      }
+
+      // The filter byte is always a literal, so runs never cross rows
+      LodeBitPut (&Writer, LodeFastLitCode[Row[0]], LodeFastLitBits[Row[0]]);
+      i = 1;
+      while (i < RowLen) {
+         Run = 0;
+         while (Run < LODE_FAST_MAX_RUN &&
+            i + Run < RowLen &&
+            Row[i + Run] == Row[i - 1]
+         ) {
+            Run++;
+         }
+
+         if (Run >= 3) {
+            LodeBitPut (&Writer, LodeFastRunCode[Run], LodeFastRunBits[Run]);
+            i += Run;
+         }
+         else {
+            LodeBitPut (&Writer, LodeFastLitCode[Row[i]], LodeFastLitBits[Row[i]]);
+            i++;
+         }
+      }
+   }
+
+   // End of block
+   LodeBitPut (&Writer, 0, 7);
+   LodeBitFlush (&Writer);
+
+   LodePut32 (Writer.Out, (Adler2 << 16) | Adler1);
+   Dst = Writer.Out + 4;
+
+   IdatLen = (UINTN) (Dst - Idat) - 8;
+   LodePut32 (Idat, (UINT32) IdatLen);
+   LodePut32 (Dst, lodepng_crc32 (Idat + 4, IdatLen + 4));
+   Dst += 4;
+
+   // IEND
+   LodePut32 (Dst, 0);
+   Dst[4] = 'I'; Dst[5] = 'E'; Dst[6] = 'N'; Dst[7] = 'D';
+   LodePut32 (Dst + 8, lodepng_crc32 (Dst + 4, 4));
+   Dst += 12;
+
+   MY_FREE_POOL(Row);
+
+   *FileData       = Buffer;
+   *FileDataLength = (UINTN) (Dst - Buffer);
+
+   return EFI_SUCCESS;
+} // EFI_STATUS egEncodePNG()
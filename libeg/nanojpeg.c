@@ -134,6 +134,7 @@ typedef enum _nj_result {
 // For safety reasons, this should be called at least one time before using
 // using any of the other NanoJPEG functions.
 // Returns 1 on success, 0 on failure.
+// Modified: njDecode() and njDecodeScaled() now initialize NanoJPEG themselves.
 int njInit(void);
 
 // njDecode: Decode a JPEG image.
@@ -144,6 +145,22 @@ int njInit(void);
 // Return value: The error code in case of failure, or NJ_OK (zero) on success.
 nj_result_t njDecode(const void* jpeg, const int size);
 
+// Modified: njDecodeScaled: Decode a JPEG image at reduced resolution.
+// As njDecode(), but picks the smallest of 1/2, 1/4 or 1/8 size for which
+// the longer side of the image is still at least minsize pixels, and runs a
+// reduced IDCT so that the image never exists at full size. A minsize of
+// zero decodes at full size. njGetWidth() and njGetHeight() report the size
+// actually decoded. The planes are left unconverted; use njGetImageBGRA()
+// to fetch the pixels.
+nj_result_t njDecodeScaled(const void* jpeg, const int size, int minsize);
+
+// Modified: njGetImageBGRA: Fetch the image decoded by njDecodeScaled().
+// Writes njGetWidth() * njGetHeight() pixels to out as four consecutive
+// bytes for the blue, green, red and alpha channels, with every alpha byte
+// set to the given value. Grayscale images are expanded to color.
+// Return value: The error code in case of failure, or NJ_OK (zero) on success.
+nj_result_t njGetImageBGRA(unsigned char* out, unsigned char alpha);
+
 // njGetWidth: Return the width (in pixels) of the most recently decoded
 // image. If njDecode() failed, the result of njGetWidth() is undefined.
 int njGetWidth(void);
@@ -175,6 +192,7 @@ int njGetImageSize(void);
 // Resets NanoJPEG's internal state and frees all memory that has been
 // allocated at run-time by NanoJPEG. It is still possible to decode another
 // image after a njDone() call.
+// Modified: Nothing is left allocated after njDone().
 void njDone(void);
 
 #endif//_NANOJPEG_H
@@ -337,6 +355,7 @@ typedef struct _nj_ctx {
     int buf, bufbits;
     int block[64];
     int rstinterval;
+    int scale, minsize;
     unsigned char *rgb;
 } nj_context_t;
 
@@ -452,6 +471,48 @@ NJ_INLINE void njColIDCT(const int* blk, unsigned char *out, int stride) {
     *out = njClip(((x7 - x1) >> 14) + 128);
 }
 
+// Modified: Reduced IDCTs for njDecodeScaled(). These evaluate the block's
+// 8-point inverse transform at the centre of each 2x2 (4x4 output) or 4x4
+// (2x2 output) pixel group, which only needs the lowest 4x4 or 2x2
+// coefficients. A 1x1 output is the DC term alone.
+#define NJ_C1 3784  // 4096 * cos(pi/8)
+#define NJ_C2 2896  // 4096 * cos(pi/4)
+#define NJ_C3 1567  // 4096 * cos(3pi/8)
+
+NJ_INLINE void njIDCT4x4(const int* blk, unsigned char *out, int stride) {
+    int tmp[16], i, e0, e1, o0, o1;
+    for (i = 0;  i < 4;  ++i) {
+        e0 = blk[0] * NJ_C2;
+        e1 = blk[2] * NJ_C2;
+        o0 = blk[1] * NJ_C1 + blk[3] * NJ_C3;
+        o1 = blk[1] * NJ_C3 - blk[3] * NJ_C1;
+        tmp[(i << 2) + 0] = (e0 + e1 + o0 + 512) >> 10;
+        tmp[(i << 2) + 1] = (e0 - e1 + o1 + 512) >> 10;
+        tmp[(i << 2) + 2] = (e0 - e1 - o1 + 512) >> 10;
+        tmp[(i << 2) + 3] = (e0 + e1 - o0 + 512) >> 10;
+        blk += 8;
+    }
+    for (i = 0;  i < 4;  ++i) {
+        e0 = tmp[i] * NJ_C2;
+        e1 = tmp[8 + i] * NJ_C2;
+        o0 = tmp[4 + i] * NJ_C1 + tmp[12 + i] * NJ_C3;
+        o1 = tmp[4 + i] * NJ_C3 - tmp[12 + i] * NJ_C1;
+        out[i]              = njClip(((e0 + e1 + o0 + 32768) >> 16) + 128);
+        out[stride + i]     = njClip(((e0 - e1 + o1 + 32768) >> 16) + 128);
+        out[2 * stride + i] = njClip(((e0 - e1 - o1 + 32768) >> 16) + 128);
+        out[3 * stride + i] = njClip(((e0 + e1 - o0 + 32768) >> 16) + 128);
+    }
+}
+
+NJ_INLINE void njIDCT2x2(const int* blk, unsigned char *out, int stride) {
+    const int a = blk[0] + blk[1], b = blk[0] - blk[1];
+    const int c = blk[8] + blk[9], d = blk[8] - blk[9];
+    out[0]          = njClip(((a + c + 4) >> 3) + 128);
+    out[1]          = njClip(((b + d + 4) >> 3) + 128);
+    out[stride]     = njClip(((a - c + 4) >> 3) + 128);
+    out[stride + 1] = njClip(((b - d + 4) >> 3) + 128);
+}
+
 #define njThrow(e) do { nj.error = e; return; } while (0)
 #define njCheckError() do { if (nj.error) return; } while (0)
 
@@ -571,16 +632,28 @@ NJ_INLINE void njDecodeSOF(void) {
     nj.mbsizey = ssymax << 3;
     nj.mbwidth = (nj.width + nj.mbsizex - 1) / nj.mbsizex;
     nj.mbheight = (nj.height + nj.mbsizey - 1) / nj.mbsizey;
+    // Modified: With a reduced IDCT, the planes shrink by the same factor as
+    // the blocks. Lower the scale if a subsampled plane would end up too
+    // small for the chroma upsampling filter.
+    if (nj.minsize > 0) {
+        i = (nj.width > nj.height) ? nj.width : nj.height;
+        while ((nj.scale < 3) && ((i >> (nj.scale + 1)) >= nj.minsize)) ++nj.scale;
+    }
+    for (;;) {
+        for (i = 0, c = nj.comp;  i < nj.ncomp;  ++i, ++c) {
+            c->width = ((nj.width * c->ssx + ssxmax - 1) / ssxmax + (1 << nj.scale) - 1) >> nj.scale;
+            c->height = ((nj.height * c->ssy + ssymax - 1) / ssymax + (1 << nj.scale) - 1) >> nj.scale;
+            if (((c->width < 3) && (c->ssx != ssxmax)) || ((c->height < 3) && (c->ssy != ssymax))) break;
+        }
+        if ((i == nj.ncomp) || !nj.scale) break;
+        --nj.scale;
+    }
+    nj.width = (nj.width + (1 << nj.scale) - 1) >> nj.scale;
+    nj.height = (nj.height + (1 << nj.scale) - 1) >> nj.scale;
     for (i = 0, c = nj.comp;  i < nj.ncomp;  ++i, ++c) {
-        c->width = (nj.width * c->ssx + ssxmax - 1) / ssxmax;
-        c->height = (nj.height * c->ssy + ssymax - 1) / ssymax;
-        c->stride = nj.mbwidth * c->ssx << 3;
+        c->stride = nj.mbwidth * c->ssx << (3 - nj.scale);
         if (((c->width < 3) && (c->ssx != ssxmax)) || ((c->height < 3) && (c->ssy != ssymax))) njThrow(NJ_UNSUPPORTED);
-        if (!(c->pixels = (unsigned char*) njAllocMem(c->stride * nj.mbheight * c->ssy << 3))) njThrow(NJ_OUT_OF_MEM);
-    }
-    if (nj.ncomp == 3) {
-        nj.rgb = (unsigned char*) njAllocMem(nj.width * nj.height * nj.ncomp);
-        if (!nj.rgb) njThrow(NJ_OUT_OF_MEM);
+        if (!(c->pixels = (unsigned char*) njAllocMem(c->stride * nj.mbheight * c->ssy << (3 - nj.scale)))) njThrow(NJ_OUT_OF_MEM);
     }
     njSkip(nj.length);
 }
@@ -680,6 +753,12 @@ NJ_INLINE void njDecodeBlock(nj_component_t* c, unsigned char* out) {
         if (coef > 63) njThrow(NJ_SYNTAX_ERROR);
         nj.block[(int) njZZ[coef]] = value * nj.qtab[c->qtsel][coef];
     } while (coef < 63);
+    // Modified: Reduced output for njDecodeScaled()
+    switch (nj.scale) {
+        case 3: *out = njClip(((nj.block[0] + 4) >> 3) + 128);  return;
+        case 2: njIDCT2x2(nj.block, out, c->stride);  return;
+        case 1: njIDCT4x4(nj.block, out, c->stride);  return;
+    }
     for (coef = 0;  coef < 64;  coef += 8)
         njRowIDCT(&nj.block[coef]);
     for (coef = 0;  coef < 8;  ++coef)
@@ -708,7 +787,7 @@ NJ_INLINE void njDecodeScan(void) {
         for (i = 0, c = nj.comp;  i < nj.ncomp;  ++i, ++c)
             for (sby = 0;  sby < c->ssy;  ++sby)
                 for (sbx = 0;  sbx < c->ssx;  ++sbx) {
-                    njDecodeBlock(c, &c->pixels[((mby * c->ssy + sby) * c->stride + mbx * c->ssx + sbx) << 3]);
+                    njDecodeBlock(c, &c->pixels[((mby * c->ssy + sby) * c->stride + mbx * c->ssx + sbx) << (3 - nj.scale)]);
                     njCheckError();
                 }
         if (++mbx >= nj.mbwidth) {
@@ -825,7 +904,8 @@ NJ_INLINE void njUpsample(nj_component_t* c) {
 
 #endif
 
-NJ_INLINE void njConvert(void) {
+// Modified: Chroma upsampling split out of njConvert() for njGetImageBGRA().
+static void njUpsamplePlanes(void) {
     int i;
     nj_component_t* c;
     for (i = 0, c = nj.comp;  i < nj.ncomp;  ++i, ++c) {
@@ -842,13 +922,22 @@ NJ_INLINE void njConvert(void) {
         #endif
         if ((c->width < nj.width) || (c->height < nj.height)) njThrow(NJ_INTERNAL_ERR);
     }
+}
+
+NJ_INLINE void njConvert(void) {
+    njUpsamplePlanes();
+    njCheckError();
     if (nj.ncomp == 3) {
         // convert to RGB
         int x, yy;
-        unsigned char *prgb = nj.rgb;
+        unsigned char *prgb;
         const unsigned char *py  = nj.comp[0].pixels;
         const unsigned char *pcb = nj.comp[1].pixels;
         const unsigned char *pcr = nj.comp[2].pixels;
+        // Modified: Output buffer is allocated here rather than in njDecodeSOF()
+        nj.rgb = (unsigned char*) njAllocMem(nj.width * nj.height * nj.ncomp);
+        if (!nj.rgb) njThrow(NJ_OUT_OF_MEM);
+        prgb = nj.rgb;
         for (yy = nj.height;  yy;  --yy) {
             for (x = 0;  x < nj.width;  ++x) {
                 register int y = py[x] << 8;
@@ -893,7 +982,7 @@ int njInit(void) {
     } // for
     if (retval == 0) {
         for (i = 0; i < 4; i++) {
-            njFreeMem(nj.vlctab[i]);
+            if (nj.vlctab[i]) njFreeMem(nj.vlctab[i]);
             nj.vlctab[i] = NULL;
         } // for
     } // if
@@ -902,19 +991,23 @@ int njInit(void) {
 
 // Modified njDone(); uses dynamic assignment of nj.vlctab[i] variable, to
 // avoid a 3x increase in binary size caused by the original static (stack)
-// definition.
+// definition. No longer calls njInit(), which left the tables allocated;
+// njDecodeScaled() sets them up again for the next image.
 void njDone(void) {
     int i;
     for (i = 0;  i < 3;  ++i)
         if (nj.comp[i].pixels) njFreeMem((void*) nj.comp[i].pixels);
     if (nj.rgb) njFreeMem((void*) nj.rgb);
     for (i = 0; i < 4; i++)
-        njFreeMem(nj.vlctab[i]);
-    njInit();
+        if (nj.vlctab[i]) njFreeMem(nj.vlctab[i]);
+    njFillMem(&nj, 0, sizeof (nj_context_t));
 }
 
-nj_result_t njDecode(const void* jpeg, const int size) {
+// Modified: Body of the original njDecode(), less the final conversion.
+nj_result_t njDecodeScaled(const void* jpeg, const int size, int minsize) {
     njDone();
+    if (!njInit()) return NJ_OUT_OF_MEM;
+    nj.minsize = minsize;
     nj.pos = (const unsigned char*) jpeg;
     nj.size = size & 0x7FFFFFFF;
     if (nj.size < 2) return NJ_NO_JPEG;
@@ -939,10 +1032,54 @@ nj_result_t njDecode(const void* jpeg, const int size) {
     }
     if (nj.error != __NJ_FINISHED) return nj.error;
     nj.error = NJ_OK;
+    return nj.error;
+}
+
+nj_result_t njDecode(const void* jpeg, const int size) {
+    nj_result_t result = njDecodeScaled(jpeg, size, 0);
+    if (result != NJ_OK) return result;
     njConvert();
     return nj.error;
 }
 
+// Modified: YCbCr to BGRA conversion straight into the caller's buffer.
+nj_result_t njGetImageBGRA(unsigned char* out, unsigned char alpha) {
+    int x, yy;
+    const unsigned char *py, *pcb, *pcr;
+    njUpsamplePlanes();
+    if (nj.error) return nj.error;
+    py = nj.comp[0].pixels;
+    if (nj.ncomp == 3) {
+        pcb = nj.comp[1].pixels;
+        pcr = nj.comp[2].pixels;
+        for (yy = nj.height;  yy;  --yy) {
+            for (x = 0;  x < nj.width;  ++x) {
+                register int y = py[x] << 8;
+                register int cb = pcb[x] - 128;
+                register int cr = pcr[x] - 128;
+                *out++ = njClip((y + 454 * cb            + 128) >> 8);
+                *out++ = njClip((y -  88 * cb - 183 * cr + 128) >> 8);
+                *out++ = njClip((y            + 359 * cr + 128) >> 8);
+                *out++ = alpha;
+            }
+            py += nj.comp[0].stride;
+            pcb += nj.comp[1].stride;
+            pcr += nj.comp[2].stride;
+        }
+    } else {
+        for (yy = nj.height;  yy;  --yy) {
+            for (x = 0;  x < nj.width;  ++x) {
+                *out++ = py[x];
+                *out++ = py[x];
+                *out++ = py[x];
+                *out++ = alpha;
+            }
+            py += nj.comp[0].stride;
+        }
+    }
+    return NJ_OK;
+}
+
 int njGetWidth(void)            { return nj.width; }
 int njGetHeight(void)           { return nj.height; }
 int njIsColor(void)             { return (nj.ncomp != 1); }
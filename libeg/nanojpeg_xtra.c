@@ -32,55 +32,37 @@
 
 #include "global.h"
 #include "../BootMaster/screenmgt.h"
+#include "../BootMaster/rp_funcs.h"
 // nanojpeg.c is weird; it doubles as both a header file and a .c file,
 // depending on whether _NJ_INCLUDE_HEADER_ONLY is defined.
 #define _NJ_INCLUDE_HEADER_ONLY
 #include "nanojpeg.c"
 
-typedef struct _jpeg_color {
-   UINT8 red;
-   UINT8 green;
-   UINT8 blue;
-} jpeg_color;
-
 // Decode JPEG data into something libeg can use. This function is a wrapper around
-// various NanoJPEG functions.
+// various NanoJPEG functions. A non-zero IconSize lets NanoJPEG decode at 1/2, 1/4
+// or 1/8 size while the longer side still covers IconSize, so that large images
+// never exist at full resolution. The caller scales the result to its final size.
 EG_IMAGE * egDecodeJPEG(IN UINT8 *FileData, IN UINTN FileDataLength, IN UINTN IconSize, IN BOOLEAN WantAlpha) {
     EG_IMAGE *NewImage = NULL;
-    unsigned Width, Height;
-    jpeg_color *JpegData;
-    UINTN i;
     nj_result_t Result;
 
-    if (njInit()) {
-        Result = njDecode((VOID *) FileData, FileDataLength);
-        if (Result != NJ_OK)
-            return NULL;
-
-        Width = njGetWidth();
-        Height = njGetHeight();
-
-        // allocate image structure and buffer
-        NewImage = egCreateImage(Width, Height, WantAlpha);
-        if ((NewImage == NULL) || (NewImage->Width != Width) || (NewImage->Height != Height))
-            return NULL;
-
-        JpegData = (jpeg_color *) njGetImage();
+    // Skip anything without a JPEG SOI marker before NanoJPEG sets up its tables
+    if ((FileDataLength < 2) || (FileData[0] != 0xFF) || (FileData[1] != 0xD8))
+        return NULL;
 
-        // Annoyingly, EFI and NanoJPEG use different ordering of RGB values in
-        // their pixel data representations, so we must adjust them.
-        for (i = 0; i < (NewImage->Height * NewImage->Width); i++) {
-            NewImage->PixelData[i].r = JpegData[i].red;
-            NewImage->PixelData[i].g = JpegData[i].green;
-            NewImage->PixelData[i].b = JpegData[i].blue;
+    Result = njDecodeScaled((VOID *) FileData, (int) FileDataLength, (int) IconSize);
+    if (Result == NJ_OK) {
+        NewImage = egCreateImage(njGetWidth(), njGetHeight(), WantAlpha);
+        if (NewImage != NULL) {
+            // NanoJPEG converts straight into the EFI pixel layout.
             // NB: NanoJPEG does not appear to support alpha/transparency,
             //     so if requested, set it to be fully opaque.
-            if (WantAlpha)
-                NewImage->PixelData[i].a = 255;
+            Result = njGetImageBGRA((unsigned char *) NewImage->PixelData, (WantAlpha) ? 255 : 0);
+            if (Result != NJ_OK)
+                MY_FREE_IMAGE(NewImage);
         }
-        FreePool(JpegData);
-        njDone();
     }
+    njDone();
 
     return NewImage;
 } // EG_IMAGE * egDecodeJPEG()
@@ -336,33 +336,6 @@ EFI_STATUS RP_ProvideGopPassThrough (
 #endif
 
 
-static
-EFI_STATUS EncodeAsPNG (
-    IN  VOID     *RawData,
-    IN  UINT32    Width,
-    IN  UINT32    Height,
-    OUT VOID    **Buffer,
-    OUT UINTN    *BufferSize
-) {
-    EFI_STATUS Status = EFI_SUCCESS;
-    UINTN      ErrorCode;
-
-    // Should return 0 on success
-    ErrorCode = lodepng_encode32 (
-        (unsigned char **) Buffer,
-        BufferSize,
-        RawData,
-        Width,
-        Height
-    );
-
-    if (ErrorCode != 0) {
-        Status = EFI_INVALID_PARAMETER;
-    }
-
-    return Status;
-} // static EFI_STATUS EncodeAsPNG()
-
 static
 EFI_STATUS RefitCheckGOP (
     BOOLEAN FixGOP
@@ -2323,6 +2296,205 @@ VOID egSetGraphicsModeEnabled (
 // Drawing to the screen
 //
 
+//
+// Shadow framebuffer
+//
+// egDrawImage() and egDrawImageArea() compose into an off-screen copy of the
+// display and record the rectangles they touch. Outside a frame, each rectangle
+// is sent to the screen straight away. Between egBeginFrame() and egEndFrame(),
+// rectangles are collected and merged, then sent with one Blt per merged
+// rectangle when the frame ends. Only recorded rectangles are ever sent, as the
+// rest of the shadow copy may be stale: console output and the firmware also
+// draw to the screen.
+//
+
+#define EG_MAX_DIRTY_RECTS (16)
+
+typedef struct {
+    UINTN XPos;
+    UINTN YPos;
+    UINTN Width;
+    UINTN Height;
+} EG_DIRTY_RECT;
+
+static EG_IMAGE      *ShadowImage = NULL;
+static EG_DIRTY_RECT  DirtyRects[EG_MAX_DIRTY_RECTS];
+static UINTN          DirtyCount  = 0;
+static UINTN          FrameDepth  = 0;
+
+// Make sure the shadow framebuffer matches the current screen size.
+// Returns FALSE if it cannot be allocated, in which case callers draw directly.
+static
+BOOLEAN egPrepareShadow (VOID) {
+    if (ShadowImage != NULL &&
+        ShadowImage->Width  == egScreenWidth &&
+        ShadowImage->Height == egScreenHeight
+    ) {
+        return TRUE;
+    }
+
+    // Screen size changed ... Pending rectangles refer to the old mode
+    DirtyCount = 0;
+    MY_FREE_IMAGE(ShadowImage);
+
+    ShadowImage = egCreateImage (egScreenWidth, egScreenHeight, FALSE);
+
+    return (ShadowImage != NULL);
+} // static BOOLEAN egPrepareShadow()
+
+static
+VOID egBltShadowArea (
+    IN EG_DIRTY_RECT *Rect
+) {
+    if (GOPDraw != NULL) {
+        REFIT_CALL_10_WRAPPER(
+            GOPDraw->Blt, GOPDraw,
+            (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) ShadowImage->PixelData, EfiBltBufferToVideo,
+            Rect->XPos, Rect->YPos,
+            Rect->XPos, Rect->YPos,
+            Rect->Width, Rect->Height, ShadowImage->Width * 4
+        );
+    }
+    else if (UGADraw != NULL) {
+        REFIT_CALL_10_WRAPPER(
+            UGADraw->Blt, UGADraw,
+            (EFI_UGA_PIXEL *) ShadowImage->PixelData, EfiUgaBltBufferToVideo,
+            Rect->XPos, Rect->YPos,
+            Rect->XPos, Rect->YPos,
+            Rect->Width, Rect->Height, ShadowImage->Width * 4
+        );
+    }
+} // static VOID egBltShadowArea()
+
+// Send all pending rectangles to the screen.
+static
+VOID egFlushShadow (VOID) {
+    UINTN i;
+
+    if (ShadowImage != NULL) {
+        for (i = 0; i < DirtyCount; i++) {
+            egBltShadowArea (&DirtyRects[i]);
+        }
+    }
+
+    DirtyCount = 0;
+} // static VOID egFlushShadow()
+
+// Merge rectangle B into rectangle A if their union is itself a rectangle,
+// so that the merged Blt never sends pixels nobody drew.
+// Returns TRUE if merged.
+static
+BOOLEAN egMergeDirtyRect (
+    IN OUT EG_DIRTY_RECT *A,
+    IN     EG_DIRTY_RECT *B
+) {
+    UINTN AEndX = A->XPos + A->Width;
+    UINTN AEndY = A->YPos + A->Height;
+    UINTN BEndX = B->XPos + B->Width;
+    UINTN BEndY = B->YPos + B->Height;
+
+    if (B->XPos >= A->XPos && BEndX <= AEndX &&
+        B->YPos >= A->YPos && BEndY <= AEndY
+    ) {
+        // B lies inside A
+        return TRUE;
+    }
+
+    if (A->XPos >= B->XPos && AEndX <= BEndX &&
+        A->YPos >= B->YPos && AEndY <= BEndY
+    ) {
+        // A lies inside B
+        *A = *B;
+
+        return TRUE;
+    }
+
+    if (A->YPos == B->YPos && A->Height == B->Height &&
+        B->XPos <= AEndX && A->XPos <= BEndX
+    ) {
+        // Same rows, overlapping or touching columns
+        A->XPos  = (A->XPos < B->XPos) ? A->XPos : B->XPos;
+        A->Width = ((AEndX > BEndX) ? AEndX : BEndX) - A->XPos;
+
+        return TRUE;
+    }
+
+    if (A->XPos == B->XPos && A->Width == B->Width &&
+        B->YPos <= AEndY && A->YPos <= BEndY
+    ) {
+        // Same columns, overlapping or touching rows
+        A->YPos   = (A->YPos < B->YPos) ? A->YPos : B->YPos;
+        A->Height = ((AEndY > BEndY) ? AEndY : BEndY) - A->YPos;
+
+        return TRUE;
+    }
+
+    return FALSE;
+} // static BOOLEAN egMergeDirtyRect()
+
+// Record a rectangle of the shadow framebuffer as changed.
+static
+VOID egMarkDirty (
+    IN UINTN XPos,
+    IN UINTN YPos,
+    IN UINTN Width,
+    IN UINTN Height
+) {
+    UINTN         i;
+    BOOLEAN       Merged;
+    EG_DIRTY_RECT Rect;
+
+    Rect.XPos   = XPos;
+    Rect.YPos   = YPos;
+    Rect.Width  = Width;
+    Rect.Height = Height;
+
+    if (FrameDepth == 0) {
+        // Not collecting a frame ... Update the screen now
+        egBltShadowArea (&Rect);
+
+        return;
+    }
+
+    // Fold the new rectangle into the list, repeating while merges
+    // produce rectangles that can absorb further entries
+    do {
+        Merged = FALSE;
+        for (i = 0; i < DirtyCount; i++) {
+            if (egMergeDirtyRect (&Rect, &DirtyRects[i])) {
+                DirtyRects[i] = DirtyRects[--DirtyCount];
+                Merged = TRUE;
+                break;
+            }
+        }
+    } while (Merged);
+
+    if (DirtyCount == EG_MAX_DIRTY_RECTS) {
+        // List is full ... Send what we have
+        egFlushShadow();
+    }
+
+    DirtyRects[DirtyCount++] = Rect;
+} // static VOID egMarkDirty()
+
+// Start collecting screen updates. Drawing calls made until the matching
+// egEndFrame() call reach the screen together when the frame ends.
+// Frames may be nested; only the outermost egEndFrame() updates the screen.
+VOID egBeginFrame (VOID) {
+    FrameDepth++;
+} // VOID egBeginFrame()
+
+VOID egEndFrame (VOID) {
+    if (FrameDepth == 0) {
+        return;
+    }
+
+    FrameDepth--;
+    if (FrameDepth == 0) {
+        egFlushShadow();
+    }
+} // VOID egEndFrame()
+
 VOID egClearScreen (
     IN EG_PIXEL *Color
 ) {
@@ -2364,6 +2536,9 @@ VOID egClearScreen (
     }
     FillColor.Reserved = 0;
 
+    // Pending shadow framebuffer updates would be painted over anyway
+    DirtyCount = 0;
+
     BREAD_CRUMB(L"%s:  3", FuncTag);
     if (GOPDraw != NULL) {
         BREAD_CRUMB(L"%s:  3a 1 - (Apply Fill via GOP)", FuncTag);
@@ -2394,7 +2569,8 @@ VOID egClearScreen (
     LOG_SEP(L"X");
 } // VOID egClearScreen()
 
-VOID egDrawImage (
+static
+VOID egDrawImageDirect (
     IN EG_IMAGE *Image,
     IN UINTN     ScreenPosX,
     IN UINTN     ScreenPosY
@@ -2402,19 +2578,6 @@ VOID egDrawImage (
     EG_IMAGE *CompImage = NULL;
     BOOLEAN   SetImage  = FALSE;
 
-    // DA-TAg: Investigate This
-    //         Weird seemingly redundant tests because some placement code can "wrap around" and
-    //         send "negative" values, which of course become very large unsigned ints that can then
-    //         wrap around AGAIN if values are added to them.
-    if (!egHasGraphics                                ||
-        ScreenPosX > egScreenWidth                    ||
-        ScreenPosY > egScreenHeight                   ||
-        (ScreenPosX + Image->Width)  > egScreenWidth  ||
-        (ScreenPosY + Image->Height) > egScreenHeight
-    ) {
-        return;
-    }
-
     if (GlobalConfig.ScreenBackground == NULL ||
         (
             (Image->Width == egScreenWidth) && (Image->Height == egScreenHeight)
@@ -2467,6 +2630,85 @@ VOID egDrawImage (
     if (SetImage) {
         MY_FREE_IMAGE(CompImage);
     }
+} // static VOID egDrawImageDirect()
+
+VOID egDrawImage (
+    IN EG_IMAGE *Image,
+    IN UINTN     ScreenPosX,
+    IN UINTN     ScreenPosY
+) {
+    EG_IMAGE *Background;
+    EG_PIXEL *ShadowPtr;
+
+    // DA-TAg: Investigate This
+    //         Weird seemingly redundant tests because some placement code can "wrap around" and
+    //         send "negative" values, which of course become very large unsigned ints that can then
+    //         wrap around AGAIN if values are added to them.
+    if (!egHasGraphics                                ||
+        ScreenPosX > egScreenWidth                    ||
+        ScreenPosY > egScreenHeight                   ||
+        (ScreenPosX + Image->Width)  > egScreenWidth  ||
+        (ScreenPosY + Image->Height) > egScreenHeight
+    ) {
+        return;
+    }
+
+    if (!egPrepareShadow()) {
+        // No shadow framebuffer ... Compose and Blt this image on its own
+        egDrawImageDirect (Image, ScreenPosX, ScreenPosY);
+
+        return;
+    }
+
+    // Same composition as egDrawImageDirect, but straight into the shadow framebuffer
+    Background = GlobalConfig.ScreenBackground;
+    ShadowPtr  = ShadowImage->PixelData + ScreenPosY * ShadowImage->Width + ScreenPosX;
+    if (Background == NULL || Background == Image ||
+        (
+            (Image->Width == egScreenWidth) && (Image->Height == egScreenHeight)
+        )
+    ) {
+        egRawCopy (
+            ShadowPtr, Image->PixelData,
+            Image->Width, Image->Height,
+            ShadowImage->Width, Image->Width
+        );
+    }
+    else {
+        if ((ScreenPosX + Image->Width)  > Background->Width ||
+            (ScreenPosY + Image->Height) > Background->Height
+        ) {
+            #if REFIT_DEBUG > 0
+            LOG_MSG("Error! Cannot Crop Image in egDrawImage()!\n");
+            #endif
+
+            return;
+        }
+
+        egRawCopy (
+            ShadowPtr,
+            Background->PixelData + ScreenPosY * Background->Width + ScreenPosX,
+            Image->Width, Image->Height,
+            ShadowImage->Width, Background->Width
+        );
+
+        if (Image->HasAlpha) {
+            egRawCompose (
+                ShadowPtr, Image->PixelData,
+                Image->Width, Image->Height,
+                ShadowImage->Width, Image->Width
+            );
+        }
+        else {
+            egRawCopy (
+                ShadowPtr, Image->PixelData,
+                Image->Width, Image->Height,
+                ShadowImage->Width, Image->Width
+            );
+        }
+    }
+
+    egMarkDirty (ScreenPosX, ScreenPosY, Image->Width, Image->Height);
 } // VOID egDrawImage()
 
 // Display an unselected icon on the screen, so that the background image shows
@@ -2521,6 +2763,24 @@ VOID egDrawImageArea (
         return;
     }
 
+    if (ScreenPosX < egScreenWidth && ScreenPosY < egScreenHeight &&
+        AreaWidth  <= egScreenWidth  - ScreenPosX &&
+        AreaHeight <= egScreenHeight - ScreenPosY &&
+        egPrepareShadow()
+    ) {
+        egRawCopy (
+            ShadowImage->PixelData + ScreenPosY * ShadowImage->Width + ScreenPosX,
+            Image->PixelData + AreaPosY * Image->Width + AreaPosX,
+            AreaWidth, AreaHeight,
+            ShadowImage->Width, Image->Width
+        );
+        egMarkDirty (ScreenPosX, ScreenPosY, AreaWidth, AreaHeight);
+
+        return;
+    }
+
+    // Off-screen or no shadow framebuffer ... Hand straight to the firmware
+    egFlushShadow();
     if (GOPDraw != NULL) {
         REFIT_CALL_10_WRAPPER(
             GOPDraw->Blt, GOPDraw,
@@ -2649,6 +2909,9 @@ EG_IMAGE * egCopyScreenArea (
        return NULL;
    }
 
+   // Read back what is actually on screen, including pending updates
+   egFlushShadow();
+
    // allocate a buffer for the screen area
    Image = egCreateImage (Width, Height, FALSE);
    if (Image == NULL) {
@@ -2685,10 +2948,8 @@ VOID egScreenShot (VOID) {
     EFI_FILE     *BaseDir;
     EG_IMAGE     *Image;
     UINT8        *FileData;
-    UINT8         Temp;
     UINTN         i;
     UINTN         FileDataSize;         ///< Size in bytes
-    UINTN         FilePixelSize;        ///< Size in pixels
     CHAR16       *FileName    = NULL;
     CHAR16       *MsgStr      = NULL;
     EG_PIXEL      BGColorWarn = COLOR_RED;
@@ -2732,23 +2993,8 @@ VOID egScreenShot (VOID) {
         goto bailout_wait;
     }
 
-    // Fix pixels
-    FilePixelSize = Image->Width * Image->Height;
-    for (i = 0; i < FilePixelSize; ++i) {
-        Temp                   = Image->PixelData[i].b;
-        Image->PixelData[i].b  = Image->PixelData[i].r;
-        Image->PixelData[i].r  = Temp;
-        Image->PixelData[i].a  = 0xFF;
-    }
-
-    // Encode as PNG
-    Status = EncodeAsPNG (
-        (VOID *)   Image->PixelData,
-        (UINT32)   Image->Width,
-        (UINT32)   Image->Height,
-        (VOID **) &FileData,
-        &FileDataSize
-    );
+    // Encode as PNG ... Swaps to RGB while encoding
+    Status = egEncodePNG (Image, &FileData, &FileDataSize);
 
     MY_FREE_IMAGE(Image);
     if (EFI_ERROR(Status)) {
@@ -0,0 +1,54 @@
+/**
+ * \file eg_posix.c
+ * Image helpers from libeg/image.c for the POSIX user space environment.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eg_posix_base.h"
+
+
+EG_IMAGE * egCreateImage (
+    IN UINTN    Width,
+    IN UINTN    Height,
+    IN BOOLEAN  HasAlpha
+) {
+    EG_IMAGE *NewImage;
+
+    NewImage = malloc (sizeof (EG_IMAGE));
+    if (NewImage == NULL) {
+        return NULL;
+    }
+
+    NewImage->PixelData = malloc (Width * Height * sizeof (EG_PIXEL));
+    if (NewImage->PixelData == NULL) {
+        free (NewImage);
+        return NULL;
+    }
+
+    NewImage->Width    = Width;
+    NewImage->Height   = Height;
+    NewImage->HasAlpha = HasAlpha;
+
+    return NewImage;
+}
+
+EG_IMAGE * egCopyImage (
+    IN EG_IMAGE *Image
+) {
+    EG_IMAGE *NewImage;
+
+    NewImage = egCreateImage (Image->Width, Image->Height, Image->HasAlpha);
+    if (NewImage != NULL) {
+        memcpy (NewImage->PixelData, Image->PixelData, Image->Width * Image->Height * sizeof (EG_PIXEL));
+    }
+
+    return NewImage;
+}
+
+// EOF
@@ -0,0 +1,105 @@
+/**
+ * \file eg_posix_base.h
+ * Base definitions for building libeg's pixel loops in the POSIX user space
+ * environment.
+ *
+ * libeg/image_ops.c and libeg/lodepng_xtra.c include this file instead of
+ * the EFI headers when they are built with HOST_POSIX. It provides the EFI
+ * types, memory functions and image helpers that the scaling, compositing
+ * and PNG code uses. lodepng.c is built with this file forced in.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _EG_POSIX_BASE_H_
+#define _EG_POSIX_BASE_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define IN
+#define OUT
+#define TRUE                    (1)
+#define FALSE                   (0)
+#define REFIT_DEBUG             (0)
+
+typedef void                    VOID;
+typedef uint8_t                 UINT8;
+typedef uint16_t                UINT16;
+typedef uint32_t                UINT32;
+typedef uint64_t                UINT64;
+typedef uintptr_t               UINTN;
+typedef unsigned char           BOOLEAN;
+typedef UINTN                   EFI_STATUS;
+
+#define EFI_SUCCESS             (0)
+#define EFI_INVALID_PARAMETER   (2)
+#define EFI_BAD_BUFFER_SIZE     (4)
+#define EFI_OUT_OF_RESOURCES    (9)
+
+typedef struct {
+    UINT8 b, g, r, a;
+} EG_PIXEL;
+
+typedef struct {
+    UINTN     Width;
+    UINTN     Height;
+    BOOLEAN   HasAlpha;
+    EG_PIXEL *PixelData;
+} EG_IMAGE;
+
+#define AllocatePool(Size)                  malloc (Size)
+#define AllocateZeroPool(Size)              calloc (1, (Size))
+#define FreePool(Pointer)                   free (Pointer)
+#define CopyMem(Dest, Src, Size)            memmove ((Dest), (Src), (Size))
+#define SetMem(Dest, Size, Value)           memset ((Dest), (Value), (Size))
+#define ZeroMem(Dest, Size)                 memset ((Dest), 0, (Size))
+
+#define MY_FREE_POOL(Pointer)               \
+    do {                                    \
+        free (Pointer);                     \
+        Pointer = NULL;                     \
+    } while (0)
+
+#define MY_FREE_IMAGE(Image)                \
+    do {                                    \
+        if (Image != NULL) {                \
+            free (Image->PixelData);        \
+            free (Image);                   \
+            Image = NULL;                   \
+        }                                   \
+    } while (0)
+
+// Provided by eg_posix.c
+EG_IMAGE * egCreateImage (IN UINTN Width, IN UINTN Height, IN BOOLEAN HasAlpha);
+EG_IMAGE * egCopyImage (IN EG_IMAGE *Image);
+
+// Provided by libeg/image_ops.c
+EG_IMAGE * egScaleImage (EG_IMAGE *Image, UINTN NewWidth, UINTN NewHeight);
+VOID egRawCopy (
+    IN OUT EG_PIXEL *CompBasePtr,
+    IN     EG_PIXEL *TopBasePtr,
+    IN     UINTN    Width,
+    IN     UINTN    Height,
+    IN     UINTN    CompLineOffset,
+    IN     UINTN    TopLineOffset
+);
+VOID egRawCompose (
+    IN OUT EG_PIXEL *CompBasePtr,
+    IN     EG_PIXEL *TopBasePtr,
+    IN     UINTN    Width,
+    IN     UINTN    Height,
+    IN     UINTN    CompLineOffset,
+    IN     UINTN    TopLineOffset
+);
+
+#endif
+
+// EOF
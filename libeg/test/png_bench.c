@@ -0,0 +1,220 @@
+/**
+ * \file png_bench.c
+ * PNG decoding benchmark and check for the POSIX user space environment.
+ *
+ * Decodes each PNG named on the command line with egDecodePNG() from
+ * libeg/lodepng_xtra.c and with the decoder it replaced, which had LodePNG
+ * convert to RGBA and took every allocation from the pool. Both must give
+ * the same pixels, with and without alpha. The scratch arena is filled with
+ * a junk pattern before every checked decode, so anything that reads arena
+ * memory before writing it shows up as a mismatch. Then times both decoders
+ * and counts their pool allocations, and checks that no more than
+ * LODE_ARENA_KEEP_SIZE is held once the decodes are done.
+ * Exits with 1 if any check fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eg_posix_base.h"
+
+#include <stdio.h>
+#include <time.h>
+
+
+// Count the pool allocations made by LodePNG and the arena
+static size_t pool_allocs;
+
+static void *count_alloc(size_t size, int zero)
+{
+    pool_allocs++;
+    return (zero) ? calloc(1, size) : malloc(size);
+}
+
+#undef AllocatePool
+#undef AllocateZeroPool
+#define AllocatePool(Size)      count_alloc((Size), 0)
+#define AllocateZeroPool(Size)  count_alloc((Size), 1)
+
+// Included rather than linked, to reach the arena and count its allocations
+#include "../lodepng_xtra.c"
+
+#define DEFAULT_REPEATS 50
+
+typedef struct {
+    UINT8 red, green, blue, alpha;
+} lode_color;
+
+/**
+ * The decoder egDecodePNG() had before the arena, unchanged apart from the
+ * name and clearing alpha when it is not wanted, as the new decoder does.
+ */
+static EG_IMAGE *old_decode_png(UINT8 *FileData, UINTN FileDataLength, BOOLEAN WantAlpha)
+{
+    EG_IMAGE   *NewImage = NULL;
+    unsigned    Error, Width, Height;
+    EG_PIXEL   *PixelData;
+    lode_color *LodeData;
+    UINTN       i;
+
+    Error = lodepng_decode_memory((unsigned char **) &PixelData, &Width, &Height,
+                                  (unsigned char *) FileData, (size_t) FileDataLength,
+                                  LCT_RGBA, 8);
+    if (Error)
+        return NULL;
+
+    NewImage = egCreateImage(Width, Height, WantAlpha);
+    if (NewImage == NULL)
+        return NULL;
+
+    LodeData = (lode_color *) PixelData;
+    for (i = 0; i < (NewImage->Height * NewImage->Width); i++) {
+        NewImage->PixelData[i].r = LodeData[i].red;
+        NewImage->PixelData[i].g = LodeData[i].green;
+        NewImage->PixelData[i].b = LodeData[i].blue;
+        NewImage->PixelData[i].a = (WantAlpha) ? LodeData[i].alpha : 0;
+    }
+    lodepng_refit_free(PixelData);
+
+    return NewImage;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static UINT8 *read_file(const char *name, size_t *size)
+{
+    FILE   *f;
+    UINT8  *data;
+    long    len;
+
+    f = fopen(name, "rb");
+    if (f == NULL)
+        return NULL;
+
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+
+    data = (len > 0) ? malloc(len) : NULL;
+    if (data != NULL && fread(data, 1, len, f) != (size_t) len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+
+    *size = (size_t) len;
+    return data;
+}
+
+static int check_file(const char *name, UINT8 *data, size_t size)
+{
+    EG_IMAGE   *old_image, *new_image;
+    int         want_alpha, bad = 0;
+
+    for (want_alpha = 0; want_alpha < 2; want_alpha++) {
+        if (LodeArena.Base != NULL)
+            memset(LodeArena.Base, 0xA5, LodeArena.Size);
+
+        old_image = old_decode_png(data, size, want_alpha);
+        new_image = egDecodePNG(data, size, 0, want_alpha);
+
+        if (old_image == NULL || new_image == NULL) {
+            if (old_image != new_image) {
+                printf("  %s: only one decoder failed\n", name);
+                bad++;
+            }
+        }
+        else if (old_image->Width != new_image->Width || old_image->Height != new_image->Height ||
+                 memcmp(old_image->PixelData, new_image->PixelData,
+                        old_image->Width * old_image->Height * sizeof(EG_PIXEL)) != 0) {
+            printf("  %s: pixels differ%s\n", name, (want_alpha) ? " with alpha" : "");
+            bad++;
+        }
+
+        MY_FREE_IMAGE(old_image);
+        MY_FREE_IMAGE(new_image);
+    }
+
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    EG_IMAGE   *image;
+    UINT8      *data;
+    size_t      size, old_allocs = 0, new_allocs = 0;
+    double      t, old_time = 0, new_time = 0;
+    int         i, r, repeats = DEFAULT_REPEATS, files = 0, bad = 0;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        repeats = atoi(argv[2]);
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc < 2) {
+        printf("Usage: png_bench [-n repeats] file.png...\n");
+        return 1;
+    }
+
+    for (i = 1; i < argc; i++) {
+        data = read_file(argv[i], &size);
+        if (data == NULL) {
+            printf("  %s: cannot read\n", argv[i]);
+            bad++;
+            continue;
+        }
+
+        bad += check_file(argv[i], data, size);
+        files++;
+
+        for (r = 0; r < repeats; r++) {
+            pool_allocs = 0;
+            t = now();
+            image = old_decode_png(data, size, TRUE);
+            old_time += now() - t;
+            old_allocs += pool_allocs;
+            MY_FREE_IMAGE(image);
+
+            pool_allocs = 0;
+            t = now();
+            image = egDecodePNG(data, size, 0, TRUE);
+            new_time += now() - t;
+            new_allocs += pool_allocs;
+            MY_FREE_IMAGE(image);
+        }
+
+        free(data);
+    }
+
+    if (LodeArena.Size > LODE_ARENA_KEEP_SIZE) {
+        printf("  %zu byte arena held after decoding, more than %u\n",
+               (size_t) LodeArena.Size, (unsigned) LODE_ARENA_KEEP_SIZE);
+        bad++;
+    }
+
+    printf("%d files, %d failures\n", files, bad);
+    if (repeats > 0 && files > 0) {
+        printf("old decoder: %8.3f ms per pass, %6.1f pool allocations per file\n",
+               old_time * 1e3 / repeats, (double) old_allocs / repeats / files);
+        printf("egDecodePNG: %8.3f ms per pass, %6.1f pool allocations per file\n",
+               new_time * 1e3 / repeats, (double) new_allocs / repeats / files);
+        printf("arena held after decoding: %zu bytes\n", (size_t) LodeArena.Size);
+    }
+
+    MY_FREE_POOL(LodeArena.Base);
+
+    return bad != 0;
+}
+
+// EOF
@@ -0,0 +1,325 @@
+/**
+ * \file scale_bench.c
+ * Scaling benchmark and check for the POSIX user space environment.
+ *
+ * Times egScaleImage() from libeg/image_ops.c against the per-pixel bilinear
+ * scaler it replaced, on the sizes RefindPlus scales most, and reports the
+ * best time of each and the largest channel difference between the two.
+ * Enlargements and reductions to more than half size must stay within one
+ * step of the old scaler. Reductions to half size or less use a box filter
+ * instead, sampled at EG_SCALE_BOX_TAPS pixels per axis when the ratio is
+ * larger, so these are checked against the exact area average, and their
+ * difference to the old scaler is only reported. Also checks odd sizes and that flat images stay flat.
+ * Exits with 1 if any check fails.
+ */
+
+/*
+ * This program is licensed under the terms of the GNU GPL, version 3,
+ * or (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eg_posix_base.h"
+
+#include <stdio.h>
+#include <time.h>
+
+
+#define FP_MULTIPLIER (UINTN) 65536
+
+/**
+ * The scaler egScaleImage() had before the separable filter, unchanged apart
+ * from the name and the debug logging.
+ */
+static EG_IMAGE *old_scale_image(EG_IMAGE *Image, UINTN NewWidth, UINTN NewHeight)
+{
+    EG_IMAGE  *NewImage;
+    EG_PIXEL   a, b, c, d;
+    UINTN      i, j;
+    UINTN      x, y, Index;
+    UINTN      Offset = 0;
+    UINTN      x_diff, y_diff;
+    UINTN      x_ratio, y_ratio;
+
+    if (Image == NULL || Image->Height == 0 || Image->Width == 0 || NewHeight == 0 || NewWidth == 0)
+        return NULL;
+
+    if ((Image->Width == NewWidth) && (Image->Height == NewHeight))
+        return egCopyImage(Image);
+
+    NewImage = egCreateImage(NewWidth, NewHeight, Image->HasAlpha);
+    if (NewImage == NULL)
+        return NULL;
+
+    x_ratio = ((Image->Width - 1) * FP_MULTIPLIER) / NewWidth;
+    y_ratio = ((Image->Height - 1) * FP_MULTIPLIER) / NewHeight;
+
+    for (i = 0; i < NewHeight; i++) {
+        for (j = 0; j < NewWidth; j++) {
+            x = (j * (Image->Width - 1)) / NewWidth;
+            y = (i * (Image->Height - 1)) / NewHeight;
+            x_diff = (x_ratio * j) - x * FP_MULTIPLIER;
+            y_diff = (y_ratio * i) - y * FP_MULTIPLIER;
+            Index = ((y * Image->Width) + x);
+            a = Image->PixelData[Index];
+            b = Image->PixelData[Index + 1];
+            c = Image->PixelData[Index + Image->Width];
+            d = Image->PixelData[Index + Image->Width + 1];
+
+            NewImage->PixelData[Offset].b = ((a.b) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
+                (b.b) * (x_diff) * (FP_MULTIPLIER - y_diff) +
+                (c.b) * (y_diff) * (FP_MULTIPLIER - x_diff) +
+                (d.b) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
+            NewImage->PixelData[Offset].g = ((a.g) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
+                (b.g) * (x_diff) * (FP_MULTIPLIER - y_diff) +
+                (c.g) * (y_diff) * (FP_MULTIPLIER - x_diff) +
+                (d.g) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
+            NewImage->PixelData[Offset].r = ((a.r) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
+                (b.r) * (x_diff) * (FP_MULTIPLIER - y_diff) +
+                (c.r) * (y_diff) * (FP_MULTIPLIER - x_diff) +
+                (d.r) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
+            NewImage->PixelData[Offset++].a = ((a.a) * (FP_MULTIPLIER - x_diff) * (FP_MULTIPLIER - y_diff) +
+                (b.a) * (x_diff) * (FP_MULTIPLIER - y_diff) +
+                (c.a) * (y_diff) * (FP_MULTIPLIER - x_diff) +
+                (d.a) * (x_diff * y_diff)) / (FP_MULTIPLIER * FP_MULTIPLIER);
+        }
+    }
+
+    return NewImage;
+}
+
+/**
+ * Exact area average over the same source spans the box filter uses, with
+ * one rounding at the end.
+ */
+static EG_IMAGE *box_scale_image(EG_IMAGE *Image, UINTN NewWidth, UINTN NewHeight)
+{
+    EG_IMAGE   *NewImage;
+    UINTN       i, j, x, y, x0, x1, y0, y1, n, c;
+    UINTN       sum[4];
+    UINT8      *p;
+
+    NewImage = egCreateImage(NewWidth, NewHeight, Image->HasAlpha);
+    if (NewImage == NULL)
+        return NULL;
+
+    for (i = 0; i < NewHeight; i++) {
+        y0 = (i * Image->Height) / NewHeight;
+        y1 = ((i + 1) * Image->Height) / NewHeight;
+        for (j = 0; j < NewWidth; j++) {
+            x0 = (j * Image->Width) / NewWidth;
+            x1 = ((j + 1) * Image->Width) / NewWidth;
+            sum[0] = sum[1] = sum[2] = sum[3] = 0;
+            for (y = y0; y < y1; y++) {
+                for (x = x0; x < x1; x++) {
+                    p = (UINT8 *) &Image->PixelData[y * Image->Width + x];
+                    for (c = 0; c < 4; c++)
+                        sum[c] += p[c];
+                }
+            }
+            n = (y1 - y0) * (x1 - x0);
+            p = (UINT8 *) &NewImage->PixelData[i * NewWidth + j];
+            for (c = 0; c < 4; c++)
+                p[c] = (UINT8) ((sum[c] + n / 2) / n);
+        }
+    }
+
+    return NewImage;
+}
+
+static UINT32 rand_state = 1;
+
+static UINT32 next_rand(void)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * Makes a test image: smooth gradients in every channel (like banners and
+ * icon shading), or random noise.
+ */
+static EG_IMAGE *make_image(UINTN width, UINTN height, int smooth)
+{
+    EG_IMAGE   *image;
+    EG_PIXEL   *p;
+    UINTN       i, x, y;
+
+    image = egCreateImage(width, height, TRUE);
+    if (image == NULL)
+        return NULL;
+
+    for (i = 0; i < width * height; i++) {
+        p = &image->PixelData[i];
+        x = i % width;
+        y = i / width;
+        if (smooth) {
+            p->b = x * 255 / width;
+            p->g = y * 255 / height;
+            p->r = (x + y) * 255 / (width + height);
+            p->a = 255 - (x * 255 / width);
+        } else {
+            *(UINT32 *) p = next_rand();
+        }
+    }
+
+    return image;
+}
+
+/**
+ * Largest difference of any channel of two images of the same size.
+ */
+static int max_diff(EG_IMAGE *a, EG_IMAGE *b)
+{
+    UINTN       i;
+    int         d, max = 0;
+
+    for (i = 0; i < a->Width * a->Height * 4; i++) {
+        d = ((UINT8 *) a->PixelData)[i] - ((UINT8 *) b->PixelData)[i];
+        if (d < 0)
+            d = -d;
+        if (d > max)
+            max = d;
+    }
+
+    return max;
+}
+
+/**
+ * Scales one test image with both scalers, prints the timings and checks the
+ * result. Returns 1 if the check fails.
+ */
+static int bench_case(const char *name, UINTN width, UINTN height,
+                      UINTN new_width, UINTN new_height, int runs)
+{
+    EG_IMAGE   *src, *old_img = NULL, *new_img = NULL, *box_img;
+    double      t, old_best = 0, new_best = 0;
+    int         k, old_diff, box_diff = -1, box, failed;
+
+    src = make_image(width, height, 1);
+    if (src == NULL)
+        return 1;
+
+    // Best of the runs, taking turns, so that other load on the host
+    // skews neither scaler
+    for (k = 0; k < runs; k++) {
+        MY_FREE_IMAGE(old_img);
+        t = now_ms();
+        old_img = old_scale_image(src, new_width, new_height);
+        t = now_ms() - t;
+        if (k == 0 || t < old_best)
+            old_best = t;
+
+        MY_FREE_IMAGE(new_img);
+        t = now_ms();
+        new_img = egScaleImage(src, new_width, new_height);
+        t = now_ms() - t;
+        if (k == 0 || t < new_best)
+            new_best = t;
+    }
+    if (old_img == NULL || new_img == NULL) {
+        fprintf(stderr, "%s: out of memory\n", name);
+        return 1;
+    }
+
+    old_diff = max_diff(old_img, new_img);
+    box      = (new_width * 2 <= width && new_height * 2 <= height);
+    if (box) {
+        box_img = box_scale_image(src, new_width, new_height);
+        if (box_img == NULL)
+            return 1;
+        box_diff = max_diff(box_img, new_img);
+        MY_FREE_IMAGE(box_img);
+        failed = (box_diff > 1);
+    } else {
+        failed = (old_diff > 1);
+    }
+
+    printf("%-22s %4lux%-4lu -> %4lux%-4lu  old %8.3f ms  new %8.3f ms  maxdiff old %d",
+           name, (unsigned long) width, (unsigned long) height,
+           (unsigned long) new_width, (unsigned long) new_height,
+           old_best, new_best, old_diff);
+    if (box)
+        printf(" box %d", box_diff);
+    printf("%s\n", failed ? "  FAILED" : "");
+
+    MY_FREE_IMAGE(old_img);
+    MY_FREE_IMAGE(new_img);
+    MY_FREE_IMAGE(src);
+    return failed;
+}
+
+/**
+ * Scales noise between small and odd sizes, where the taps reach the image
+ * edges, and checks that flat images stay flat in every channel.
+ */
+static int test_edges(void)
+{
+    static const UINTN sizes[] = { 1, 2, 3, 5, 17, 64, 129 };
+    const UINTN n = sizeof(sizes) / sizeof(sizes[0]);
+    EG_IMAGE   *src, *dst;
+    EG_PIXEL    flat = { 200, 17, 255, 128 };
+    UINTN       a, b, c, d, i;
+    int         failed = 0;
+
+    for (a = 0; a < n; a++) {
+        for (b = 0; b < n; b++) {
+            src = make_image(sizes[a], sizes[b], 0);
+            for (c = 0; c < n; c++) {
+                for (d = 0; d < n; d++) {
+                    dst = egScaleImage(src, sizes[c], sizes[d]);
+                    if (dst == NULL || dst->Width != sizes[c] || dst->Height != sizes[d])
+                        failed = 1;
+                    MY_FREE_IMAGE(dst);
+                }
+            }
+            MY_FREE_IMAGE(src);
+        }
+    }
+
+    src = egCreateImage(333, 77, TRUE);
+    for (i = 0; i < 333 * 77; i++)
+        src->PixelData[i] = flat;
+    for (c = 0; c < 2; c++) {
+        dst = c ? egScaleImage(src, 20, 7) : egScaleImage(src, 50, 500);
+        for (i = 0; i < dst->Width * dst->Height; i++) {
+            if (memcmp(&dst->PixelData[i], &flat, sizeof(flat)) != 0)
+                failed = 1;
+        }
+        MY_FREE_IMAGE(dst);
+    }
+    MY_FREE_IMAGE(src);
+
+    printf("edge sizes and flat images: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int         failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    failed |= bench_case("banner up to 4K",     1920, 1080, 3840, 2160, 5);
+    failed |= bench_case("background to 1080p", 3840, 2160, 1920, 1080, 5);
+    failed |= bench_case("icon 256 to 144",      256,  256,  144,  144, 500);
+    failed |= bench_case("icon 512 to 48",       512,  512,   48,   48, 2000);
+    failed |= bench_case("selection 144 to 64",  144,  144,   64,   64, 2000);
+    failed |= bench_case("icon 48 to 128",        48,   48,  128,  128, 500);
+    failed |= test_edges();
+
+    return failed;
+}
+
+// EOF